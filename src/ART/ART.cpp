@@ -0,0 +1,680 @@
+#include "ART.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+template<typename Key, typename Value>
+ART<Key, Value>::Node::Node(const NodeType& _type) :
+	type(_type),
+	count(0),
+	prefixLength(0) {}
+
+template<typename Key, typename Value>
+ART<Key, Value>::Leaf::Leaf(const Key& _key, const Value& _value) :
+	Node(LeafType),
+	key(_key),
+	value(_value) {}
+
+template<typename Key, typename Value>
+ART<Key, Value>::Node4::Node4() :
+	Node(Node4Type) {}
+
+template<typename Key, typename Value>
+ART<Key, Value>::Node16::Node16() :
+	Node(Node16Type) {}
+
+template<typename Key, typename Value>
+ART<Key, Value>::Node48::Node48() :
+	Node(Node48Type)
+{
+	std::fill(this->childIndex, this->childIndex + 256, (unsigned char)0);
+	std::fill(this->children, this->children + 48, nullptr);
+}
+
+template<typename Key, typename Value>
+ART<Key, Value>::Node256::Node256() :
+	Node(Node256Type)
+{
+	std::fill(this->children, this->children + 256, nullptr);
+}
+
+template<typename Key, typename Value>
+ART<Key, Value>::ART() :
+	root(nullptr),
+	elementsCount(0) {}
+
+template<typename Key, typename Value>
+ART<Key, Value>::ART(const std::vector<std::pair<Key, Value>>& elements) :
+	root(nullptr),
+	elementsCount(0)
+{
+	for (const std::pair<Key, Value>& element : elements) {
+		this->insert(element.first, element.second);
+	}
+}
+
+template<typename Key, typename Value>
+ART<Key, Value>::~ART() {
+	this->deleteTree(this->root);
+}
+
+template<typename Key, typename Value>
+void ART<Key, Value>::deleteNode(Node* node) {
+	switch (node->type) {
+		case LeafType:
+			delete static_cast<Leaf*>(node);
+			break;
+		case Node4Type:
+			delete static_cast<Node4*>(node);
+			break;
+		case Node16Type:
+			delete static_cast<Node16*>(node);
+			break;
+		case Node48Type:
+			delete static_cast<Node48*>(node);
+			break;
+		case Node256Type:
+			delete static_cast<Node256*>(node);
+			break;
+	}
+}
+
+template<typename Key, typename Value>
+void ART<Key, Value>::deleteTree(Node* node) {
+	if (!node) {
+		return;
+	}
+
+	switch (node->type) {
+		case LeafType:
+			break;
+		case Node4Type: {
+			Node4* n = static_cast<Node4*>(node);
+			for (unsigned int i = 0; i < n->count; i++) {
+				this->deleteTree(n->children[i]);
+			}
+			break;
+		}
+		case Node16Type: {
+			Node16* n = static_cast<Node16*>(node);
+			for (unsigned int i = 0; i < n->count; i++) {
+				this->deleteTree(n->children[i]);
+			}
+			break;
+		}
+		case Node48Type: {
+			Node48* n = static_cast<Node48*>(node);
+			for (unsigned int i = 0; i < 48; i++) {
+				this->deleteTree(n->children[i]);
+			}
+			break;
+		}
+		case Node256Type: {
+			Node256* n = static_cast<Node256*>(node);
+			for (unsigned int i = 0; i < 256; i++) {
+				this->deleteTree(n->children[i]);
+			}
+			break;
+		}
+	}
+
+	deleteNode(node);
+}
+
+template<typename Key, typename Value>
+void ART<Key, Value>::copyHeader(Node* to, const Node* from) {
+	to->count = from->count;
+	to->prefixLength = from->prefixLength;
+	std::copy(from->prefix, from->prefix + maxPrefixLength, to->prefix);
+}
+
+template<typename Key, typename Value>
+typename ART<Key, Value>::Node** ART<Key, Value>::findChild(Node* node, const unsigned char& byte) {
+	switch (node->type) {
+		case Node4Type: {
+			Node4* n = static_cast<Node4*>(node);
+			for (unsigned int i = 0; i < n->count; i++) {
+				if (n->keys[i] == byte) {
+					return &n->children[i];
+				}
+			}
+			return nullptr;
+		}
+		case Node16Type: {
+			Node16* n = static_cast<Node16*>(node);
+#if defined(__SSE2__)
+			//compare all 16 key bytes at once, the bits of the missing children are masked out
+			__m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte), _mm_loadu_si128((const __m128i*)n->keys));
+			unsigned int mask = (unsigned int)_mm_movemask_epi8(matches) & ((1u << n->count) - 1);
+			return mask ? &n->children[__builtin_ctz(mask)] : nullptr;
+#else
+			for (unsigned int i = 0; i < n->count; i++) {
+				if (n->keys[i] == byte) {
+					return &n->children[i];
+				}
+			}
+			return nullptr;
+#endif
+		}
+		case Node48Type: {
+			Node48* n = static_cast<Node48*>(node);
+			return n->childIndex[byte] ? &n->children[n->childIndex[byte] - 1] : nullptr;
+		}
+		case Node256Type: {
+			Node256* n = static_cast<Node256*>(node);
+			return n->children[byte] ? &n->children[byte] : nullptr;
+		}
+		default:
+			return nullptr;
+	}
+}
+
+template<typename Key, typename Value>
+void ART<Key, Value>::addChild(Node*& reference, const unsigned char& byte, Node* child) {
+	Node* node = reference;
+	switch (node->type) {
+		case Node4Type: {
+			Node4* n = static_cast<Node4*>(node);
+			if (n->count < 4) {
+				unsigned int position = (unsigned int)(std::upper_bound(n->keys, n->keys + n->count, byte) - n->keys);
+				std::move_backward(n->keys + position, n->keys + n->count, n->keys + n->count + 1);
+				std::move_backward(n->children + position, n->children + n->count, n->children + n->count + 1);
+				n->keys[position] = byte;
+				n->children[position] = child;
+				n->count++;
+				return;
+			}
+
+			//grow to Node16
+			Node16* larger = new Node16{};
+			copyHeader(larger, n);
+			std::copy(n->keys, n->keys + 4, larger->keys);
+			std::copy(n->children, n->children + 4, larger->children);
+			reference = larger;
+			delete n;
+			addChild(reference, byte, child);
+			return;
+		}
+		case Node16Type: {
+			Node16* n = static_cast<Node16*>(node);
+			if (n->count < 16) {
+				unsigned int position = (unsigned int)(std::upper_bound(n->keys, n->keys + n->count, byte) - n->keys);
+				std::move_backward(n->keys + position, n->keys + n->count, n->keys + n->count + 1);
+				std::move_backward(n->children + position, n->children + n->count, n->children + n->count + 1);
+				n->keys[position] = byte;
+				n->children[position] = child;
+				n->count++;
+				return;
+			}
+
+			//grow to Node48
+			Node48* larger = new Node48{};
+			copyHeader(larger, n);
+			for (unsigned int i = 0; i < 16; i++) {
+				larger->children[i] = n->children[i];
+				larger->childIndex[n->keys[i]] = (unsigned char)(i + 1);
+			}
+			reference = larger;
+			delete n;
+			addChild(reference, byte, child);
+			return;
+		}
+		case Node48Type: {
+			Node48* n = static_cast<Node48*>(node);
+			if (n->count < 48) {
+				//removed children leave holes, so take the first free slot
+				unsigned int position = 0;
+				while (n->children[position]) {
+					position++;
+				}
+				n->children[position] = child;
+				n->childIndex[byte] = (unsigned char)(position + 1);
+				n->count++;
+				return;
+			}
+
+			//grow to Node256
+			Node256* larger = new Node256{};
+			copyHeader(larger, n);
+			for (unsigned int i = 0; i < 256; i++) {
+				if (n->childIndex[i]) {
+					larger->children[i] = n->children[n->childIndex[i] - 1];
+				}
+			}
+			reference = larger;
+			delete n;
+			addChild(reference, byte, child);
+			return;
+		}
+		case Node256Type: {
+			Node256* n = static_cast<Node256*>(node);
+			n->children[byte] = child;
+			n->count++;
+			return;
+		}
+		default:
+			return;
+	}
+}
+
+template<typename Key, typename Value>
+void ART<Key, Value>::removeChild(Node*& reference, const unsigned char& byte) {
+	Node* node = reference;
+	switch (node->type) {
+		case Node4Type: {
+			Node4* n = static_cast<Node4*>(node);
+			unsigned int position = (unsigned int)(std::find(n->keys, n->keys + n->count, byte) - n->keys);
+			std::move(n->keys + position + 1, n->keys + n->count, n->keys + position);
+			std::move(n->children + position + 1, n->children + n->count, n->children + position);
+			n->count--;
+
+			if (n->count > 1) {
+				return;
+			}
+
+			//a single child is left - replace the node with it, the prefix of the child becomes
+			//the prefix of the node, the byte leading to the child and the previous prefix of the child
+			Node* child = n->children[0];
+			if (child->type != LeafType) {
+				unsigned int length = n->prefixLength;
+				if (length < maxPrefixLength) {
+					n->prefix[length] = n->keys[0];
+					length++;
+				}
+				if (length < maxPrefixLength) {
+					unsigned int childLength = std::min(child->prefixLength, maxPrefixLength - length);
+					std::memcpy(n->prefix + length, child->prefix, childLength);
+					length += childLength;
+				}
+
+				std::memcpy(child->prefix, n->prefix, std::min(length, maxPrefixLength));
+				child->prefixLength += n->prefixLength + 1;
+			}
+
+			reference = child;
+			delete n;
+			return;
+		}
+		case Node16Type: {
+			Node16* n = static_cast<Node16*>(node);
+			unsigned int position = (unsigned int)(std::find(n->keys, n->keys + n->count, byte) - n->keys);
+			std::move(n->keys + position + 1, n->keys + n->count, n->keys + position);
+			std::move(n->children + position + 1, n->children + n->count, n->children + position);
+			n->count--;
+
+			if (n->count > 3) {
+				return;
+			}
+
+			//shrink to Node4
+			Node4* smaller = new Node4{};
+			copyHeader(smaller, n);
+			std::copy(n->keys, n->keys + n->count, smaller->keys);
+			std::copy(n->children, n->children + n->count, smaller->children);
+			reference = smaller;
+			delete n;
+			return;
+		}
+		case Node48Type: {
+			Node48* n = static_cast<Node48*>(node);
+			n->children[n->childIndex[byte] - 1] = nullptr;
+			n->childIndex[byte] = 0;
+			n->count--;
+
+			if (n->count > 12) {
+				return;
+			}
+
+			//shrink to Node16, the bytes are visited in order so the keys stay sorted
+			Node16* smaller = new Node16{};
+			copyHeader(smaller, n);
+			unsigned int position = 0;
+			for (unsigned int i = 0; i < 256; i++) {
+				if (n->childIndex[i]) {
+					smaller->keys[position] = (unsigned char)i;
+					smaller->children[position] = n->children[n->childIndex[i] - 1];
+					position++;
+				}
+			}
+			reference = smaller;
+			delete n;
+			return;
+		}
+		case Node256Type: {
+			Node256* n = static_cast<Node256*>(node);
+			n->children[byte] = nullptr;
+			n->count--;
+
+			if (n->count > 37) {
+				return;
+			}
+
+			//shrink to Node48
+			Node48* smaller = new Node48{};
+			copyHeader(smaller, n);
+			unsigned int position = 0;
+			for (unsigned int i = 0; i < 256; i++) {
+				if (n->children[i]) {
+					smaller->children[position] = n->children[i];
+					smaller->childIndex[i] = (unsigned char)(position + 1);
+					position++;
+				}
+			}
+			reference = smaller;
+			delete n;
+			return;
+		}
+		default:
+			return;
+	}
+}
+
+template<typename Key, typename Value>
+unsigned int ART<Key, Value>::checkPrefix(const Node* node, const Key& key, const unsigned int& depth) {
+	unsigned int length = std::min(std::min(node->prefixLength, maxPrefixLength), Traits::length(key) - std::min(depth, Traits::length(key)));
+	unsigned int i = 0;
+	while (i < length && node->prefix[i] == Traits::byteAt(key, depth + i)) {
+		i++;
+	}
+
+	return i;
+}
+
+template<typename Key, typename Value>
+unsigned int ART<Key, Value>::prefixMismatch(const Node* node, const Key& key, const unsigned int& depth) {
+	unsigned int i = checkPrefix(node, key, depth);
+	if (i < std::min(node->prefixLength, maxPrefixLength) || node->prefixLength <= maxPrefixLength) {
+		return i;
+	}
+
+	//the bytes after the stored ones are the same for all keys below the node, take them from any leaf
+	const Leaf* leaf = minimumLeaf(node);
+	unsigned int length = std::min(node->prefixLength, std::min(Traits::length(key), Traits::length(leaf->key)) - depth);
+	while (i < length && Traits::byteAt(leaf->key, depth + i) == Traits::byteAt(key, depth + i)) {
+		i++;
+	}
+
+	return i;
+}
+
+template<typename Key, typename Value>
+const typename ART<Key, Value>::Leaf* ART<Key, Value>::minimumLeaf(const Node* node) {
+	while (node->type != LeafType) {
+		switch (node->type) {
+			case Node4Type:
+				node = static_cast<const Node4*>(node)->children[0];
+				break;
+			case Node16Type:
+				node = static_cast<const Node16*>(node)->children[0];
+				break;
+			case Node48Type: {
+				const Node48* n = static_cast<const Node48*>(node);
+				unsigned int i = 0;
+				while (!n->childIndex[i]) {
+					i++;
+				}
+				node = n->children[n->childIndex[i] - 1];
+				break;
+			}
+			case Node256Type: {
+				const Node256* n = static_cast<const Node256*>(node);
+				unsigned int i = 0;
+				while (!n->children[i]) {
+					i++;
+				}
+				node = n->children[i];
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	return static_cast<const Leaf*>(node);
+}
+
+template<typename Key, typename Value>
+bool ART<Key, Value>::leafMatches(const Leaf* leaf, const Key& key) {
+	return !(leaf->key < key) && !(key < leaf->key);
+}
+
+template<typename Key, typename Value>
+bool ART<Key, Value>::insertFromNode(Node*& reference, const Key& key, const Value& value, unsigned int depth) {
+	Node* node = reference;
+	if (!node) {
+		reference = new Leaf{ key, value };
+		return true;
+	}
+
+	if (node->type == LeafType) {
+		Leaf* leaf = static_cast<Leaf*>(node);
+		if (leafMatches(leaf, key)) {
+			leaf->value = value;
+			return false;
+		}
+
+		//replace the leaf with a node branching on the first byte in which the keys differ,
+		//which comes before the end of the longer key as no valid key is a prefix of another one
+		unsigned int end = std::max(Traits::length(leaf->key), Traits::length(key));
+		unsigned int common = 0;
+		while (depth + common < end && Traits::byteAt(leaf->key, depth + common) == Traits::byteAt(key, depth + common)) {
+			common++;
+		}
+
+		Node4* n = new Node4{};
+		n->prefixLength = common;
+		for (unsigned int i = 0; i < std::min(common, maxPrefixLength); i++) {
+			n->prefix[i] = Traits::byteAt(key, depth + i);
+		}
+
+		Node* inner = n;
+		addChild(inner, Traits::byteAt(leaf->key, depth + common), leaf);
+		addChild(inner, Traits::byteAt(key, depth + common), new Leaf{ key, value });
+		reference = inner;
+		return true;
+	}
+
+	if (node->prefixLength) {
+		unsigned int mismatch = prefixMismatch(node, key, depth);
+		if (mismatch < node->prefixLength) {
+			//split the prefix - a new node holds its matching part and branches to the old node and the new leaf
+			Node4* n = new Node4{};
+			n->prefixLength = mismatch;
+			for (unsigned int i = 0; i < std::min(mismatch, maxPrefixLength); i++) {
+				n->prefix[i] = Traits::byteAt(key, depth + i);
+			}
+
+			Node* inner = n;
+			if (node->prefixLength <= maxPrefixLength) {
+				addChild(inner, node->prefix[mismatch], node);
+				node->prefixLength -= mismatch + 1;
+				std::memmove(node->prefix, node->prefix + mismatch + 1, node->prefixLength);
+			}
+			else {
+				//the prefix is not stored whole, rebuild the stored part from a leaf below the node
+				node->prefixLength -= mismatch + 1;
+				const Leaf* leaf = minimumLeaf(node);
+				addChild(inner, Traits::byteAt(leaf->key, depth + mismatch), node);
+				for (unsigned int i = 0; i < std::min(node->prefixLength, maxPrefixLength); i++) {
+					node->prefix[i] = Traits::byteAt(leaf->key, depth + mismatch + 1 + i);
+				}
+			}
+
+			addChild(inner, Traits::byteAt(key, depth + mismatch), new Leaf{ key, value });
+			reference = inner;
+			return true;
+		}
+
+		depth += node->prefixLength;
+	}
+
+	unsigned char byte = Traits::byteAt(key, depth);
+	Node** child = findChild(node, byte);
+	if (child) {
+		return this->insertFromNode(*child, key, value, depth + 1);
+	}
+
+	addChild(reference, byte, new Leaf{ key, value });
+	return true;
+}
+
+template<typename Key, typename Value>
+bool ART<Key, Value>::removeFromNode(Node*& reference, const Key& key, unsigned int depth) {
+	Node* node = reference;
+	if (!node) {
+		return false;
+	}
+
+	if (node->type == LeafType) {
+		if (!leafMatches(static_cast<Leaf*>(node), key)) {
+			return false;
+		}
+
+		deleteNode(node);
+		reference = nullptr;
+		return true;
+	}
+
+	if (node->prefixLength) {
+		if (checkPrefix(node, key, depth) != std::min(node->prefixLength, maxPrefixLength)) {
+			return false;
+		}
+		depth += node->prefixLength;
+	}
+
+	if (depth >= Traits::length(key)) {
+		return false;
+	}
+
+	unsigned char byte = Traits::byteAt(key, depth);
+	Node** child = findChild(node, byte);
+	if (!child) {
+		return false;
+	}
+
+	//a leaf child is removed by its parent, which may have to shrink
+	if ((*child)->type == LeafType) {
+		if (!leafMatches(static_cast<Leaf*>(*child), key)) {
+			return false;
+		}
+
+		deleteNode(*child);
+		removeChild(reference, byte);
+		return true;
+	}
+
+	return this->removeFromNode(*child, key, depth + 1);
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void ART<Key, Value>::forEachFromNode(const Node* node, Function& function) {
+	switch (node->type) {
+		case LeafType: {
+			const Leaf* leaf = static_cast<const Leaf*>(node);
+			function(leaf->key, leaf->value);
+			break;
+		}
+		case Node4Type: {
+			const Node4* n = static_cast<const Node4*>(node);
+			for (unsigned int i = 0; i < n->count; i++) {
+				forEachFromNode(n->children[i], function);
+			}
+			break;
+		}
+		case Node16Type: {
+			const Node16* n = static_cast<const Node16*>(node);
+			for (unsigned int i = 0; i < n->count; i++) {
+				forEachFromNode(n->children[i], function);
+			}
+			break;
+		}
+		case Node48Type: {
+			const Node48* n = static_cast<const Node48*>(node);
+			for (unsigned int i = 0; i < 256; i++) {
+				if (n->childIndex[i]) {
+					forEachFromNode(n->children[n->childIndex[i] - 1], function);
+				}
+			}
+			break;
+		}
+		case Node256Type: {
+			const Node256* n = static_cast<const Node256*>(node);
+			for (unsigned int i = 0; i < 256; i++) {
+				if (n->children[i]) {
+					forEachFromNode(n->children[i], function);
+				}
+			}
+			break;
+		}
+	}
+}
+
+template<typename Key, typename Value>
+bool ART<Key, Value>::insert(const Key& key, const Value& value) {
+	if (!Traits::valid(key)) {
+		return false;
+	}
+
+	this->elementsCount += this->insertFromNode(this->root, key, value, 0);
+	return true;
+}
+
+//the stored prefixes are compared on the way down and longer prefixes are skipped,
+//so the key of the leaf which is reached is compared whole
+template<typename Key, typename Value>
+const Value* ART<Key, Value>::getValue(const Key& key) const {
+	Node* node = this->root;
+	unsigned int depth = 0;
+	unsigned int length = Traits::length(key);
+
+	while (node) {
+		if (node->type == LeafType) {
+			const Leaf* leaf = static_cast<const Leaf*>(node);
+			return leafMatches(leaf, key) ? &leaf->value : nullptr;
+		}
+
+		if (node->prefixLength) {
+			if (checkPrefix(node, key, depth) != std::min(node->prefixLength, maxPrefixLength)) {
+				return nullptr;
+			}
+			depth += node->prefixLength;
+		}
+
+		if (depth >= length) {
+			return nullptr;
+		}
+
+		Node** child = findChild(node, Traits::byteAt(key, depth));
+		node = child ? *child : nullptr;
+		depth++;
+	}
+
+	return nullptr;
+}
+
+template<typename Key, typename Value>
+bool ART<Key, Value>::contains(const Key& key) const {
+	return this->getValue(key) != nullptr;
+}
+
+template<typename Key, typename Value>
+void ART<Key, Value>::remove(const Key& key) {
+	this->elementsCount -= this->removeFromNode(this->root, key, 0);
+}
+
+template<typename Key, typename Value>
+unsigned int ART<Key, Value>::numberOfElements() const {
+	return this->elementsCount;
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void ART<Key, Value>::forEach(Function function) const {
+	if (this->root) {
+		forEachFromNode(this->root, function);
+	}
+}
@@ -0,0 +1,264 @@
+#ifndef ART_H
+#define ART_H
+
+#include<vector>
+#include<string>
+#include<type_traits>
+
+/// <summary>
+/// Describes a key as a binary-comparable string of bytes - the bytes of two keys compare in the order of the keys
+/// and no key is a prefix of another one, as required by the radix tree
+/// </summary>
+template<typename Key, typename Enable = void>
+struct ARTKeyTraits;
+
+/// <summary>
+/// Integers are stored big-endian with the sign bit flipped, so that the negative ones come first
+/// </summary>
+template<typename Key>
+struct ARTKeyTraits<Key, typename std::enable_if<std::is_integral<Key>::value>::type> {
+	typedef typename std::make_unsigned<Key>::type Bits;
+
+	static bool valid(const Key&) {
+		return true;
+	}
+
+	static unsigned int length(const Key&) {
+		return sizeof(Key);
+	}
+
+	static unsigned char byteAt(const Key& key, const unsigned int& depth) {
+		Bits bits = (Bits)key;
+		if (std::is_signed<Key>::value) {
+			bits ^= (Bits)1 << (8 * sizeof(Key) - 1);
+		}
+
+		return (unsigned char)(bits >> (8 * (sizeof(Key) - 1 - depth)));
+	}
+};
+
+/// <summary>
+/// Strings are stored as their bytes followed by a terminating zero byte, so strings with zero bytes are not valid keys
+/// </summary>
+template<>
+struct ARTKeyTraits<std::string> {
+	static bool valid(const std::string& key) {
+		return key.find('\0') == std::string::npos;
+	}
+
+	static unsigned int length(const std::string& key) {
+		return (unsigned int)key.size() + 1;
+	}
+
+	static unsigned char byteAt(const std::string& key, const unsigned int& depth) {
+		return depth < key.size() ? (unsigned char)key[depth] : 0;
+	}
+};
+
+/// <summary>
+/// A template class representing an Adaptive Radix Tree with the interface of the AVL tree
+/// The inner nodes branch on a byte of the key and grow from 4 to 16, 48 and 256 children as needed,
+/// chains of single-child nodes are compressed into a prefix of the node below them
+/// Supports the key types with ARTKeyTraits - integers and std::string
+/// Duplicate keys are not supported - the lastly added value for a key is taken
+/// </summary>
+template<typename Key, typename Value>
+class ART
+{
+	private:
+		typedef ARTKeyTraits<Key> Traits;
+
+		/// <summary>
+		/// The number of prefix bytes stored in a node, longer prefixes are checked against a leaf below the node
+		/// </summary>
+		static constexpr unsigned int maxPrefixLength = 8;
+
+		enum NodeType : unsigned char { LeafType, Node4Type, Node16Type, Node48Type, Node256Type };
+
+		struct Node {
+			NodeType type;
+			unsigned short count;
+			unsigned int prefixLength;
+			unsigned char prefix[maxPrefixLength];
+
+			Node(const NodeType&);
+		};
+
+		struct Leaf : Node {
+			Key key;
+			Value value;
+
+			Leaf(const Key&, const Value&);
+		};
+
+		/// <summary>
+		/// Node4 and Node16 keep the key bytes sorted with the child at the same position
+		/// </summary>
+		struct Node4 : Node {
+			unsigned char keys[4];
+			Node* children[4];
+
+			Node4();
+		};
+
+		struct Node16 : Node {
+			unsigned char keys[16];
+			Node* children[16];
+
+			Node16();
+		};
+
+		/// <summary>
+		/// Node48 maps a key byte to the position of its child plus one, 0 marks a missing child
+		/// </summary>
+		struct Node48 : Node {
+			unsigned char childIndex[256];
+			Node* children[48];
+
+			Node48();
+		};
+
+		struct Node256 : Node {
+			Node* children[256];
+
+			Node256();
+		};
+
+		/// <summary>
+		/// Copies the children count and the prefix of a node into the node replacing it
+		/// </summary>
+		static void copyHeader(Node*, const Node*);
+
+		/// <summary>
+		/// Finds the child of a node for a key byte
+		/// </summary>
+		/// <param>Node* the inner node</param>
+		/// <param>const unsigned char& the key byte</param>
+		/// <return>Node** the slot holding the child or nullptr if there is no such child</return>
+		static Node** findChild(Node*, const unsigned char&);
+
+		/// <summary>
+		/// Adds a child to a node, replacing the node with a larger one if it is full
+		/// </summary>
+		/// <param>Node*& the reference to the node inside its parent</param>
+		/// <param>const unsigned char& the key byte</param>
+		/// <param>Node* the child</param>
+		static void addChild(Node*&, const unsigned char&, Node*);
+
+		/// <summary>
+		/// Removes a child from a node, replacing the node with a smaller one if it becomes sparse
+		/// A Node4 left with a single child is replaced by the child, merging their prefixes
+		/// </summary>
+		/// <param>Node*& the reference to the node inside its parent</param>
+		/// <param>const unsigned char& the key byte</param>
+		static void removeChild(Node*&, const unsigned char&);
+
+		/// <summary>
+		/// Counts the stored prefix bytes of a node matching a key from a depth, without looking at the bytes which are not stored
+		/// </summary>
+		/// <return>unsigned int the number of matching bytes</return>
+		static unsigned int checkPrefix(const Node*, const Key&, const unsigned int&);
+
+		/// <summary>
+		/// Finds the position of the first byte of the whole prefix of a node which does not match a key from a depth
+		/// </summary>
+		/// <return>unsigned int the position or the prefix length if the whole prefix matches</return>
+		static unsigned int prefixMismatch(const Node*, const Key&, const unsigned int&);
+
+		/// <summary>
+		/// Finds the leaf with the smallest key below a node
+		/// </summary>
+		static const Leaf* minimumLeaf(const Node*);
+
+		/// <summary>
+		/// Checks whether a leaf holds a key
+		/// </summary>
+		static bool leafMatches(const Leaf*, const Key&);
+
+		/// <summary>
+		/// Inserts a key-value pair into the subtree referenced by the parameter
+		/// If a pair with the same key exists, its value will be changed
+		/// </summary>
+		/// <param>Node*& the reference to the root of the subtree</param>
+		/// <param>const Key& the key to insert</param>
+		/// <param>const Value& the value to insert</param>
+		/// <param>unsigned int the depth of the subtree in key bytes</param>
+		/// <return>bool whether a new pair was added</return>
+		bool insertFromNode(Node*&, const Key&, const Value&, unsigned int);
+
+		/// <summary>
+		/// Removes a key from the subtree referenced by the parameter
+		/// </summary>
+		/// <param>Node*& the reference to the root of the subtree</param>
+		/// <param>const Key& the key to remove</param>
+		/// <param>unsigned int the depth of the subtree in key bytes</param>
+		/// <return>bool whether the key was found</return>
+		bool removeFromNode(Node*&, const Key&, unsigned int);
+
+		/// <summary>
+		/// Calls a function for all pairs below a node in ascending order of the keys
+		/// </summary>
+		template<typename Function>
+		static void forEachFromNode(const Node*, Function&);
+
+		/// <summary>
+		/// Deletes a node of any type
+		/// </summary>
+		static void deleteNode(Node*);
+
+		/// <summary>
+		/// Deletes a tree recursively, used by the destructor
+		/// </summary>
+		/// <param>Node* the root of the tree to be deleted</param>
+		void deleteTree(Node*);
+
+		Node* root;
+		unsigned int elementsCount;
+	public:
+		~ART();
+		ART();
+		ART(const ART&) = delete;
+		ART& operator=(const ART&) = delete;
+
+		/// <summary>
+		/// Creates a tree by a vector of key-value pairs, the last pair of a key is taken
+		/// </summary>
+		/// <param>const std::vector<std::pair<Key, Value>>& the key-values pairs</param>
+		ART(const std::vector<std::pair<Key, Value>>&);
+
+		/// <summary>
+		/// Inserts a key-value pair or updates the value of an existing key
+		/// </summary>
+		/// <return>bool false if the key is not valid for its ARTKeyTraits (a string with a zero byte) and was not inserted</return>
+		bool insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Getter for the value of a key
+		/// </summary>
+		/// <return>const Value* the value or nullptr if the key is not in the tree</return>
+		const Value* getValue(const Key&) const;
+
+		/// <summary>
+		/// Checks whether a key is inside the tree
+		/// </summary>
+		bool contains(const Key&) const;
+
+		/// <summary>
+		/// Removes a key from the tree
+		/// </summary>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Getter for the number of key-value pairs in the tree
+		/// </summary>
+		unsigned int numberOfElements() const;
+
+		/// <summary>
+		/// Calls a function for all pairs in ascending order of the keys
+		/// </summary>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEach(Function) const;
+};
+
+#endif
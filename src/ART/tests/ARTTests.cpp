@@ -0,0 +1,211 @@
+#include "src/Doctest/doctest.h"
+#include "src/ART/ART.cpp"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <cstdint>
+
+TEST_CASE("ART Insert") {
+	ART<int, int> tree;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i, i);
+	}
+
+	CHECK(tree.numberOfElements() == 1000);
+	CHECK(tree.contains(0));
+	CHECK(tree.contains(999));
+	CHECK(tree.contains(1000) == false);
+	CHECK(*tree.getValue(500) == 500);
+}
+
+TEST_CASE("ART Insert, duplicate key") {
+	ART<int, int> tree;
+	tree.insert(1, 1);
+	tree.insert(1, 2);
+
+	CHECK(tree.numberOfElements() == 1);
+	CHECK(*tree.getValue(1) == 2);
+}
+
+TEST_CASE("ART Bulk constructor") {
+	ART<int, int> tree{ { { 3, 3 }, { 1, 1 }, { 3, 4 } } };
+
+	CHECK(tree.numberOfElements() == 2);
+	CHECK(*tree.getValue(3) == 4);
+}
+
+TEST_CASE("ART Remove, all keys") {
+	ART<int, int> tree;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i * 7, i);
+	}
+	for (int i = 0; i < 1000; i++) {
+		tree.remove(i * 7);
+	}
+
+	CHECK(tree.numberOfElements() == 0);
+	CHECK(tree.contains(0) == false);
+
+	tree.insert(5, 5);
+	CHECK(tree.numberOfElements() == 1);
+}
+
+TEST_CASE("ART Remove, key that does not exist") {
+	ART<int, int> tree;
+	tree.remove(1);
+	tree.insert(2, 2);
+	tree.remove(1);
+	tree.remove(3);
+
+	CHECK(tree.numberOfElements() == 1);
+}
+
+TEST_CASE("ART ForEach, signed keys in order") {
+	ART<int, int> tree;
+	for (int i = -500; i < 500; i++) {
+		tree.insert(i * 1000003, i);
+	}
+
+	std::vector<int> keys;
+	tree.forEach([&keys](const int& key, const int&) {
+		keys.push_back(key);
+	});
+
+	CHECK(keys.size() == 1000);
+	CHECK(std::is_sorted(keys.begin(), keys.end()));
+}
+
+TEST_CASE("ART Random operations, sparse 64-bit keys") {
+	ART<std::uint64_t, int> tree;
+	std::map<std::uint64_t, int> expected;
+	std::mt19937_64 generator{ 7 };
+	std::vector<std::uint64_t> keys(5000);
+	for (std::uint64_t& key : keys) {
+		key = generator();
+	}
+
+	for (int i = 0; i < 100000; i++) {
+		std::uint64_t key = keys[generator() % keys.size()];
+		if (generator() % 2 == 0) {
+			tree.remove(key);
+			expected.erase(key);
+		} else {
+			tree.insert(key, i);
+			expected[key] = i;
+		}
+	}
+
+	CHECK(tree.numberOfElements() == expected.size());
+
+	std::vector<std::pair<std::uint64_t, int>> elements;
+	tree.forEach([&elements](const std::uint64_t& key, const int& value) {
+		elements.push_back({ key, value });
+	});
+	CHECK(elements == std::vector<std::pair<std::uint64_t, int>>(expected.begin(), expected.end()));
+}
+
+TEST_CASE("ART Random operations, dense keys") {
+	ART<int, int> tree;
+	std::map<int, int> expected;
+	std::mt19937 generator{ 11 };
+	std::uniform_int_distribution<int> keys{ 0, 3000 };
+
+	for (int i = 0; i < 100000; i++) {
+		int key = keys(generator);
+		if (generator() % 2 == 0) {
+			tree.remove(key);
+			expected.erase(key);
+		} else {
+			tree.insert(key, i);
+			expected[key] = i;
+		}
+	}
+
+	CHECK(tree.numberOfElements() == expected.size());
+
+	bool same = true;
+	for (int key = 0; key <= 3000; key++) {
+		const int* value = tree.getValue(key);
+		same = same && (value ? expected.count(key) == 1 && *value == expected[key] : expected.count(key) == 0);
+	}
+	CHECK(same);
+}
+
+TEST_CASE("ART String keys") {
+	ART<std::string, int> tree;
+	tree.insert("a", 1);
+	tree.insert("ab", 2);
+	tree.insert("abc", 3);
+	tree.insert("", 0);
+	tree.insert("b", 4);
+
+	CHECK(tree.numberOfElements() == 5);
+	CHECK(*tree.getValue("ab") == 2);
+	CHECK(*tree.getValue("") == 0);
+	CHECK(tree.contains("abcd") == false);
+
+	tree.remove("ab");
+	CHECK(tree.contains("ab") == false);
+	CHECK(tree.contains("abc"));
+
+	std::vector<std::string> keys;
+	tree.forEach([&keys](const std::string& key, const int&) {
+		keys.push_back(key);
+	});
+	CHECK(keys == std::vector<std::string>{ "", "a", "abc", "b" });
+}
+
+TEST_CASE("ART String keys, zero bytes are rejected") {
+	ART<std::string, int> tree;
+	CHECK(tree.insert("a", 1));
+	CHECK(tree.insert(std::string("a\0", 2), 2) == false);
+	CHECK(tree.insert(std::string("\0", 1), 3) == false);
+	CHECK(tree.insert("ab", 4));
+
+	CHECK(tree.numberOfElements() == 2);
+	CHECK(*tree.getValue("a") == 1);
+	CHECK(tree.contains(std::string("a\0", 2)) == false);
+	CHECK(tree.contains(std::string("\0", 1)) == false);
+
+	std::vector<std::string> keys;
+	tree.forEach([&keys](const std::string& key, const int&) {
+		keys.push_back(key);
+	});
+	CHECK(keys == std::vector<std::string>{ "a", "ab" });
+}
+
+TEST_CASE("ART String keys, long common prefixes") {
+	ART<std::string, int> tree;
+	std::map<std::string, int> expected;
+	std::mt19937 generator{ 3 };
+	const std::string prefix = "customer/region-eu-west/account/";
+
+	for (int i = 0; i < 20000; i++) {
+		std::string key = prefix + std::to_string(generator() % 4000) + (generator() % 2 ? "/orders" : "");
+		if (generator() % 3 == 0) {
+			tree.remove(key);
+			expected.erase(key);
+		} else {
+			tree.insert(key, i);
+			expected[key] = i;
+		}
+	}
+
+	CHECK(tree.numberOfElements() == expected.size());
+	CHECK(tree.contains(prefix) == false);
+	CHECK(tree.contains("customer/region-eu-east/account/1") == false);
+
+	std::vector<std::pair<std::string, int>> elements;
+	tree.forEach([&elements](const std::string& key, const int& value) {
+		elements.push_back({ key, value });
+	});
+	CHECK(elements == std::vector<std::pair<std::string, int>>(expected.begin(), expected.end()));
+
+	bool same = true;
+	for (const std::pair<const std::string, int>& element : expected) {
+		const int* value = tree.getValue(element.first);
+		same = same && value && *value == element.second;
+	}
+	CHECK(same);
+}
@@ -1,6 +1,11 @@
 #include "AVL.h"
+#include "../Parallel/WorkStealingPool.h"
 #include <stdlib.h>
 #include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <utility>
 
 template<typename Key, typename Value>
 AVL<Key, Value>::AVLNode::AVLNode(const Key& _key, const Value& _value, const int& _height) : 
@@ -39,16 +44,34 @@ bool AVL<Key, Value>::isAVLInternal(AVLNode* const& node) const {
 		return true;
 	}
 
+#ifdef AVL_WAVL
+	int left = node->height - this->nodeHeight(node->left);
+	int right = node->height - this->nodeHeight(node->right);
+	if (left < 1 || left > 2 || right < 1 || right > 2) {
+		return false;
+	}
+
+	if (!node->left && !node->right && node->height != 0) {
+		return false;
+	}
+#else
 	if (std::abs(this->nodeBalanceFactor(node)) > 1) {
 		return false;
 	}
 
+	//the balance factors are only meaningful if the stored heights are
+	if (node->height != 1 + std::max(this->nodeHeight(node->left), this->nodeHeight(node->right))) {
+		return false;
+	}
+#endif
+
 	return this->isAVLInternal(node->left) && this->isAVLInternal(node->right);
 }
 
 template<typename Key, typename Value>
 AVL<Key, Value>::AVL() 
-	: root(nullptr) {}
+	: root(nullptr),
+	version(0) {}
 
 
 template<typename Key, typename Value>
@@ -73,6 +96,30 @@ typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::createTree(const std::vector
 	return newNode;
 }
 
+template<typename Key, typename Value>
+typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::createTree(const std::vector<std::pair<Key, Value>>& elements, const int& start, const int& end, WorkStealingPool& pool) {
+	if (end - start < parallelBuildCutoff) {
+		return this->createTree(elements, start, end);
+	}
+
+	int elementsSize = end + 1 - start;
+	int currIndex = start;
+	currIndex += elementsSize % 2 == 0 ? elementsSize / 2 - 1 : elementsSize / 2;
+
+	const std::pair<Key, Value>& current = elements[currIndex];
+	AVLNode* newNode = new AVLNode{ current.first, current.second };
+
+	//the subtrees share no nodes, a nested invoke runs on the same pool threads
+	pool.parallelInvoke(
+		[&]() { newNode->left = this->createTree(elements, start, currIndex - 1, pool); },
+		[&]() { newNode->right = this->createTree(elements, currIndex + 1, end, pool); });
+
+	newNode->height = std::max(this->nodeHeight(newNode->left), this->nodeHeight(newNode->right));
+	newNode->height += 1;
+
+	return newNode;
+}
+
 template<typename Key, typename Value>
 void AVL<Key, Value>::deleteTree(AVLNode* node) {
 	if (!node) {
@@ -91,7 +138,7 @@ AVL<Key, Value>::~AVL() {
 }
  
 template<typename Key, typename Value>
-AVL<Key, Value>::AVL(std::vector<std::pair<Key, Value>> elements) {
+std::vector<std::pair<Key, Value>> AVL<Key, Value>::sortedElements(std::vector<std::pair<Key, Value>>& elements) {
 	std::qsort(
 		elements.data(),
 		elements.size(),
@@ -116,7 +163,21 @@ AVL<Key, Value>::AVL(std::vector<std::pair<Key, Value>> elements) {
 		filtered.push_back(elements[i]);
 	}
 
+	return filtered;
+}
+
+template<typename Key, typename Value>
+AVL<Key, Value>::AVL(std::vector<std::pair<Key, Value>> elements) {
+	std::vector<std::pair<Key, Value>> filtered = sortedElements(elements);
 	this->root = this->createTree(filtered, 0, filtered.size() - 1);
+	this->version = 0;
+}
+
+template<typename Key, typename Value>
+AVL<Key, Value>::AVL(std::vector<std::pair<Key, Value>> elements, WorkStealingPool& pool) {
+	std::vector<std::pair<Key, Value>> filtered = sortedElements(elements);
+	this->root = this->createTree(filtered, 0, (int)filtered.size() - 1, pool);
+	this->version = 0;
 }
 
 template<typename Key, typename Value>
@@ -132,6 +193,8 @@ int AVL<Key, Value>::balanceFactor() const {
 template<typename Key, typename Value>
 void AVL<Key, Value>::insert(const Key& key, const Value& value) {
 	this->root = this->insertFromNode(this->root, key, value);
+	this->version++;
+	AVL_STATS_RECORD(this->stats.endUpdate());
 }
 
 template<typename Key, typename Value>
@@ -144,9 +207,9 @@ typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::rotateRight(AVLNode* y)
 	x->right = y;
 	y->left = z;
 
-	// Update heights
-	x->height = 1 + std::max(this->nodeHeight(x->left), this->nodeHeight(x->right));
+	// Update heights, y is below x now
 	y->height = 1 + std::max(this->nodeHeight(y->left), this->nodeHeight(y->right));
+	x->height = 1 + std::max(this->nodeHeight(x->left), this->nodeHeight(x->right));
 	
 	// Return new root
 	return x;
@@ -174,12 +237,14 @@ template<typename Key, typename Value>
 typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::balanceNode(AVLNode* x)
 {
 	if (this->nodeBalanceFactor(x) < -1) {//left case
+		AVL_STATS_RECORD(this->stats.recordRotation(this->nodeBalanceFactor(x->right) > 0));
 		if (this->nodeBalanceFactor(x->right) > 0) {//right left case
 			x->right = this->rotateRight(x->right);
 		}
 
 		x = this->rotateLeft(x);
 	} else if (this->nodeBalanceFactor(x) > 1) {//right case
+		AVL_STATS_RECORD(this->stats.recordRotation(this->nodeBalanceFactor(x->left) < 0));
 		if (this->nodeBalanceFactor(x->left) < 0) {//left right case
 			x->left = this->rotateLeft(x->left);
 		}
@@ -190,12 +255,133 @@ typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::balanceNode(AVLNode* x)
 	return x;
 }
 
+#ifndef AVL_WAVL
+template<typename Key, typename Value>
+typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::rebalanceAfterInsert(AVLNode* node) {
+	node->height = 1 + std::max(this->nodeHeight(node->left), this->nodeHeight(node->right));
+	return this->balanceNode(node);
+}
+
+template<typename Key, typename Value>
+typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::rebalanceAfterRemove(AVLNode* node) {
+	node->height = 1 + std::max(this->nodeHeight(node->left), this->nodeHeight(node->right));
+	return this->balanceNode(node);
+}
+#else
+//the rotations recalculate heights, the ranks are set after them
+template<typename Key, typename Value>
+typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::rebalanceAfterInsert(AVLNode* x) {
+	int left = x->height - this->nodeHeight(x->left);
+	int right = x->height - this->nodeHeight(x->right);
+	if (left && right) {
+		return x;
+	}
+
+	if (left + right == 1) {//0,1 node - promote and continue with the parent
+		x->height++;
+		return x;
+	}
+
+	//0,2 node - the promoted child is a 1,2 node, rotate it up
+	bool leftHeavy = !left;
+	AVLNode* child = leftHeavy ? x->left : x->right;
+	AVLNode* inner = leftHeavy ? child->right : child->left;
+	int rankX = x->height;
+	int rankChild = child->height;
+
+	if (child->height - this->nodeHeight(inner) == 2) {
+		AVL_STATS_RECORD(this->stats.recordRotation(false));
+		AVLNode* root = leftHeavy ? this->rotateRight(x) : this->rotateLeft(x);
+		child->height = rankChild;
+		x->height = rankX - 1;
+
+		return root;
+	}
+
+	AVL_STATS_RECORD(this->stats.recordRotation(true));
+	int rankInner = inner->height;
+	AVLNode* root;
+	if (leftHeavy) {
+		x->left = this->rotateLeft(child);
+		root = this->rotateRight(x);
+	} else {
+		x->right = this->rotateRight(child);
+		root = this->rotateLeft(x);
+	}
+	inner->height = rankInner + 1;
+	child->height = rankChild - 1;
+	x->height = rankX - 1;
+
+	return root;
+}
+
 template<typename Key, typename Value>
-typename const AVL<Key, Value>::AVLNode* AVL<Key, Value>::findFromNode(AVLNode* const& node, const Key& key) const {
+typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::rebalanceAfterRemove(AVLNode* x) {
+	if (!x->left && !x->right) {//a 2,2 leaf is demoted
+		x->height = 0;
+		return x;
+	}
+
+	int left = x->height - this->nodeHeight(x->left);
+	int right = x->height - this->nodeHeight(x->right);
+	if (left < 3 && right < 3) {
+		return x;
+	}
+
+	bool leftShort = left == 3;
+	AVLNode* sibling = leftShort ? x->right : x->left;
+	if ((leftShort ? right : left) == 2) {//3,2 node - demote and continue with the parent
+		x->height--;
+		return x;
+	}
+
+	AVLNode* inner = leftShort ? sibling->left : sibling->right;
+	AVLNode* outer = leftShort ? sibling->right : sibling->left;
+	int innerDifference = sibling->height - this->nodeHeight(inner);
+	int outerDifference = sibling->height - this->nodeHeight(outer);
+	if (innerDifference == 2 && outerDifference == 2) {//3,1 node with a 2,2 sibling - demote both
+		x->height--;
+		sibling->height--;
+		return x;
+	}
+
+	int rankX = x->height;
+	int rankSibling = sibling->height;
+	if (outerDifference == 1) {//the sibling rotates up, the rebalancing ends
+		AVL_STATS_RECORD(this->stats.recordRotation(false));
+		AVLNode* root = leftShort ? this->rotateLeft(x) : this->rotateRight(x);
+		sibling->height = rankSibling + 1;
+		x->height = x->left || x->right ? rankX - 1 : 0;
+
+		return root;
+	}
+
+	//the inner child of the sibling rotates up twice, the rebalancing ends
+	AVL_STATS_RECORD(this->stats.recordRotation(true));
+	int rankInner = inner->height;
+	AVLNode* root;
+	if (leftShort) {
+		x->right = this->rotateRight(sibling);
+		root = this->rotateLeft(x);
+	} else {
+		x->left = this->rotateLeft(sibling);
+		root = this->rotateRight(x);
+	}
+	inner->height = rankInner + 2;
+	sibling->height = rankSibling - 1;
+	x->height = rankX - 2;
+
+	return root;
+}
+#endif
+
+template<typename Key, typename Value>
+const typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::findFromNode(AVLNode* const& node, const Key& key) const {
 	if (!node) {
 		return nullptr;
 	}
 
+	AVL_STATS_RECORD(this->stats.searchDepth++);
 	if (key < node->key) {
 		return findFromNode(node->left, key);
 	} else if (key > node->key) {
@@ -205,6 +391,54 @@ typename const AVL<Key, Value>::AVLNode* AVL<Key, Value>::findFromNode(AVLNode*
 	return node;
 }
 
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::findBatch(const std::vector<Key>& keys, Function function) const {
+	for (size_t start = 0; start < keys.size(); start += batchGroupSize) {
+		size_t groupSize = std::min<size_t>(batchGroupSize, keys.size() - start);
+		const AVLNode* current[batchGroupSize];
+		for (size_t i = 0; i < groupSize; i++) {
+			current[i] = this->root;
+			if (!current[i]) {
+				function(start + i, nullptr);
+			}
+		}
+
+		//every round moves each unfinished search one level down, its next node is loaded while the others are compared
+		size_t active = groupSize;
+		while (active) {
+			active = 0;
+			for (size_t i = 0; i < groupSize; i++) {
+				const AVLNode* node = current[i];
+				if (!node) {
+					continue;
+				}
+
+				AVL_STATS_RECORD(this->stats.searchDepth++);
+				const Key& key = keys[start + i];
+				if (key < node->key) {
+					node = node->left;
+				} else if (key > node->key) {
+					node = node->right;
+				} else {
+					function(start + i, node);
+					current[i] = nullptr;
+					continue;
+				}
+
+				SIMD_PREFETCH(node);
+				current[i] = node;
+				if (!node) {
+					function(start + i, nullptr);
+				}
+				active += node != nullptr;
+			}
+		}
+	}
+
+	AVL_STATS_RECORD(this->stats.searches += keys.size());
+}
+
 template<typename Key, typename Value>
 typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::insertFromNode(AVLNode* node, const Key& key, const Value& value) {
 	if (!node) {
@@ -220,8 +454,11 @@ typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::insertFromNode(AVLNode* node
 		return node;
 	}
 
-	node->height = 1 + std::max(this->nodeHeight(node->left), this->nodeHeight(node->right));
-	return this->balanceNode(node);
+	AVL_STATS_RECORD(int previousHeight = node->height; AVLNode* previousRoot = node);
+	node = this->rebalanceAfterInsert(node);
+	AVL_STATS_RECORD(this->stats.currentRebalanceDepth += node != previousRoot || node->height != previousHeight);
+
+	return node;
 }
 
 template<typename Key, typename Value>
@@ -260,8 +497,11 @@ typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::removeFromNode(AVLNode* node
 		return nullptr;
 	}
 
-	node->height = 1 + std::max(this->nodeHeight(node->left), this->nodeHeight(node->right));
-	return this->balanceNode(node);
+	AVL_STATS_RECORD(int previousHeight = node->height; AVLNode* previousRoot = node);
+	node = this->rebalanceAfterRemove(node);
+	AVL_STATS_RECORD(this->stats.currentRebalanceDepth += node != previousRoot || node->height != previousHeight);
+
+	return node;
 }
 
 template<typename Key, typename Value>
@@ -276,7 +516,8 @@ typename AVL<Key, Value>::AVLNode* AVL<Key, Value>::largestNode(AVLNode* node) {
 
 template<typename Key, typename Value>
 const Value* AVL<Key, Value>::getValue(const Key& key) const {
-	AVLNode* result = this->findFromNode(this->root, key);
+	AVL_STATS_RECORD(this->stats.searches++);
+	const AVLNode* result = this->findFromNode(this->root, key);
 	if (!result) {
 		return nullptr;
 	}
@@ -304,12 +545,31 @@ const Key* AVL<Key, Value>::getRootKey() const {
 
 template<typename Key, typename Value>
 bool AVL<Key, Value>::contains(const Key& key) const {
+	AVL_STATS_RECORD(this->stats.searches++);
 	return this->findFromNode(this->root, key) != nullptr;
 }
 
+template<typename Key, typename Value>
+void AVL<Key, Value>::containsBatch(const std::vector<Key>& keys, std::vector<bool>& out) const {
+	out.resize(keys.size());
+	this->findBatch(keys, [&out](const size_t& index, const AVLNode* node) {
+		out[index] = node != nullptr;
+	});
+}
+
+template<typename Key, typename Value>
+void AVL<Key, Value>::getValueBatch(const std::vector<Key>& keys, std::vector<const Value*>& out) const {
+	out.resize(keys.size());
+	this->findBatch(keys, [&out](const size_t& index, const AVLNode* node) {
+		out[index] = node ? &node->value : nullptr;
+	});
+}
+
 template<typename Key, typename Value>
 void AVL<Key, Value>::remove(const Key& key) {
 	this->root = this->removeFromNode(this->root, key);
+	this->version++;
+	AVL_STATS_RECORD(this->stats.endUpdate());
 }
 
 template<typename Key, typename Value>
@@ -325,3 +585,563 @@ template<typename Key, typename Value>
 int AVL<Key, Value>::nodesCount() const {
 	return this->nodesCountInternal(this->root);
 }
+
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::forEachFromNode(AVLNode* const& node, Function& function) const {
+	if (!node) {
+		return;
+	}
+
+	this->forEachFromNode(node->left, function);
+	function(node->key, node->value);
+	this->forEachFromNode(node->right, function);
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::forEach(Function function) const {
+	this->forEachFromNode(this->root, function);
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::forEachFromNode(AVLNode* const& node, const Key* const& low, const Key* const& high, Function& function) const {
+	if (!node) {
+		return;
+	}
+	if (!low && !high) {
+		this->forEachFromNode(node, function);
+		return;
+	}
+
+	if (low && node->key < *low) {
+		this->forEachFromNode(node->right, low, high, function);
+		return;
+	}
+	if (high && *high < node->key) {
+		this->forEachFromNode(node->left, low, high, function);
+		return;
+	}
+
+	//the node is inside the range, so it bounds the keys of its left subtree from above and of its right one from below
+	this->forEachFromNode(node->left, low, nullptr, function);
+	function(node->key, node->value);
+	this->forEachFromNode(node->right, nullptr, high, function);
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::parallelForEachFromNode(AVLNode* const& node, const Key* const& low, const Key* const& high, Function& function, WorkStealingPool& pool) const {
+	if (!node) {
+		return;
+	}
+	if (node->height < parallelScanCutoffHeight) {
+		this->forEachFromNode(node, low, high, function);
+		return;
+	}
+
+	if (low && node->key < *low) {
+		this->parallelForEachFromNode(node->right, low, high, function, pool);
+		return;
+	}
+	if (high && *high < node->key) {
+		this->parallelForEachFromNode(node->left, low, high, function, pool);
+		return;
+	}
+
+	pool.parallelInvoke(
+		[&]() {
+			this->parallelForEachFromNode(node->left, low, nullptr, function, pool);
+			function(node->key, node->value);
+		},
+		[&]() { this->parallelForEachFromNode(node->right, nullptr, high, function, pool); });
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::parallelForEach(const Key& low, const Key& high, Function function, WorkStealingPool& pool) const {
+	if (high < low) {
+		return;
+	}
+
+	this->parallelForEachFromNode(this->root, &low, &high, function, pool);
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::parallelForEach(const Key& low, const Key& high, Function function, const unsigned int& threads) const {
+	WorkStealingPool pool{ threads };
+	this->parallelForEach(low, high, function, pool);
+}
+
+template<typename Key, typename Value>
+typename AVL<Key, Value>::Finger AVL<Key, Value>::finger() {
+	return Finger{ *this };
+}
+
+template<typename Key, typename Value>
+AVL<Key, Value>::Finger::Finger(AVL& _tree) :
+	tree(&_tree),
+	version(_tree.version)
+{
+	if (this->tree->root) {
+		this->path.push_back(PathEntry{ this->tree->root, nullptr, nullptr });
+	}
+}
+
+template<typename Key, typename Value>
+void AVL<Key, Value>::Finger::synchronize() {
+	if (this->version != this->tree->version) {
+		this->path.clear();
+		this->version = this->tree->version;
+	}
+}
+
+template<typename Key, typename Value>
+void AVL<Key, Value>::Finger::pushChild(AVLNode* child, const bool& isLeft) {
+	const PathEntry& parent = this->path.back();
+	if (isLeft) {
+		this->path.push_back(PathEntry{ child, parent.low, parent.node });
+	} else {
+		this->path.push_back(PathEntry{ child, parent.node, parent.high });
+	}
+}
+
+template<typename Key, typename Value>
+void AVL<Key, Value>::Finger::locate(const Key& key) {
+	this->synchronize();
+	AVL_STATS_RECORD(this->tree->stats.searches++);
+
+	//climb until the key is inside the bounds of the subtree
+	while (!this->path.empty()) {
+		const PathEntry& entry = this->path.back();
+		if ((!entry.low || entry.low->key < key) && (!entry.high || key < entry.high->key)) {
+			break;
+		}
+
+		this->path.pop_back();
+	}
+
+	if (this->path.empty()) {
+		if (!this->tree->root) {
+			return;
+		}
+
+		this->path.push_back(PathEntry{ this->tree->root, nullptr, nullptr });
+	}
+
+	while (true) {
+		AVLNode* node = this->path.back().node;
+		AVL_STATS_RECORD(this->tree->stats.searchDepth++);
+
+		AVLNode* child;
+		if (key < node->key) {
+			child = node->left;
+		} else if (key > node->key) {
+			child = node->right;
+		} else {
+			return;
+		}
+
+		if (!child) {
+			return;
+		}
+
+		this->pushChild(child, child == node->left);
+	}
+}
+
+template<typename Key, typename Value>
+bool AVL<Key, Value>::Finger::contains(const Key& key) {
+	return this->getValue(key) != nullptr;
+}
+
+template<typename Key, typename Value>
+const Value* AVL<Key, Value>::Finger::getValue(const Key& key) {
+	this->locate(key);
+	if (this->path.empty()) {
+		return nullptr;
+	}
+
+	AVLNode* node = this->path.back().node;
+	if (key < node->key || key > node->key) {
+		return nullptr;
+	}
+
+	return &node->value;
+}
+
+template<typename Key, typename Value>
+bool AVL<Key, Value>::Finger::seek(const Key& key) {
+	this->locate(key);
+	if (this->path.empty()) {
+		return false;
+	}
+
+	//a missing key ends the search at its predecessor or successor
+	if (this->path.back().node->key < key) {
+		return this->next();
+	}
+
+	return true;
+}
+
+template<typename Key, typename Value>
+bool AVL<Key, Value>::Finger::next() {
+	this->synchronize();
+	if (this->path.empty()) {
+		return false;
+	}
+
+	AVLNode* node = this->path.back().node;
+	if (node->right) {//the successor is the leftmost node of the right subtree
+		this->pushChild(node->right, false);
+		while (this->path.back().node->left) {
+			this->pushChild(this->path.back().node->left, true);
+		}
+
+		return true;
+	}
+
+	//otherwise it is the nearest ancestor whose left subtree holds the node
+	this->path.pop_back();
+	while (!this->path.empty() && this->path.back().node->key < node->key) {
+		this->path.pop_back();
+	}
+
+	return !this->path.empty();
+}
+
+template<typename Key, typename Value>
+bool AVL<Key, Value>::Finger::valid() const {
+	return this->version == this->tree->version && !this->path.empty();
+}
+
+template<typename Key, typename Value>
+const Key& AVL<Key, Value>::Finger::key() const {
+	return this->path.back().node->key;
+}
+
+template<typename Key, typename Value>
+const Value& AVL<Key, Value>::Finger::value() const {
+	return this->path.back().node->value;
+}
+
+template<typename Key, typename Value>
+void AVL<Key, Value>::Finger::insert(const Key& key, const Value& value) {
+	this->locate(key);
+	if (this->path.empty()) {
+		this->tree->root = new AVLNode{ key, value };
+		this->path.push_back(PathEntry{ this->tree->root, nullptr, nullptr });
+		this->version = ++this->tree->version;
+		AVL_STATS_RECORD(this->tree->stats.endUpdate());
+		return;
+	}
+
+	AVLNode* parent = this->path.back().node;
+	if (!(key < parent->key) && !(key > parent->key)) {
+		parent->value = value;
+		return;
+	}
+
+	AVLNode* n = new AVLNode{ key, value };
+	if (key < parent->key) {
+		parent->left = n;
+	} else {
+		parent->right = n;
+	}
+
+	//retrace the path while the heights change, an insert needs at most one rotation after which the height is restored
+	size_t rotated = this->path.size();
+	for (size_t i = this->path.size(); i-- > 0;) {
+		AVLNode* node = this->path[i].node;
+		int previousHeight = node->height;
+		AVLNode* balanced = this->tree->rebalanceAfterInsert(node);
+		AVL_STATS_RECORD(this->tree->stats.currentRebalanceDepth += balanced != node || balanced->height != previousHeight);
+		if (balanced != node) {
+			if (i == 0) {
+				this->tree->root = balanced;
+			} else if (this->path[i - 1].node->left == node) {
+				this->path[i - 1].node->left = balanced;
+			} else {
+				this->path[i - 1].node->right = balanced;
+			}
+
+			this->path[i].node = balanced;
+			rotated = i;
+			break;
+		}
+
+		if (node->height == previousHeight) {
+			break;
+		}
+	}
+
+	this->version = ++this->tree->version;
+	AVL_STATS_RECORD(this->tree->stats.endUpdate());
+
+	//the subtree of a rotated node keeps its bounds, only the path below it is rebuilt
+	if (rotated < this->path.size()) {
+		this->path.resize(rotated + 1);
+		this->locate(key);
+	} else {
+		this->pushChild(n, n == parent->left);
+	}
+}
+
+template<typename Key, typename Value>
+bool AVL<Key, Value>::saveTo(const std::string& path) const {
+	static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "saveTo needs trivially copyable keys and values");
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		return false;
+	}
+
+	//the nodes are numbered in the order they are written, so a child gets the next free number when its parent is written
+	std::vector<const AVLNode*> level;
+	if (this->root) {
+		level.push_back(this->root);
+	}
+	std::uint64_t count = 0;
+	std::vector<const AVLNode*> next;
+	std::vector<ImageNode> buffer;
+	std::uint32_t numbered = level.size();
+	buffer.reserve(4096);
+
+	ImageHeader header{};
+	std::memcpy(header.magic, "DSPAVL1", 8);
+	header.keySize = sizeof(Key);
+	header.valueSize = sizeof(Value);
+	header.nodeSize = sizeof(ImageNode);
+	header.root = this->root ? 0 : imageNil;
+	char padding[imageNodesOffset] = {};
+	out.write(padding, imageNodesOffset);
+
+	while (!level.empty()) {
+		next.clear();
+		for (const AVLNode* node : level) {
+			ImageNode image;
+			std::memset(&image, 0, sizeof(image));
+			image.key = node->key;
+			image.value = node->value;
+			image.height = node->height;
+			image.left = node->left ? numbered++ : imageNil;
+			image.right = node->right ? numbered++ : imageNil;
+			if (node->left) {
+				next.push_back(node->left);
+			}
+			if (node->right) {
+				next.push_back(node->right);
+			}
+
+			buffer.push_back(image);
+			if (buffer.size() == buffer.capacity()) {
+				out.write((const char*)buffer.data(), buffer.size() * sizeof(ImageNode));
+				buffer.clear();
+			}
+			count++;
+		}
+		level.swap(next);
+	}
+	out.write((const char*)buffer.data(), buffer.size() * sizeof(ImageNode));
+
+	//the header is written last, so an interrupted write leaves no valid image
+	header.count = count;
+	out.seekp(0);
+	out.write((const char*)&header, sizeof(header));
+	out.close();
+
+	return !out.fail();
+}
+
+template<typename Key, typename Value>
+typename AVL<Key, Value>::Mapped AVL<Key, Value>::mapFrom(const std::string& path) {
+	Mapped mapped;
+	mapped.open(path);
+
+	return mapped;
+}
+
+template<typename Key, typename Value>
+AVL<Key, Value>::Mapped::Mapped() :
+	nodes(nullptr),
+	root(imageNil),
+	count(0) {}
+
+template<typename Key, typename Value>
+AVL<Key, Value>::Mapped::Mapped(Mapped&& other) noexcept :
+	Mapped()
+{
+	*this = std::move(other);
+}
+
+template<typename Key, typename Value>
+typename AVL<Key, Value>::Mapped& AVL<Key, Value>::Mapped::operator=(Mapped&& other) noexcept {
+	if (this != &other) {
+		//the nodes point into the mapping, which the source no longer owns
+		this->file = std::move(other.file);
+		this->nodes = other.nodes;
+		this->root = other.root;
+		this->count = other.count;
+		other.nodes = nullptr;
+		other.root = imageNil;
+		other.count = 0;
+	}
+
+	return *this;
+}
+
+template<typename Key, typename Value>
+bool AVL<Key, Value>::Mapped::open(const std::string& path) {
+	static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "mapFrom needs trivially copyable keys and values");
+	static_assert(imageNodesOffset >= sizeof(ImageHeader) && imageNodesOffset % alignof(ImageNode) == 0, "the nodes must follow the header aligned");
+
+	this->nodes = nullptr;
+	this->root = imageNil;
+	this->count = 0;
+	if (!this->file.open(path) || this->file.size() < imageNodesOffset) {
+		this->file.close();
+		return false;
+	}
+
+	ImageHeader header;
+	std::memcpy(&header, this->file.data(), sizeof(header));
+	bool valid = std::memcmp(header.magic, "DSPAVL1", 8) == 0
+		&& header.keySize == sizeof(Key)
+		&& header.valueSize == sizeof(Value)
+		&& header.nodeSize == sizeof(ImageNode)
+		&& header.count < imageNil
+		&& this->file.size() == imageNodesOffset + header.count * sizeof(ImageNode)
+		&& (header.count ? header.root < header.count : header.root == imageNil);
+	if (!valid) {
+		this->file.close();
+		return false;
+	}
+
+	this->nodes = (const ImageNode*)((const char*)this->file.data() + imageNodesOffset);
+	this->root = header.root;
+	this->count = header.count;
+
+	return true;
+}
+
+template<typename Key, typename Value>
+bool AVL<Key, Value>::Mapped::isOpen() const {
+	return this->nodes != nullptr;
+}
+
+template<typename Key, typename Value>
+const typename AVL<Key, Value>::ImageNode* AVL<Key, Value>::Mapped::find(const Key& key) const {
+	std::uint32_t current = this->root;
+	while (current < this->count) {
+		const ImageNode& node = this->nodes[current];
+		if (key < node.key) {
+			current = node.left;
+		} else if (key > node.key) {
+			current = node.right;
+		} else {
+			return &node;
+		}
+	}
+
+	return nullptr;
+}
+
+template<typename Key, typename Value>
+bool AVL<Key, Value>::Mapped::contains(const Key& key) const {
+	return this->find(key) != nullptr;
+}
+
+template<typename Key, typename Value>
+const Value* AVL<Key, Value>::Mapped::getValue(const Key& key) const {
+	const ImageNode* node = this->find(key);
+	if (!node) {
+		return nullptr;
+	}
+
+	return &node->value;
+}
+
+template<typename Key, typename Value>
+int AVL<Key, Value>::Mapped::nodesCount() const {
+	return (int)this->count;
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::Mapped::forEachFromNode(const std::uint32_t& index, Function& function) const {
+	if (index >= this->count) {
+		return;
+	}
+
+	const ImageNode& node = this->nodes[index];
+	this->forEachFromNode(node.left, function);
+	function(node.key, node.value);
+	this->forEachFromNode(node.right, function);
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void AVL<Key, Value>::Mapped::forEach(Function function) const {
+	this->forEachFromNode(this->root, function);
+}
+
+#ifdef AVL_STATS
+template<typename Key, typename Value>
+AVL<Key, Value>::Stats::Stats() :
+	singleRotations(0),
+	doubleRotations(0),
+	searches(0),
+	searchDepth(0),
+	updates(0),
+	rebalanceDepth(0),
+	maxRebalanceDepth(0),
+	currentRebalanceDepth(0) {}
+
+template<typename Key, typename Value>
+double AVL<Key, Value>::Stats::averageSearchDepth() const {
+	if (!this->searches) {
+		return 0;
+	}
+
+	return (double)this->searchDepth / this->searches;
+}
+
+template<typename Key, typename Value>
+double AVL<Key, Value>::Stats::averageRebalanceDepth() const {
+	if (!this->updates) {
+		return 0;
+	}
+
+	return (double)this->rebalanceDepth / this->updates;
+}
+
+template<typename Key, typename Value>
+void AVL<Key, Value>::Stats::recordRotation(const bool& isDouble) {
+	if (isDouble) {
+		this->doubleRotations++;
+	} else {
+		this->singleRotations++;
+	}
+}
+
+template<typename Key, typename Value>
+void AVL<Key, Value>::Stats::endUpdate() {
+	this->updates++;
+	this->rebalanceDepth += this->currentRebalanceDepth;
+	this->maxRebalanceDepth = std::max(this->maxRebalanceDepth, this->currentRebalanceDepth);
+	this->currentRebalanceDepth = 0;
+}
+
+template<typename Key, typename Value>
+const typename AVL<Key, Value>::Stats& AVL<Key, Value>::getStats() const {
+	return this->stats;
+}
+
+template<typename Key, typename Value>
+void AVL<Key, Value>::resetStats() {
+	this->stats = Stats{};
+}
+#endif
\ No newline at end of file
@@ -2,10 +2,26 @@
 #define AVL_H
 
 #include<vector>
+#include<string>
+#include<cstdint>
+#include "../Simd/Prefetch.h"
+#include "../Persistence/MappedFile.h"
+
+class WorkStealingPool;
+
+#ifdef AVL_STATS
+#define AVL_STATS_RECORD(statement) statement
+#else
+#define AVL_STATS_RECORD(statement)
+#endif
 
 /// <summary>
 /// A template class representing an AVL tree data structure
 /// Duplicate keys are not supported - the lastly added value for a key is taken
+/// Defining AVL_WAVL selects the weak AVL balancing policy instead: the height of a node holds its rank,
+/// the rank of a node exceeds the ranks of its children by 1 or 2 and leaves have rank 0
+/// Inserts rebalance exactly as in an AVL tree, so an insert-only tree is an AVL tree,
+/// while removes make at most two rotations and O(1) rank changes amortized
 /// </summary>
 template<typename Key, typename Value>
 class AVL
@@ -62,6 +78,22 @@ class AVL
 		/// <return>AVLNode* the root of the balanced tree or nullptr if the parameter is nullptr</return>
 		AVLNode* balanceNode(AVLNode*);
 
+		/// <summary>
+		/// Restores the balance of a node after an insert into one of its subtrees, updating its height
+		/// or rank and rotating if needed by the selected balancing policy
+		/// </summary>
+		/// <param>AVLNode* the node whose subtree changed</param>
+		/// <return>AVLNode* the root of the balanced tree</return>
+		AVLNode* rebalanceAfterInsert(AVLNode*);
+
+		/// <summary>
+		/// Restores the balance of a node after a remove from one of its subtrees, updating its height
+		/// or rank and rotating if needed by the selected balancing policy
+		/// </summary>
+		/// <param>AVLNode* the node whose subtree changed</param>
+		/// <return>AVLNode* the root of the balanced tree</return>
+		AVLNode* rebalanceAfterRemove(AVLNode*);
+
 		/// <summary>
 		/// Finds the largest node inside a tree with root the parameter
 		/// </summary>
@@ -77,6 +109,20 @@ class AVL
 		/// <return>AVLNode* the node found or nullptr otherwise</return>
 		const AVLNode* findFromNode(AVLNode* const&, const Key&) const;
 
+		/// <summary>
+		/// The number of searches advanced in lockstep by the batched lookups
+		/// </summary>
+		static constexpr unsigned int batchGroupSize = 16;
+
+		/// <summary>
+		/// Finds the nodes of many keys, advancing a group of searches by one level at a time and prefetching
+		/// the next node of every search, so that the cache misses of the group overlap
+		/// </summary>
+		/// <param>const std::vector<Key>& the keys to look for</param>
+		/// <param>Function the function called with (size_t index of the key, const AVLNode* node or nullptr) when a search ends</param>
+		template<typename Function>
+		void findBatch(const std::vector<Key>&, Function) const;
+
 		/// <summary>
 		/// Inserts a node into the tree with root the parameter
 		/// If a node with the same key exists, its value will be changed
@@ -104,6 +150,24 @@ class AVL
 		/// <return>AVLNode* the new root</return>
 		AVLNode* createTree(const std::vector<std::pair<Key, Value>>&, const int&, const int&);
 
+		/// <summary>
+		/// Creates a tree like createTree, building the two subtrees of a node in parallel on a pool
+		/// while they hold more than parallelBuildCutoff elements
+		/// </summary>
+		/// <param>const std::vector<std::pair<Key, Value>>& the sorted elements without duplicates</param>
+		/// <param>const int& start index</param>
+		/// <param>const int& end index</param>
+		/// <param>WorkStealingPool& the pool running the subtrees</param>
+		/// <return>AVLNode* the new root</return>
+		AVLNode* createTree(const std::vector<std::pair<Key, Value>>&, const int&, const int&, WorkStealingPool&);
+
+		static constexpr int parallelBuildCutoff = 4096;
+
+		/// <summary>
+		/// Sorts key-value pairs by key and drops duplicate pairs, keeping the last occurrence
+		/// </summary>
+		static std::vector<std::pair<Key, Value>> sortedElements(std::vector<std::pair<Key, Value>>&);
+
 		/// <summary>
 		/// Deletes a tree recursively, used by the destructor
 		/// </summary>
@@ -117,7 +181,127 @@ class AVL
 		/// <return>int the number of nodes inside the tree with root the parameter</return>
 		int nodesCountInternal(AVLNode* const&) const;
 
+		/// <summary>
+		/// Calls a function for all nodes of a tree in ascending order of the keys
+		/// </summary>
+		/// <param>AVLNode* const& the root of the tree to be traversed</param>
+		/// <param>Function& the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEachFromNode(AVLNode* const&, Function&) const;
+
+		/// <summary>
+		/// Calls a function for the nodes of a tree with keys in [low, high] in ascending order of the keys
+		/// A bound is dropped once an ancestor inside the range proves it for a subtree, so whole subtrees are walked without comparisons
+		/// </summary>
+		/// <param>AVLNode* const& the root of the tree to be traversed</param>
+		/// <param>const Key* const& the smallest key of the range or nullptr if the range is not bounded from below</param>
+		/// <param>const Key* const& the largest key of the range or nullptr if the range is not bounded from above</param>
+		/// <param>Function& the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEachFromNode(AVLNode* const&, const Key* const&, const Key* const&, Function&) const;
+
+		/// <summary>
+		/// Calls a function for the nodes of a tree with keys in [low, high], scanning the two subtrees of a node in parallel
+		/// on a pool while the node is at least parallelScanCutoffHeight high
+		/// The height bounds the size of a subtree within a constant factor, so the chunks scanned serially are balanced
+		/// and the pool steals the chunks of the larger subtrees when they are not
+		/// </summary>
+		/// <param>AVLNode* const& the root of the tree to be traversed</param>
+		/// <param>const Key* const& the smallest key of the range or nullptr if the range is not bounded from below</param>
+		/// <param>const Key* const& the largest key of the range or nullptr if the range is not bounded from above</param>
+		/// <param>Function& the function called with (const Key&, const Value&)</param>
+		/// <param>WorkStealingPool& the pool running the subtrees</param>
+		template<typename Function>
+		void parallelForEachFromNode(AVLNode* const&, const Key* const&, const Key* const&, Function&, WorkStealingPool&) const;
+
+		static constexpr int parallelScanCutoffHeight = 12;
+
+		/// <summary>
+		/// The header of a tree image written by saveTo, followed by the nodes starting at imageNodesOffset
+		/// </summary>
+		struct ImageHeader {
+			char magic[8];
+			std::uint32_t keySize;
+			std::uint32_t valueSize;
+			std::uint32_t nodeSize;
+			std::uint32_t root;
+			std::uint64_t count;
+		};
+
+		/// <summary>
+		/// A node of a tree image, the children are indices into the node array so the image can be mapped at any address
+		/// </summary>
+		struct ImageNode {
+			Key key;
+			Value value;
+			std::uint32_t left;
+			std::uint32_t right;
+			std::int32_t height;
+		};
+
+		static constexpr std::uint32_t imageNil = 0xffffffff;
+		static constexpr size_t imageNodesOffset = 64;
+
 		AVLNode* root;
+
+		/// <summary>
+		/// Incremented by every insert or remove, fingers compare it to detect that their path may no longer exist
+		/// </summary>
+		unsigned long long version;
+#ifdef AVL_STATS
+	public:
+		/// <summary>
+		/// Counters collected on the rebalancing and search paths, compiled in only when AVL_STATS is defined
+		/// </summary>
+		struct Stats {
+			unsigned long long singleRotations;
+			unsigned long long doubleRotations;
+			unsigned long long searches;
+			unsigned long long searchDepth;
+			unsigned long long updates;
+			unsigned long long rebalanceDepth;
+			unsigned int maxRebalanceDepth;
+			unsigned int currentRebalanceDepth;
+
+			Stats();
+
+			/// <summary>
+			/// Average number of nodes visited by contains/getValue
+			/// </summary>
+			/// <return>double the mean search depth or 0 if no search was made</return>
+			double averageSearchDepth() const;
+
+			/// <summary>
+			/// Average number of nodes per insert/remove whose height changed or which were rotated while retracing
+			/// </summary>
+			/// <return>double the mean rebalancing depth or 0 if no update was made</return>
+			double averageRebalanceDepth() const;
+
+			/// <summary>
+			/// Counts a rotation performed while rebalancing
+			/// </summary>
+			/// <param>const bool& whether a left right/right left double rotation is performed</param>
+			void recordRotation(const bool&);
+
+			/// <summary>
+			/// Closes the rebalancing depth measurement of the current insert/remove
+			/// </summary>
+			void endUpdate();
+		};
+
+		/// <summary>
+		/// Getter for the collected counters
+		/// </summary>
+		/// <return>const Stats& the counters collected since construction or the last reset</return>
+		const Stats& getStats() const;
+
+		/// <summary>
+		/// Clears all collected counters
+		/// </summary>
+		void resetStats();
+	private:
+		mutable Stats stats;
+#endif
 	public:
 		~AVL();
 		AVL();
@@ -128,7 +312,14 @@ class AVL
 		AVL(std::vector<std::pair<Key, Value>>);
 
 		/// <summary>
-		/// Getter for the height of the AVL tree
+		/// Creates a tree by a vector of key-value pairs, building the subtrees in parallel on a pool
+		/// </summary>
+		/// <param>std::vector<std::pair<Key, Value>> the key-values pairs</param>
+		/// <param>WorkStealingPool& the pool</param>
+		AVL(std::vector<std::pair<Key, Value>>, WorkStealingPool&);
+
+		/// <summary>
+		/// Getter for the height of the AVL tree, the rank of the root when AVL_WAVL is defined
 		/// </summary>
 		/// <return>int the height of the AVL tree</return>
 		int height() const;
@@ -140,7 +331,8 @@ class AVL
 		int balanceFactor() const;
 
 		/// <summary>
-		/// Checks whether the current tree is a valid AVL tree
+		/// Checks whether the current tree is a valid AVL tree with consistent stored heights,
+		/// or a valid weak AVL tree when AVL_WAVL is defined
 		/// </summary>
 		bool isAVL() const;
 		
@@ -172,6 +364,20 @@ class AVL
 		/// </summary>
 		bool contains(const Key&) const;
 
+		/// <summary>
+		/// Checks whether many keys are inside the current AVL tree, interleaving the searches to overlap their cache misses
+		/// </summary>
+		/// <param>const std::vector<Key>& the keys to look for</param>
+		/// <param>std::vector<bool>& receives whether every key was found, in the order of the keys</param>
+		void containsBatch(const std::vector<Key>&, std::vector<bool>&) const;
+
+		/// <summary>
+		/// Getter for the values of many keys, interleaving the searches to overlap their cache misses
+		/// </summary>
+		/// <param>const std::vector<Key>& the keys to look for</param>
+		/// <param>std::vector<const Value*>& receives the value of every key or nullptr, in the order of the keys</param>
+		void getValueBatch(const std::vector<Key>&, std::vector<const Value*>&) const;
+
 		/// <summary>
 		/// Removes an element from the current AVL tree by key using the removeFromNode method
 		/// </summary>
@@ -181,6 +387,219 @@ class AVL
 		/// Getter for the number of nodes in the current AVL tree
 		/// </summary>
 		int nodesCount() const;
+
+		/// <summary>
+		/// Calls a function for all key-value pairs in ascending order of the keys
+		/// </summary>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEach(Function) const;
+
+		/// <summary>
+		/// Calls a function for the key-value pairs with keys in [low, high], scanning chunks of the range in parallel on a pool
+		/// The function is called concurrently, in ascending order of the keys only within a chunk,
+		/// and may use WorkStealingPool::workerIndex() to pick a per-thread accumulator
+		/// The tree must not be modified during the scan
+		/// </summary>
+		/// <param>const Key& the smallest key of the range</param>
+		/// <param>const Key& the largest key of the range</param>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		/// <param>WorkStealingPool& the pool</param>
+		template<typename Function>
+		void parallelForEach(const Key&, const Key&, Function, WorkStealingPool&) const;
+
+		/// <summary>
+		/// Calls a function for the key-value pairs with keys in [low, high] like the pool overload, on a pool started for the call
+		/// </summary>
+		/// <param>const Key& the smallest key of the range</param>
+		/// <param>const Key& the largest key of the range</param>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		/// <param>const unsigned int& the number of threads, including the calling thread</param>
+		template<typename Function>
+		void parallelForEach(const Key&, const Key&, Function, const unsigned int&) const;
+
+		/// <summary>
+		/// A cursor remembering the path from the root to the last accessed node
+		/// A search climbs the path only until the subtree containing the key is reached and descends from there,
+		/// so sequential or monotone accesses cost amortized O(1) nodes each
+		/// Without links across the levels a search still climbs to the lowest common ancestor of the previous key and the new one,
+		/// which is the root for neighbouring keys on both sides of it, so the worst case stays O(log n)
+		/// Inserting or removing through the tree invalidates the position of its fingers - their next search starts from the root
+		/// </summary>
+		class Finger
+		{
+			private:
+				/// <summary>
+				/// A node of the path with the nearest ancestors bounding the keys of its subtree from below and above,
+				/// nullptr when the subtree is not bounded on that side
+				/// </summary>
+				struct PathEntry {
+					AVLNode* node;
+					AVLNode* low;
+					AVLNode* high;
+				};
+
+				AVL* tree;
+				std::vector<PathEntry> path;
+				unsigned long long version;
+
+				/// <summary>
+				/// Clears the path if the tree was modified since the finger last walked it
+				/// </summary>
+				void synchronize();
+
+				/// <summary>
+				/// Pushes a child of the last node of the path, with the bounds of its subtree
+				/// </summary>
+				/// <param>AVLNode* the child</param>
+				/// <param>const bool& whether the child is the left one</param>
+				void pushChild(AVLNode*, const bool&);
+
+				/// <summary>
+				/// Moves the finger to the node of a key or, if the key is missing, to the node below which it would be inserted
+				/// </summary>
+				/// <param>const Key& the key to look for</param>
+				void locate(const Key&);
+
+			public:
+				/// <summary>
+				/// Creates a finger positioned at the root of a tree
+				/// </summary>
+				/// <param>AVL& the tree, which must outlive the finger</param>
+				Finger(AVL&);
+
+				/// <summary>
+				/// Checks whether a key is inside the tree, searching from the finger
+				/// </summary>
+				bool contains(const Key&);
+
+				/// <summary>
+				/// Getter for the value of a key, searching from the finger
+				/// </summary>
+				/// <return>const Value* the value or nullptr if the key is not in the tree</return>
+				const Value* getValue(const Key&);
+
+				/// <summary>
+				/// Moves the finger to the smallest key not less than a key, used to start a range scan
+				/// </summary>
+				/// <param>const Key& the start of the range</param>
+				/// <return>bool whether such a key exists</return>
+				bool seek(const Key&);
+
+				/// <summary>
+				/// Moves the finger to the next key in ascending order
+				/// </summary>
+				/// <return>bool whether there is a next key</return>
+				bool next();
+
+				/// <summary>
+				/// Checks whether the finger is at a node - it is not after passing the last key, on an empty tree
+				/// or after the tree was modified through something else than the finger
+				/// </summary>
+				bool valid() const;
+
+				/// <summary>
+				/// Getter for the key at the finger, the finger must be valid
+				/// </summary>
+				const Key& key() const;
+
+				/// <summary>
+				/// Getter for the value at the finger, the finger must be valid
+				/// </summary>
+				const Value& value() const;
+
+				/// <summary>
+				/// Inserts a key-value pair or updates the value of an existing key, searching from the finger
+				/// Rebalancing retraces the path only while heights change, the finger stays valid and moves to the key
+				/// </summary>
+				void insert(const Key&, const Value&);
+		};
+
+		/// <summary>
+		/// Creates a finger positioned at the root of the tree
+		/// </summary>
+		Finger finger();
+
+		/// <summary>
+		/// A read-only tree image written by saveTo and memory-mapped by mapFrom
+		/// Lookups search the mapped nodes in place, so only the pages on the searched paths are read from the file
+		/// </summary>
+		class Mapped
+		{
+			private:
+				MappedFile file;
+				const ImageNode* nodes;
+				std::uint32_t root;
+				std::uint64_t count;
+
+				/// <summary>
+				/// Finds the node of a key, child indices outside the image end the search
+				/// </summary>
+				/// <return>const ImageNode* the node or nullptr</return>
+				const ImageNode* find(const Key&) const;
+
+				template<typename Function>
+				void forEachFromNode(const std::uint32_t&, Function&) const;
+
+			public:
+				Mapped();
+
+				/// <summary>
+				/// Moves a mapped image, the source is left closed
+				/// </summary>
+				Mapped(Mapped&&) noexcept;
+				Mapped& operator=(Mapped&&) noexcept;
+
+				/// <summary>
+				/// Maps an image, used by mapFrom
+				/// </summary>
+				/// <return>bool whether the file holds a valid image for the key and value types</return>
+				bool open(const std::string&);
+
+				/// <summary>
+				/// Checks whether an image is mapped
+				/// </summary>
+				bool isOpen() const;
+
+				/// <summary>
+				/// Checks whether a key is inside the image
+				/// </summary>
+				bool contains(const Key&) const;
+
+				/// <summary>
+				/// Getter for the value of a key
+				/// </summary>
+				/// <return>const Value* the value inside the mapping or nullptr if the key is not in the image</return>
+				const Value* getValue(const Key&) const;
+
+				/// <summary>
+				/// Getter for the number of nodes in the image
+				/// </summary>
+				int nodesCount() const;
+
+				/// <summary>
+				/// Calls a function for all key-value pairs in ascending order of the keys
+				/// </summary>
+				/// <param>Function the function called with (const Key&, const Value&)</param>
+				template<typename Function>
+				void forEach(Function) const;
+		};
+
+		/// <summary>
+		/// Writes the tree as an image which mapFrom can serve lookups from without rebuilding the tree
+		/// The nodes are written in breadth-first order, so the upper levels share the first pages of the file
+		/// Key and Value must be trivially copyable, the image is read back only by a build with the same types and byte order
+		/// </summary>
+		/// <param>const std::string& the path of the file</param>
+		/// <return>bool whether the file was written</return>
+		bool saveTo(const std::string&) const;
+
+		/// <summary>
+		/// Memory-maps an image written by saveTo
+		/// </summary>
+		/// <param>const std::string& the path of the file</param>
+		/// <return>Mapped the mapped image, not open if the file could not be mapped or is not a valid image</return>
+		static Mapped mapFrom(const std::string&);
 };
 
 #endif
@@ -4,6 +4,12 @@
 #include <time.h>
 #include <chrono>
 #include <iostream>
+#include <map>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 using namespace std::chrono;
 
 std::vector<std::pair<int, int>> input{ {6,6}, {4,4}, {2,2}, {1,1}, {3,3}, {6,6}, {5,5}, {6,6}, {4,4}, {6,6}, {1,1}, {7,7}, {8,8}, {9,9}, {10,10} };
@@ -107,6 +113,52 @@ TEST_CASE("AVL Remove, node that does not exist") {
 	CHECK(tree.nodesCount() == nodesCount);
 }
 
+TEST_CASE("AVL Remove, random operations") {
+	AVL<int, int> tree;
+	std::map<int, int> expected;
+	std::mt19937 generator{ 11 };
+	std::uniform_int_distribution<int> keys{ 0, 5000 };
+
+	bool valid = true;
+	for (int i = 0; i < 30000 && valid; i++) {
+		int key = keys(generator);
+		if (i % 3 == 0) {
+			tree.insert(key, i);
+			expected[key] = i;
+		} else {
+			tree.remove(key);
+			expected.erase(key);
+		}
+
+		valid = i % 1000 || tree.isAVL();
+	}
+
+	CHECK(valid);
+	CHECK(tree.isAVL());
+	CHECK(tree.nodesCount() == (int)expected.size());
+
+	bool same = true;
+	for (const std::pair<const int, int>& pair : expected) {
+		const int* value = tree.getValue(pair.first);
+		same = same && value && *value == pair.second;
+	}
+	CHECK(same);
+}
+
+#ifdef AVL_WAVL
+TEST_CASE("AVL WAVL, insert only keeps the AVL height") {
+	AVL<int, int> tree;
+	std::mt19937 generator{ 3 };
+	for (int i = 0; i < 100000; i++) {
+		tree.insert((int)(generator() >> 1), i);
+	}
+
+	//the height bound of an AVL tree with n nodes, the ranks of an insert-only tree are its heights
+	CHECK(tree.isAVL());
+	CHECK(tree.height() <= 1.45 * std::log2(tree.nodesCount() + 2));
+}
+#endif
+
 TEST_CASE("AVL Containts") {
 	AVL<int, int> tree{ input };
 	CHECK(tree.contains(1));
@@ -122,6 +174,427 @@ TEST_CASE("AVL Containts, node that does not exist") {
 	CHECK(tree.contains(893223) == false);
 }
 
+TEST_CASE("AVL ContainsBatch") {
+	AVL<int, int> tree;
+	std::vector<int> keys;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i * 3, i);
+		keys.push_back(i * 3 + i % 2);
+	}
+	keys.resize(999);
+
+	std::vector<bool> found;
+	tree.containsBatch(keys, found);
+
+	bool same = found.size() == keys.size();
+	for (size_t i = 0; i < keys.size() && same; i++) {
+		same = found[i] == tree.contains(keys[i]);
+	}
+	CHECK(same);
+
+	tree.containsBatch(std::vector<int>{}, found);
+	CHECK(found.empty());
+}
+
+TEST_CASE("AVL GetValueBatch") {
+	AVL<int, int> tree;
+	for (int i = 0; i < 100; i++) {
+		tree.insert(i, i * 10);
+	}
+
+	std::vector<const int*> values;
+	tree.getValueBatch(std::vector<int>{ 5, 500, 99, -1 }, values);
+
+	CHECK(values.size() == 4);
+	CHECK(*values[0] == 50);
+	CHECK(values[1] == nullptr);
+	CHECK(*values[2] == 990);
+	CHECK(values[3] == nullptr);
+}
+
+TEST_CASE("AVL ForEach") {
+	AVL<int, int> tree{ input };
+
+	std::vector<int> keys;
+	tree.forEach([&keys](const int& key, const int&) {
+		keys.push_back(key);
+	});
+
+	CHECK(keys == std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+}
+
+TEST_CASE("AVL ParallelForEach") {
+	//the keys are the multiples of 3 below 300000, inserted in random order so the tree is not perfectly balanced
+	std::vector<int> keys;
+	for (int i = 0; i < 100000; i++) {
+		keys.push_back(i * 3);
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937{ 29 });
+	AVL<int, int> tree;
+	for (const int& key : keys) {
+		tree.insert(key, key + 1);
+	}
+
+	WorkStealingPool pool{ 4 };
+	std::vector<std::pair<int, int>> ranges{ { 0, 299997 }, { -50, 400000 }, { 1000, 1000 }, { 1001, 1002 }, { 7, 200000 }, { 150000, 150001 }, { 500, 100 } };
+	for (const std::pair<int, int>& range : ranges) {
+		//one list per worker, no synchronization is needed inside the function
+		std::vector<std::vector<int>> visited(pool.threadsCount());
+		bool valuesMatch = true;
+		tree.parallelForEach(range.first, range.second, [&](const int& key, const int& value) {
+			visited[WorkStealingPool::workerIndex()].push_back(key);
+			if (value != key + 1) {
+				valuesMatch = false;
+			}
+		}, pool);
+
+		std::vector<int> merged;
+		for (const std::vector<int>& part : visited) {
+			merged.insert(merged.end(), part.begin(), part.end());
+		}
+		std::sort(merged.begin(), merged.end());
+
+		std::vector<int> expected;
+		tree.forEach([&](const int& key, const int&) {
+			if (range.first <= key && key <= range.second) {
+				expected.push_back(key);
+			}
+		});
+		CHECK(merged == expected);
+		CHECK(valuesMatch);
+	}
+
+	long long sum = 0;
+	tree.parallelForEach(0, 30, [&sum](const int& key, const int&) { sum += key; }, 1u);
+	CHECK(sum == 0 + 3 + 6 + 9 + 12 + 15 + 18 + 21 + 24 + 27 + 30);
+
+	AVL<int, int> empty;
+	empty.parallelForEach(0, 100, [&sum](const int&, const int&) { sum = -1; }, pool);
+	CHECK(sum != -1);
+}
+
+TEST_CASE("AVL Parallel build") {
+	std::vector<std::pair<int, int>> elements;
+	std::mt19937 generator{ 23 };
+	for (int i = 0; i < 100000; i++) {
+		int key = generator() % 80000;
+		elements.emplace_back(key, key * 3);
+	}
+
+	WorkStealingPool pool{ 4 };
+	AVL<int, int> parallel{ elements, pool };
+	AVL<int, int> serial{ elements };
+	CHECK(parallel.isAVL());
+	CHECK(parallel.height() == serial.height());
+	CHECK(parallel.nodesCount() == serial.nodesCount());
+
+	std::vector<std::pair<int, int>> parallelPairs, serialPairs;
+	parallel.forEach([&parallelPairs](const int& key, const int& value) {
+		parallelPairs.emplace_back(key, value);
+	});
+	serial.forEach([&serialPairs](const int& key, const int& value) {
+		serialPairs.emplace_back(key, value);
+	});
+	CHECK(parallelPairs == serialPairs);
+
+	AVL<int, int> small{ input, pool };
+	CHECK(small.nodesCount() == 10);
+}
+
+TEST_CASE("AVL Finger, lookups") {
+	AVL<int, int> tree;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i * 2, i);
+	}
+
+	AVL<int, int>::Finger finger = tree.finger();
+	bool same = true;
+	for (int i = -5; i < 2010 && same; i++) {
+		same = finger.contains(i) == tree.contains(i);
+	}
+	CHECK(same);
+
+	CHECK(*finger.getValue(1998) == 999);
+	CHECK(*finger.getValue(0) == 0);
+	CHECK(finger.getValue(7) == nullptr);
+}
+
+TEST_CASE("AVL Finger, range scan") {
+	AVL<int, int> tree;
+	for (int i = 0; i < 100; i++) {
+		tree.insert(i * 10, i);
+	}
+
+	AVL<int, int>::Finger finger = tree.finger();
+	std::vector<int> keys;
+	for (bool found = finger.seek(155); found && finger.key() < 300; found = finger.next()) {
+		keys.push_back(finger.key());
+	}
+	CHECK(keys == std::vector<int>{ 160, 170, 180, 190, 200, 210, 220, 230, 240, 250, 260, 270, 280, 290 });
+
+	CHECK(finger.seek(990));
+	CHECK(finger.value() == 99);
+	CHECK(finger.next() == false);
+	CHECK(finger.valid() == false);
+	CHECK(finger.seek(991) == false);
+
+	CHECK(finger.seek(-100));
+	CHECK(finger.key() == 0);
+
+	tree.insert(5, 5);
+	CHECK(finger.valid() == false);
+	CHECK(finger.seek(1));
+	CHECK(finger.key() == 5);
+}
+
+TEST_CASE("AVL Finger, insert") {
+	AVL<int, int> tree;
+	AVL<int, int>::Finger finger = tree.finger();
+	CHECK(finger.valid() == false);
+
+	//ascending keys as time-ordered data, then descending and repeated ones
+	for (int i = 0; i < 2000; i++) {
+		finger.insert(i, i);
+		CHECK(finger.key() == i);
+	}
+	for (int i = -1; i > -1000; i--) {
+		finger.insert(i, i);
+	}
+	finger.insert(500, -500);
+
+	CHECK(tree.nodesCount() == 2999);
+	CHECK(tree.isAVL());
+	CHECK(*tree.getValue(500) == -500);
+	CHECK(*tree.getValue(-999) == -999);
+
+	std::vector<int> keys;
+	tree.forEach([&keys](const int& key, const int&) {
+		keys.push_back(key);
+	});
+	CHECK(std::is_sorted(keys.begin(), keys.end()));
+}
+
+TEST_CASE("AVL Finger, random operations") {
+	AVL<int, int> tree;
+	std::map<int, int> expected;
+	AVL<int, int>::Finger finger = tree.finger();
+	std::mt19937 generator{ 7 };
+	std::uniform_int_distribution<int> keys{ 0, 3000 };
+
+	bool same = true;
+	for (int i = 0; i < 20000 && same; i++) {
+		int key = keys(generator);
+		switch (i % 4) {
+			case 0:
+				finger.insert(key, i);
+				expected[key] = i;
+				break;
+			case 1:
+				tree.remove(key);
+				expected.erase(key);
+				break;
+			case 2: {
+				const int* value = finger.getValue(key);
+				same = expected.count(key) ? value && *value == expected[key] : !value;
+				break;
+			}
+			case 3: {
+				auto lower = expected.lower_bound(key);
+				same = finger.seek(key) == (lower != expected.end()) && (lower == expected.end() || finger.key() == lower->first);
+				break;
+			}
+		}
+	}
+
+	CHECK(same);
+	CHECK(tree.isAVL());
+	CHECK(tree.nodesCount() == (int)expected.size());
+}
+
+#ifdef AVL_STATS
+TEST_CASE("AVL Stats, rotations") {
+	AVL<int, int> tree;
+	tree.insert(1, 1);
+	tree.insert(2, 2);
+	tree.insert(3, 3);//left case
+	tree.insert(10, 10);
+	tree.insert(5, 5);//right left case
+
+	const AVL<int, int>::Stats& stats = tree.getStats();
+	CHECK(stats.singleRotations == 1);
+	CHECK(stats.doubleRotations == 1);
+	CHECK(stats.updates == 5);
+	CHECK(stats.maxRebalanceDepth >= 2);
+}
+
+TEST_CASE("AVL Stats, search depth") {
+	AVL<int, int> tree{ input };
+	tree.resetStats();
+
+	CHECK(tree.contains(*tree.getRootKey()));
+	CHECK(tree.getStats().searches == 1);
+	CHECK(tree.getStats().averageSearchDepth() == 1);
+
+	CHECK(tree.contains(893223) == false);
+	CHECK(tree.getStats().searchDepth == 1 + tree.height() + 1);
+}
+
+#ifdef AVL_WAVL
+TEST_CASE("AVL Stats, WAVL rotations per remove") {
+	AVL<int, int> tree;
+	std::vector<int> keys;
+	for (int i = 0; i < 20000; i++) {
+		tree.insert(i, i);
+		keys.push_back(i);
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937{ 5 });
+	tree.resetStats();
+
+	unsigned long long maxRotations = 0;
+	for (const int& key : keys) {
+		unsigned long long before = tree.getStats().singleRotations + 2 * tree.getStats().doubleRotations;
+		tree.remove(key);
+		maxRotations = std::max(maxRotations, tree.getStats().singleRotations + 2 * tree.getStats().doubleRotations - before);
+	}
+
+	CHECK(maxRotations <= 2);
+	CHECK(tree.nodesCount() == 0);
+}
+#endif
+
+TEST_CASE("AVL Stats, finger search depth") {
+	AVL<int, int> tree;
+	for (int i = 0; i < 100000; i++) {
+		tree.insert(i, i);
+	}
+	tree.resetStats();
+
+	AVL<int, int>::Finger finger = tree.finger();
+	for (int i = 50000; i < 60000; i++) {
+		CHECK(finger.contains(i));
+	}
+
+	//consecutive keys are on average a constant number of nodes apart
+	CHECK(tree.getStats().searches == 10000);
+	CHECK(tree.getStats().averageSearchDepth() < 4);
+}
+
+TEST_CASE("AVL Stats, finger search depth alternating around the root") {
+	AVL<int, int> tree;
+	for (int i = 0; i < 100000; i++) {
+		tree.insert(i, i);
+	}
+	tree.resetStats();
+
+	//the predecessor and the successor of the root are 2 apart, but their lowest common ancestor is the root
+	int rootKey = *tree.getRootKey();
+	AVL<int, int>::Finger finger = tree.finger();
+	for (int i = 0; i < 1000; i++) {
+		CHECK(finger.contains(i % 2 ? rootKey + 1 : rootKey - 1));
+	}
+
+	CHECK(tree.getStats().searches == 1000);
+	CHECK(tree.getStats().averageSearchDepth() > tree.height() / 2);
+	CHECK(tree.getStats().averageSearchDepth() <= tree.height() + 1);
+}
+#endif
+
+TEST_CASE("AVL Image, save and map") {
+	AVL<int, double> tree;
+	for (int i = 0; i < 10000; i++) {
+		tree.insert(i * 3, i * 0.5);
+	}
+
+	const char* path = "AVLImageTest.bin";
+	REQUIRE(tree.saveTo(path));
+	{
+		AVL<int, double>::Mapped mapped = AVL<int, double>::mapFrom(path);
+		REQUIRE(mapped.isOpen());
+		CHECK(mapped.nodesCount() == 10000);
+
+		bool found = true;
+		for (int i = 0; i < 10000 && found; i++) {
+			const double* value = mapped.getValue(i * 3);
+			found = value && *value == i * 0.5 && !mapped.contains(i * 3 + 1);
+		}
+		CHECK(found);
+		CHECK(mapped.getValue(-3) == nullptr);
+
+		std::vector<int> keys;
+		mapped.forEach([&keys](const int& key, const double&) {
+			keys.push_back(key);
+		});
+		CHECK(keys.size() == 10000);
+		CHECK(std::is_sorted(keys.begin(), keys.end()));
+	}
+	std::remove(path);
+}
+
+TEST_CASE("AVL Image, moved") {
+	AVL<int, int> tree;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i, i * 2);
+	}
+	const char* path = "AVLImageTest.bin";
+	REQUIRE(tree.saveTo(path));
+
+	//the moved-from image owns no mapping, so it must not serve lookups from it
+	AVL<int, int>::Mapped mapped = AVL<int, int>::mapFrom(path);
+	AVL<int, int>::Mapped moved{ std::move(mapped) };
+	CHECK(mapped.isOpen() == false);
+	CHECK(mapped.nodesCount() == 0);
+	CHECK(mapped.getValue(10) == nullptr);
+	int visited = 0;
+	mapped.forEach([&visited](const int&, const int&) { visited++; });
+	CHECK(visited == 0);
+	REQUIRE(moved.isOpen());
+	CHECK(*moved.getValue(10) == 20);
+
+	AVL<int, int>::Mapped assigned;
+	assigned = std::move(moved);
+	CHECK(moved.isOpen() == false);
+	CHECK(moved.contains(10) == false);
+	CHECK(assigned.nodesCount() == 1000);
+	CHECK(assigned.contains(999));
+
+	assigned = AVL<int, int>::Mapped();
+	std::remove(path);
+}
+
+TEST_CASE("AVL Image, empty tree") {
+	AVL<int, int> tree;
+	const char* path = "AVLImageTest.bin";
+	REQUIRE(tree.saveTo(path));
+
+	AVL<int, int>::Mapped mapped = AVL<int, int>::mapFrom(path);
+	CHECK(mapped.isOpen());
+	CHECK(mapped.nodesCount() == 0);
+	CHECK(mapped.contains(1) == false);
+
+	mapped = AVL<int, int>::Mapped();
+	std::remove(path);
+}
+
+TEST_CASE("AVL Image, invalid files") {
+	CHECK(AVL<int, int>::mapFrom("AVLImageMissing.bin").isOpen() == false);
+
+	AVL<int, int> tree;
+	tree.insert(1, 1);
+	const char* path = "AVLImageTest.bin";
+	REQUIRE(tree.saveTo(path));
+
+	//another value type
+	CHECK(AVL<int, long long>::mapFrom(path).isOpen() == false);
+
+	//a truncated image
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::app);
+		out << "x";
+	}
+	CHECK(AVL<int, int>::mapFrom(path).isOpen() == false);
+	std::remove(path);
+}
+
 TEST_CASE("AVL Tree with 50 elements") {
 	CHECK(testAVLWithElements(50, 1, 'i') < 5);
 	CHECK(testAVLWithElements(50, 1, 'c') < 5);
@@ -0,0 +1,490 @@
+#include "BPlusTree.h"
+#include "../Simd/LowerBound.h"
+
+template<typename Key, typename Value>
+BPlusTree<Key, Value>::Node::Node(const bool& _isLeaf) :
+	isLeaf(_isLeaf),
+	count(0) {}
+
+template<typename Key, typename Value>
+BPlusTree<Key, Value>::InnerNode::InnerNode() :
+	Node(false) {}
+
+template<typename Key, typename Value>
+BPlusTree<Key, Value>::LeafNode::LeafNode() :
+	Node(true),
+	next(nullptr) {}
+
+template<typename Key, typename Value>
+BPlusTree<Key, Value>::BPlusTree() :
+	root(new LeafNode{}),
+	elementsCount(0) {}
+
+template<typename Key, typename Value>
+BPlusTree<Key, Value>::BPlusTree(std::vector<std::pair<Key, Value>> elements) :
+	root(nullptr),
+	elementsCount(0)
+{
+	std::stable_sort(elements.begin(), elements.end(), [](const std::pair<Key, Value>& x, const std::pair<Key, Value>& y) {
+		return x.first < y.first;
+	});
+
+	//Remove duplicate keys, last duplicate is taken
+	std::vector<std::pair<Key, Value>> filtered;
+	for (size_t i = 0; i < elements.size(); i++) {
+		while (i + 1 < elements.size() && !(elements[i].first < elements[i + 1].first)) {
+			i++;
+		}
+
+		filtered.push_back(elements[i]);
+	}
+
+	this->createTree(filtered);
+}
+
+template<typename Key, typename Value>
+BPlusTree<Key, Value>::~BPlusTree() {
+	this->deleteTree(this->root);
+}
+
+template<typename Key, typename Value>
+void BPlusTree<Key, Value>::deleteTree(Node* node) {
+	if (!node->isLeaf) {
+		InnerNode* inner = static_cast<InnerNode*>(node);
+		for (unsigned int i = 0; i <= inner->count; i++) {
+			this->deleteTree(inner->children[i]);
+		}
+
+		delete inner;
+		return;
+	}
+
+	delete static_cast<LeafNode*>(node);
+}
+
+template<typename Key, typename Value>
+void BPlusTree<Key, Value>::createTree(const std::vector<std::pair<Key, Value>>& elements) {
+	this->elementsCount = (unsigned int)elements.size();
+
+	//Build the leaves, distributing the pairs evenly so that no leaf is below the minimum occupancy
+	size_t leavesCount = std::max<size_t>(1, (elements.size() + leafCapacity - 1) / leafCapacity);
+	std::vector<Node*> level;
+	std::vector<Key> largestKeys;
+	LeafNode* previous = nullptr;
+	size_t position = 0;
+	for (size_t i = 0; i < leavesCount; i++) {
+		LeafNode* leaf = new LeafNode{};
+		size_t size = elements.size() / leavesCount + (i < elements.size() % leavesCount);
+		for (size_t j = 0; j < size; j++, position++) {
+			leaf->keys[j] = elements[position].first;
+			leaf->values[j] = elements[position].second;
+		}
+		leaf->count = (unsigned int)size;
+
+		if (previous) {
+			previous->next = leaf;
+		}
+		previous = leaf;
+
+		level.push_back(leaf);
+		if (size) {
+			largestKeys.push_back(leaf->keys[size - 1]);
+		}
+	}
+
+	//Build the inner levels until a single root remains
+	while (level.size() > 1) {
+		size_t parentsCount = (level.size() + innerCapacity) / (innerCapacity + 1);
+		std::vector<Node*> parents;
+		std::vector<Key> parentsLargestKeys;
+		position = 0;
+		for (size_t i = 0; i < parentsCount; i++) {
+			InnerNode* parent = new InnerNode{};
+			size_t size = level.size() / parentsCount + (i < level.size() % parentsCount);
+			for (size_t j = 0; j < size; j++, position++) {
+				parent->children[j] = level[position];
+				if (j + 1 < size) {
+					parent->keys[j] = largestKeys[position];
+				}
+			}
+			parent->count = (unsigned int)size - 1;
+
+			parents.push_back(parent);
+			parentsLargestKeys.push_back(largestKeys[position - 1]);
+		}
+
+		level.swap(parents);
+		largestKeys.swap(parentsLargestKeys);
+	}
+
+	this->root = level[0];
+}
+
+template<typename Key, typename Value>
+unsigned int BPlusTree<Key, Value>::lowerBound(const Key* keys, const unsigned int& count, const Key& key) {
+	return LowerBound<Key>::find(keys, count, key);
+}
+
+template<typename Key, typename Value>
+typename BPlusTree<Key, Value>::LeafNode* BPlusTree<Key, Value>::findLeaf(const Key& key) const {
+	Node* current = this->root;
+	while (!current->isLeaf) {
+		InnerNode* inner = static_cast<InnerNode*>(current);
+		current = inner->children[lowerBound(inner->keys, inner->count, key)];
+	}
+
+	return static_cast<LeafNode*>(current);
+}
+
+template<typename Key, typename Value>
+typename BPlusTree<Key, Value>::Node* BPlusTree<Key, Value>::insertFromNode(Node* node, const Key& key, const Value& value, Key& separator) {
+	if (node->isLeaf) {
+		LeafNode* leaf = static_cast<LeafNode*>(node);
+		unsigned int position = lowerBound(leaf->keys, leaf->count, key);
+		if (position < leaf->count && !(key < leaf->keys[position])) {
+			leaf->values[position] = value;
+			return nullptr;
+		}
+
+		this->elementsCount++;
+		LeafNode* target = leaf;
+		LeafNode* right = nullptr;
+		if (leaf->count == leafCapacity) {//split the leaf in halves and insert into the one the key belongs to
+			right = new LeafNode{};
+			unsigned int middle = leafCapacity / 2;
+			right->count = leafCapacity - middle;
+			std::move(leaf->keys + middle, leaf->keys + leafCapacity, right->keys);
+			std::move(leaf->values + middle, leaf->values + leafCapacity, right->values);
+			leaf->count = middle;
+
+			right->next = leaf->next;
+			leaf->next = right;
+
+			if (position > middle) {
+				target = right;
+				position -= middle;
+			}
+		}
+
+		std::move_backward(target->keys + position, target->keys + target->count, target->keys + target->count + 1);
+		std::move_backward(target->values + position, target->values + target->count, target->values + target->count + 1);
+		target->keys[position] = key;
+		target->values[position] = value;
+		target->count++;
+
+		if (right) {
+			separator = leaf->keys[leaf->count - 1];
+		}
+
+		return right;
+	}
+
+	InnerNode* inner = static_cast<InnerNode*>(node);
+	unsigned int position = lowerBound(inner->keys, inner->count, key);
+	Key childSeparator;
+	Node* newChild = this->insertFromNode(inner->children[position], key, value, childSeparator);
+	if (!newChild) {
+		return nullptr;
+	}
+
+	if (inner->count < innerCapacity) {
+		std::move_backward(inner->keys + position, inner->keys + inner->count, inner->keys + inner->count + 1);
+		std::move_backward(inner->children + position + 1, inner->children + inner->count + 1, inner->children + inner->count + 2);
+		inner->keys[position] = childSeparator;
+		inner->children[position + 1] = newChild;
+		inner->count++;
+
+		return nullptr;
+	}
+
+	//the node is full - lay out all keys and children and push the middle key up
+	Key keys[innerCapacity + 1];
+	Node* children[innerCapacity + 2];
+	std::move(inner->keys, inner->keys + position, keys);
+	keys[position] = childSeparator;
+	std::move(inner->keys + position, inner->keys + innerCapacity, keys + position + 1);
+	std::copy(inner->children, inner->children + position + 1, children);
+	children[position + 1] = newChild;
+	std::copy(inner->children + position + 1, inner->children + innerCapacity + 1, children + position + 2);
+
+	unsigned int middle = (innerCapacity + 1) / 2;
+	InnerNode* right = new InnerNode{};
+
+	inner->count = middle;
+	std::move(keys, keys + middle, inner->keys);
+	std::copy(children, children + middle + 1, inner->children);
+
+	right->count = innerCapacity - middle;
+	std::move(keys + middle + 1, keys + innerCapacity + 1, right->keys);
+	std::copy(children + middle + 1, children + innerCapacity + 2, right->children);
+
+	separator = keys[middle];
+	return right;
+}
+
+template<typename Key, typename Value>
+bool BPlusTree<Key, Value>::removeFromNode(Node* node, const Key& key) {
+	if (node->isLeaf) {
+		LeafNode* leaf = static_cast<LeafNode*>(node);
+		unsigned int position = lowerBound(leaf->keys, leaf->count, key);
+		if (position == leaf->count || key < leaf->keys[position]) {
+			return false;
+		}
+
+		std::move(leaf->keys + position + 1, leaf->keys + leaf->count, leaf->keys + position);
+		std::move(leaf->values + position + 1, leaf->values + leaf->count, leaf->values + position);
+		leaf->count--;
+		this->elementsCount--;
+
+		return true;
+	}
+
+	InnerNode* inner = static_cast<InnerNode*>(node);
+	unsigned int position = lowerBound(inner->keys, inner->count, key);
+	if (!this->removeFromNode(inner->children[position], key)) {
+		return false;
+	}
+
+	Node* child = inner->children[position];
+	if (child->count < (child->isLeaf ? leafCapacity / 2 : innerCapacity / 2)) {
+		this->rebalanceChild(inner, position);
+	}
+
+	return true;
+}
+
+template<typename Key, typename Value>
+void BPlusTree<Key, Value>::rebalanceChild(InnerNode* parent, const unsigned int& index) {
+	Node* child = parent->children[index];
+	Node* left = index > 0 ? parent->children[index - 1] : nullptr;
+	Node* right = index < parent->count ? parent->children[index + 1] : nullptr;
+	unsigned int minimum = child->isLeaf ? leafCapacity / 2 : innerCapacity / 2;
+
+	if (left && left->count > minimum) {//borrow the last element of the left sibling
+		if (child->isLeaf) {
+			LeafNode* leaf = static_cast<LeafNode*>(child);
+			LeafNode* sibling = static_cast<LeafNode*>(left);
+			std::move_backward(leaf->keys, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+			std::move_backward(leaf->values, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+			leaf->keys[0] = sibling->keys[sibling->count - 1];
+			leaf->values[0] = sibling->values[sibling->count - 1];
+			sibling->count--;
+			parent->keys[index - 1] = sibling->keys[sibling->count - 1];
+		} else {
+			InnerNode* inner = static_cast<InnerNode*>(child);
+			InnerNode* sibling = static_cast<InnerNode*>(left);
+			std::move_backward(inner->keys, inner->keys + inner->count, inner->keys + inner->count + 1);
+			std::move_backward(inner->children, inner->children + inner->count + 1, inner->children + inner->count + 2);
+			inner->keys[0] = parent->keys[index - 1];
+			inner->children[0] = sibling->children[sibling->count];
+			parent->keys[index - 1] = sibling->keys[sibling->count - 1];
+			sibling->count--;
+		}
+
+		child->count++;
+	} else if (right && right->count > minimum) {//borrow the first element of the right sibling
+		if (child->isLeaf) {
+			LeafNode* leaf = static_cast<LeafNode*>(child);
+			LeafNode* sibling = static_cast<LeafNode*>(right);
+			leaf->keys[leaf->count] = sibling->keys[0];
+			leaf->values[leaf->count] = sibling->values[0];
+			std::move(sibling->keys + 1, sibling->keys + sibling->count, sibling->keys);
+			std::move(sibling->values + 1, sibling->values + sibling->count, sibling->values);
+			parent->keys[index] = leaf->keys[leaf->count];
+		} else {
+			InnerNode* inner = static_cast<InnerNode*>(child);
+			InnerNode* sibling = static_cast<InnerNode*>(right);
+			inner->keys[inner->count] = parent->keys[index];
+			inner->children[inner->count + 1] = sibling->children[0];
+			parent->keys[index] = sibling->keys[0];
+			std::move(sibling->keys + 1, sibling->keys + sibling->count, sibling->keys);
+			std::move(sibling->children + 1, sibling->children + sibling->count + 1, sibling->children);
+		}
+
+		child->count++;
+		right->count--;
+	} else if (left) {
+		this->mergeChildren(parent, index - 1);
+	} else {
+		this->mergeChildren(parent, index);
+	}
+}
+
+template<typename Key, typename Value>
+void BPlusTree<Key, Value>::mergeChildren(InnerNode* parent, const unsigned int& index) {
+	Node* left = parent->children[index];
+	Node* right = parent->children[index + 1];
+
+	if (left->isLeaf) {
+		LeafNode* leaf = static_cast<LeafNode*>(left);
+		LeafNode* sibling = static_cast<LeafNode*>(right);
+		std::move(sibling->keys, sibling->keys + sibling->count, leaf->keys + leaf->count);
+		std::move(sibling->values, sibling->values + sibling->count, leaf->values + leaf->count);
+		leaf->count += sibling->count;
+		leaf->next = sibling->next;
+
+		delete sibling;
+	} else {
+		InnerNode* inner = static_cast<InnerNode*>(left);
+		InnerNode* sibling = static_cast<InnerNode*>(right);
+		inner->keys[inner->count] = parent->keys[index];
+		std::move(sibling->keys, sibling->keys + sibling->count, inner->keys + inner->count + 1);
+		std::copy(sibling->children, sibling->children + sibling->count + 1, inner->children + inner->count + 1);
+		inner->count += sibling->count + 1;
+
+		delete sibling;
+	}
+
+	std::move(parent->keys + index + 1, parent->keys + parent->count, parent->keys + index);
+	std::move(parent->children + index + 2, parent->children + parent->count + 1, parent->children + index + 1);
+	parent->count--;
+}
+
+template<typename Key, typename Value>
+void BPlusTree<Key, Value>::insert(const Key& key, const Value& value) {
+	Key separator;
+	Node* right = this->insertFromNode(this->root, key, value, separator);
+	if (!right) {
+		return;
+	}
+
+	//the root was split, the tree grows by a level
+	InnerNode* newRoot = new InnerNode{};
+	newRoot->count = 1;
+	newRoot->keys[0] = separator;
+	newRoot->children[0] = this->root;
+	newRoot->children[1] = right;
+	this->root = newRoot;
+}
+
+template<typename Key, typename Value>
+void BPlusTree<Key, Value>::remove(const Key& key) {
+	this->removeFromNode(this->root, key);
+
+	//the root lost its last separator, the tree shrinks by a level
+	if (!this->root->isLeaf && this->root->count == 0) {
+		InnerNode* oldRoot = static_cast<InnerNode*>(this->root);
+		this->root = oldRoot->children[0];
+		delete oldRoot;
+	}
+}
+
+template<typename Key, typename Value>
+const Value* BPlusTree<Key, Value>::getValue(const Key& key) const {
+	LeafNode* leaf = this->findLeaf(key);
+	unsigned int position = lowerBound(leaf->keys, leaf->count, key);
+	if (position == leaf->count || key < leaf->keys[position]) {
+		return nullptr;
+	}
+
+	return &leaf->values[position];
+}
+
+template<typename Key, typename Value>
+bool BPlusTree<Key, Value>::contains(const Key& key) const {
+	return this->getValue(key) != nullptr;
+}
+
+template<typename Key, typename Value>
+unsigned int BPlusTree<Key, Value>::numberOfElements() const {
+	return this->elementsCount;
+}
+
+template<typename Key, typename Value>
+int BPlusTree<Key, Value>::height() const {
+	int result = 0;
+	for (Node* current = this->root; !current->isLeaf; current = static_cast<InnerNode*>(current)->children[0]) {
+		result++;
+	}
+
+	return result;
+}
+
+template<typename Key, typename Value>
+bool BPlusTree<Key, Value>::isValid() const {
+	if (!this->isValidInternal(this->root, nullptr, nullptr, this->height(), 0)) {
+		return false;
+	}
+
+	//the leaves must be linked in ascending order and hold all elements
+	Node* current = this->root;
+	while (!current->isLeaf) {
+		current = static_cast<InnerNode*>(current)->children[0];
+	}
+
+	unsigned int count = 0;
+	const Key* previous = nullptr;
+	for (LeafNode* leaf = static_cast<LeafNode*>(current); leaf; leaf = leaf->next) {
+		for (unsigned int i = 0; i < leaf->count; i++) {
+			if (previous && !(*previous < leaf->keys[i])) {
+				return false;
+			}
+
+			previous = &leaf->keys[i];
+			count++;
+		}
+	}
+
+	return count == this->elementsCount;
+}
+
+template<typename Key, typename Value>
+bool BPlusTree<Key, Value>::isValidInternal(const Node* node, const Key* lower, const Key* upper, const int& leafDepth, const int& depth) const {
+	if (node != this->root && node->count < (node->isLeaf ? leafCapacity / 2 : innerCapacity / 2)) {
+		return false;
+	}
+
+	if (node->isLeaf) {
+		const LeafNode* leaf = static_cast<const LeafNode*>(node);
+		if (depth != leafDepth) {
+			return false;
+		}
+
+		for (unsigned int i = 0; i < leaf->count; i++) {
+			if ((lower && !(*lower < leaf->keys[i])) || (upper && *upper < leaf->keys[i])) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	const InnerNode* inner = static_cast<const InnerNode*>(node);
+	if (inner->count == 0) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i <= inner->count; i++) {
+		const Key* childLower = i > 0 ? &inner->keys[i - 1] : lower;
+		const Key* childUpper = i < inner->count ? &inner->keys[i] : upper;
+		if (i > 0 && i < inner->count && !(inner->keys[i - 1] < inner->keys[i])) {
+			return false;
+		}
+
+		if (!this->isValidInternal(inner->children[i], childLower, childUpper, leafDepth, depth + 1)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void BPlusTree<Key, Value>::forEach(const Key& from, const Key& to, Function function) const {
+	LeafNode* leaf = this->findLeaf(from);
+	unsigned int position = lowerBound(leaf->keys, leaf->count, from);
+
+	while (leaf) {
+		for (; position < leaf->count; position++) {
+			if (to < leaf->keys[position]) {
+				return;
+			}
+
+			function(leaf->keys[position], leaf->values[position]);
+		}
+
+		leaf = leaf->next;
+		position = 0;
+	}
+}
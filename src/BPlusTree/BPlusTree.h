@@ -0,0 +1,187 @@
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include<vector>
+#include<algorithm>
+
+/// <summary>
+/// A template class representing a B+ tree data structure with the interface of the AVL tree
+/// Inner nodes hold separator keys filling two cache lines plus their child pointers, the values are kept in linked leaves
+/// Duplicate keys are not supported - the lastly added value for a key is taken
+/// </summary>
+template<typename Key, typename Value>
+class BPlusTree
+{
+	private:
+		static constexpr unsigned int cacheLineSize = 64;
+
+		struct Node {
+			bool isLeaf;
+			unsigned int count;
+
+			Node(const bool&);
+		};
+
+		/// <summary>
+		/// The number of separator keys of an inner node - the keys fill two cache lines
+		/// </summary>
+		static constexpr unsigned int innerCapacity = std::max<unsigned int>(4, (2 * cacheLineSize - sizeof(Node)) / sizeof(Key));
+
+		/// <summary>
+		/// The number of key-value pairs of a leaf - the leaf fills about four cache lines
+		/// </summary>
+		static constexpr unsigned int leafCapacity = std::max<unsigned int>(4, (4 * cacheLineSize - sizeof(Node) - sizeof(void*)) / (sizeof(Key) + sizeof(Value)));
+
+		/// <summary>
+		/// The keys of child i are greater than keys[i - 1] and less than or equal to keys[i]
+		/// </summary>
+		struct alignas(cacheLineSize) InnerNode : Node {
+			Key keys[innerCapacity];
+			Node* children[innerCapacity + 1];
+
+			InnerNode();
+		};
+
+		struct alignas(cacheLineSize) LeafNode : Node {
+			Key keys[leafCapacity];
+			Value values[leafCapacity];
+			LeafNode* next;
+
+			LeafNode();
+		};
+
+		/// <summary>
+		/// Finds the position of the first key which is not less than the searched key
+		/// Integer and float keys are compared a vector at a time by the SIMD kernels
+		/// </summary>
+		/// <param>const Key* the sorted keys of a node</param>
+		/// <param>const unsigned int& the number of keys</param>
+		/// <param>const Key& the key to look for</param>
+		/// <return>unsigned int the number of keys less than the searched key</return>
+		static unsigned int lowerBound(const Key*, const unsigned int&, const Key&);
+
+		/// <summary>
+		/// Finds the leaf which would contain a key
+		/// </summary>
+		/// <param>const Key& the key to look for</param>
+		/// <return>LeafNode* the leaf</return>
+		LeafNode* findLeaf(const Key&) const;
+
+		/// <summary>
+		/// Inserts a key-value pair into the subtree with root the parameter, splitting the full nodes on the way back
+		/// If a pair with the same key exists, its value will be changed
+		/// </summary>
+		/// <param>Node* the root of the subtree</param>
+		/// <param>const Key& the key to insert</param>
+		/// <param>const Value& the new value</param>
+		/// <param>Key& receives the largest key of the node if it was split</param>
+		/// <return>Node* the new right sibling if the node was split or nullptr otherwise</return>
+		Node* insertFromNode(Node*, const Key&, const Value&, Key&);
+
+		/// <summary>
+		/// Removes a key from the subtree with root the parameter, fixing the underflowing children on the way back
+		/// </summary>
+		/// <param>Node* the root of the subtree</param>
+		/// <param>const Key& the key to remove</param>
+		/// <return>bool whether the key was found</return>
+		bool removeFromNode(Node*, const Key&);
+
+		/// <summary>
+		/// Restores the minimum occupancy of a child by borrowing from a sibling or merging with it
+		/// </summary>
+		/// <param>InnerNode* the parent</param>
+		/// <param>const unsigned int& the index of the underflowing child</param>
+		void rebalanceChild(InnerNode*, const unsigned int&);
+
+		/// <summary>
+		/// Merges the child at index + 1 into the child at index and removes their separator from the parent
+		/// </summary>
+		/// <param>InnerNode* the parent</param>
+		/// <param>const unsigned int& the index of the left child</param>
+		void mergeChildren(InnerNode*, const unsigned int&);
+
+		/// <summary>
+		/// Creates the tree bottom-up from sorted pairs with unique keys
+		/// </summary>
+		/// <param>const std::vector<std::pair<Key, Value>>& the sorted pairs</param>
+		void createTree(const std::vector<std::pair<Key, Value>>&);
+
+		/// <summary>
+		/// Checks the order, the occupancy and the depth of the subtree with root the parameter
+		/// </summary>
+		/// <param>const Node* the root of the subtree</param>
+		/// <param>const Key* the key all keys should be greater than or nullptr</param>
+		/// <param>const Key* the key all keys should be less than or equal to or nullptr</param>
+		/// <param>const int& the expected depth of the leaves</param>
+		/// <param>const int& the depth of the node</param>
+		bool isValidInternal(const Node*, const Key*, const Key*, const int&, const int&) const;
+
+		/// <summary>
+		/// Deletes a tree recursively, used by the destructor
+		/// </summary>
+		/// <param>Node* the root of the tree to be deleted</param>
+		void deleteTree(Node*);
+
+		Node* root;
+		unsigned int elementsCount;
+	public:
+		~BPlusTree();
+		BPlusTree();
+		BPlusTree(const BPlusTree&) = delete;
+		BPlusTree& operator=(const BPlusTree&) = delete;
+
+		/// <summary>
+		/// Creates a tree by a vector of key-value pairs, the last pair of a key is taken
+		/// </summary>
+		/// <param>std::vector<std::pair<Key, Value>> the key-values pairs</param>
+		BPlusTree(std::vector<std::pair<Key, Value>>);
+
+		/// <summary>
+		/// Getter for the height of the tree, a tree consisting of a single leaf has height 0
+		/// </summary>
+		/// <return>int the height of the tree</return>
+		int height() const;
+
+		/// <summary>
+		/// Checks whether the current tree is a valid B+ tree - ordered keys, minimum occupancy of the nodes,
+		/// leaves at the same depth and linked in order
+		/// </summary>
+		bool isValid() const;
+
+		/// <summary>
+		/// Inserts a key-value pair or updates the value of an existing key
+		/// </summary>
+		void insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Getter for the value of a key
+		/// </summary>
+		/// <return>const Value* the value or nullptr if the key is not in the tree</return>
+		const Value* getValue(const Key&) const;
+
+		/// <summary>
+		/// Checks whether a key is inside the tree
+		/// </summary>
+		bool contains(const Key&) const;
+
+		/// <summary>
+		/// Removes a key from the tree
+		/// </summary>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Getter for the number of key-value pairs in the tree
+		/// </summary>
+		unsigned int numberOfElements() const;
+
+		/// <summary>
+		/// Calls a function for the pairs with keys in [from, to] in ascending order by walking the linked leaves
+		/// </summary>
+		/// <param>const Key& the smallest key of the range</param>
+		/// <param>const Key& the largest key of the range</param>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEach(const Key&, const Key&, Function) const;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "src/Doctest/doctest.h"
+#include "src/BPlusTree/BPlusTree.cpp"
+#include <map>
+#include <random>
+
+TEST_CASE("BPlusTree Insert") {
+	BPlusTree<int, int> tree;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i, i * 2);
+	}
+
+	CHECK(tree.numberOfElements() == 1000);
+	CHECK(tree.height() > 0);
+	CHECK(*tree.getValue(500) == 1000);
+	CHECK(tree.isValid());
+}
+
+TEST_CASE("BPlusTree Insert, duplicate key") {
+	BPlusTree<int, int> tree;
+	tree.insert(8, 8);
+	tree.insert(8, 9);
+
+	CHECK(tree.numberOfElements() == 1);
+	CHECK(*tree.getValue(8) == 9);
+	CHECK(tree.isValid());
+}
+
+TEST_CASE("BPlusTree Insert, descending keys") {
+	BPlusTree<int, int> tree;
+	for (int i = 1000; i > 0; i--) {
+		tree.insert(i, i);
+	}
+
+	CHECK(tree.numberOfElements() == 1000);
+	CHECK(tree.isValid());
+}
+
+TEST_CASE("BPlusTree Bulk constructor") {
+	std::vector<std::pair<int, int>> elements;
+	for (int i = 0; i < 5000; i++) {
+		elements.push_back({ (i * 7919) % 5000, i });
+	}
+	elements.push_back({ 42, -1 });
+
+	BPlusTree<int, int> tree{ elements };
+	CHECK(tree.numberOfElements() == 5000);
+	CHECK(*tree.getValue(42) == -1);
+	CHECK(tree.isValid());
+}
+
+TEST_CASE("BPlusTree Bulk constructor, empty vector") {
+	BPlusTree<int, int> tree{ std::vector<std::pair<int, int>>{} };
+	CHECK(tree.numberOfElements() == 0);
+	CHECK(tree.contains(1) == false);
+
+	tree.insert(1, 1);
+	CHECK(tree.contains(1));
+}
+
+TEST_CASE("BPlusTree Remove") {
+	BPlusTree<int, int> tree;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i, i);
+	}
+	for (int i = 0; i < 1000; i += 3) {
+		tree.remove(i);
+	}
+
+	CHECK(tree.numberOfElements() == 666);
+	CHECK(tree.contains(3) == false);
+	CHECK(tree.contains(4));
+	CHECK(tree.isValid());
+}
+
+TEST_CASE("BPlusTree Remove, all keys") {
+	BPlusTree<int, int> tree;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i, i);
+	}
+	for (int i = 0; i < 1000; i++) {
+		tree.remove(i);
+	}
+
+	CHECK(tree.numberOfElements() == 0);
+	CHECK(tree.height() == 0);
+	CHECK(tree.isValid());
+}
+
+TEST_CASE("BPlusTree Remove, key that does not exist") {
+	BPlusTree<int, int> tree;
+	tree.insert(1, 1);
+	tree.remove(143);
+
+	CHECK(tree.numberOfElements() == 1);
+}
+
+TEST_CASE("BPlusTree Contains, empty tree") {
+	BPlusTree<int, int> tree;
+	CHECK(tree.contains(1) == false);
+	CHECK(tree.getValue(1) == nullptr);
+}
+
+TEST_CASE("BPlusTree Random operations") {
+	BPlusTree<int, int> tree;
+	std::map<int, int> expected;
+	std::mt19937 generator{ 7 };
+	std::uniform_int_distribution<int> keys{ 0, 20000 };
+
+	for (int i = 0; i < 100000; i++) {
+		int key = keys(generator);
+		if (generator() % 3 == 0) {
+			tree.remove(key);
+			expected.erase(key);
+		} else {
+			tree.insert(key, i);
+			expected[key] = i;
+		}
+	}
+
+	CHECK(tree.isValid());
+	CHECK(tree.numberOfElements() == expected.size());
+
+	bool same = true;
+	for (const std::pair<const int, int>& element : expected) {
+		const int* value = tree.getValue(element.first);
+		same = same && value && *value == element.second;
+	}
+	CHECK(same);
+}
+
+TEST_CASE("BPlusTree ForEach") {
+	BPlusTree<int, int> tree;
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i * 2, i);
+	}
+
+	std::vector<int> keys;
+	tree.forEach(101, 200, [&keys](const int& key, const int&) {
+		keys.push_back(key);
+	});
+
+	CHECK(keys.size() == 50);
+	CHECK(keys.front() == 102);
+	CHECK(keys.back() == 200);
+}
+
+TEST_CASE("BPlusTree String keys") {
+	BPlusTree<std::string, int> tree;
+	for (int i = 0; i < 500; i++) {
+		tree.insert(std::to_string(i), i);
+	}
+	tree.remove("250");
+
+	CHECK(tree.numberOfElements() == 499);
+	CHECK(*tree.getValue("42") == 42);
+	CHECK(tree.contains("250") == false);
+	CHECK(tree.isValid());
+}
@@ -0,0 +1,153 @@
+#include "BatchExecutor.h"
+#include <functional>
+
+template<typename Key, typename Value, typename Structure>
+Structure* BatchExecutor<Key, Value, Structure>::createStructure(const unsigned int& expectedElements, std::true_type) {
+	return new Structure{ expectedElements };
+}
+
+template<typename Key, typename Value, typename Structure>
+Structure* BatchExecutor<Key, Value, Structure>::createStructure(const unsigned int&, std::false_type) {
+	return new Structure{};
+}
+
+template<typename Key, typename Value, typename Structure>
+BatchExecutor<Key, Value, Structure>::BatchExecutor(const unsigned int& workersCount, const unsigned int& expectedElements) :
+	partitions(workersCount > 0 ? workersCount : 1),
+	generation(0),
+	running(0),
+	stopping(false),
+	batch(nullptr),
+	results(nullptr)
+{
+	unsigned int partitionElements = expectedElements / (unsigned int)this->partitions.size() + 1;
+	for (Partition& partition : this->partitions) {
+		partition.structure = createStructure(partitionElements, std::is_constructible<Structure, const unsigned int&>{});
+		partition.count = 0;
+	}
+
+	for (size_t i = 0; i < this->partitions.size(); i++) {
+		this->workers.emplace_back(&BatchExecutor::work, this, i);
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+BatchExecutor<Key, Value, Structure>::~BatchExecutor() {
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stopping = true;
+	}
+	this->started.notify_all();
+
+	for (std::thread& worker : this->workers) {
+		worker.join();
+	}
+	for (Partition& partition : this->partitions) {
+		delete partition.structure;
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+size_t BatchExecutor<Key, Value, Structure>::partitionOf(const Key& key) const {
+	std::uint64_t h = (std::uint64_t)std::hash<Key>{}(key);
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+
+	return (size_t)(h % this->partitions.size());
+}
+
+template<typename Key, typename Value, typename Structure>
+void BatchExecutor<Key, Value, Structure>::executePartition(Partition& partition) {
+	const std::vector<Operation>& operations = *this->batch;
+	std::vector<Result>& output = *this->results;
+
+	//the workers write disjoint results
+	for (const size_t& index : partition.operations) {
+		const Operation& operation = operations[index];
+		Result& result = output[index];
+
+		if (operation.type == OperationType::Lookup) {
+			const Value* value = partition.structure->getValue(operation.key);
+			result.found = value != nullptr;
+			if (value) {
+				result.value = *value;
+			}
+		} else {
+			result.found = partition.structure->contains(operation.key);
+			if (operation.type == OperationType::Insert) {
+				partition.structure->insert(operation.key, operation.value);
+				partition.count += !result.found;
+			} else if (result.found) {
+				partition.structure->remove(operation.key);
+				partition.count--;
+			}
+		}
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+void BatchExecutor<Key, Value, Structure>::work(const size_t& index) {
+	Partition& partition = this->partitions[index];
+	std::uint64_t seen = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->started.wait(lock, [this, &seen]() { return this->stopping || this->generation != seen; });
+			if (this->stopping) {
+				return;
+			}
+			seen = this->generation;
+		}
+
+		this->executePartition(partition);
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		if (--this->running == 0) {
+			this->finished.notify_one();
+		}
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+void BatchExecutor<Key, Value, Structure>::execute(const std::vector<Operation>& operations, std::vector<Result>& output) {
+	output.resize(operations.size());
+	for (Partition& partition : this->partitions) {
+		partition.operations.clear();
+	}
+	for (size_t i = 0; i < operations.size(); i++) {
+		this->partitions[this->partitionOf(operations[i].key)].operations.push_back(i);
+	}
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+	this->batch = &operations;
+	this->results = &output;
+	this->running = (unsigned int)this->partitions.size();
+	this->generation++;
+	this->started.notify_all();
+
+	this->finished.wait(lock, [this]() { return this->running == 0; });
+	this->batch = nullptr;
+	this->results = nullptr;
+}
+
+template<typename Key, typename Value, typename Structure>
+size_t BatchExecutor<Key, Value, Structure>::pairsCount() const {
+	size_t count = 0;
+	for (const Partition& partition : this->partitions) {
+		count += partition.count;
+	}
+
+	return count;
+}
+
+template<typename Key, typename Value, typename Structure>
+std::vector<size_t> BatchExecutor<Key, Value, Structure>::partitionSizes() const {
+	std::vector<size_t> sizes;
+	for (const Partition& partition : this->partitions) {
+		sizes.push_back(partition.count);
+	}
+
+	return sizes;
+}
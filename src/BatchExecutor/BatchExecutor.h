@@ -0,0 +1,119 @@
+#ifndef BATCHEXECUTOR_H
+#define BATCHEXECUTOR_H
+
+#include<vector>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<type_traits>
+#include<cstdint>
+#include<cstddef>
+
+/// <summary>
+/// A template class executing batches of mixed inserts, removes and lookups on a map hash-partitioned across
+/// worker threads, every worker owning the Structure of its partition
+/// A batch is split by the hashes of its keys and every worker runs its operations in batch order without locks,
+/// so the operations on one key keep their order and the only synchronization is one handoff per batch
+/// The results are written in the order of the operations
+/// Structure provides the insert/getValue/contains/remove interface, e.g. AVL or SkipList
+/// Batches are submitted by one thread at a time
+/// </summary>
+template<typename Key, typename Value, typename Structure>
+class BatchExecutor
+{
+	public:
+		enum class OperationType : unsigned char {
+			Insert,
+			Remove,
+			Lookup
+		};
+
+		struct Operation {
+			OperationType type;
+			Key key;
+			Value value;
+		};
+
+		/// <summary>
+		/// The result of an operation: whether the key was present before it and, for a lookup, its value
+		/// </summary>
+		struct Result {
+			bool found;
+			Value value;
+		};
+
+	private:
+		/// <summary>
+		/// The state of a worker, on its own cache lines as every worker writes it during a batch
+		/// </summary>
+		struct alignas(64) Partition {
+			Structure* structure;
+			size_t count;
+			std::vector<size_t> operations;
+		};
+
+		static Structure* createStructure(const unsigned int&, std::true_type);
+		static Structure* createStructure(const unsigned int&, std::false_type);
+
+		std::vector<Partition> partitions;
+		std::vector<std::thread> workers;
+
+		std::mutex mutex;
+		std::condition_variable started;
+		std::condition_variable finished;
+		std::uint64_t generation;
+		unsigned int running;
+		bool stopping;
+		const std::vector<Operation>* batch;
+		std::vector<Result>* results;
+
+		/// <summary>
+		/// Finds the partition of a key by a mixed std::hash
+		/// </summary>
+		size_t partitionOf(const Key&) const;
+
+		/// <summary>
+		/// Runs the operations of a partition in batch order
+		/// </summary>
+		void executePartition(Partition&);
+
+		/// <summary>
+		/// The loop of a worker thread, waiting for batches
+		/// </summary>
+		void work(const size_t&);
+
+	public:
+		/// <summary>
+		/// Creates an empty map and starts its workers
+		/// </summary>
+		/// <param>const unsigned int& the number of workers and partitions</param>
+		/// <param>const unsigned int& the expected number of elements, divided between the partitions of the structures taking it (SkipList)</param>
+		BatchExecutor(const unsigned int&, const unsigned int& = 1 << 16);
+
+		BatchExecutor(const BatchExecutor&) = delete;
+		BatchExecutor& operator=(const BatchExecutor&) = delete;
+
+		/// <summary>
+		/// Stops the workers and frees the partitions
+		/// </summary>
+		~BatchExecutor();
+
+		/// <summary>
+		/// Executes a batch, returning when all of its operations are done
+		/// </summary>
+		/// <param>const std::vector<Operation>& the operations</param>
+		/// <param>std::vector<Result>& receives the result of every operation, in the order of the operations</param>
+		void execute(const std::vector<Operation>&, std::vector<Result>&);
+
+		/// <summary>
+		/// Getter for the number of pairs in the map
+		/// </summary>
+		size_t pairsCount() const;
+
+		/// <summary>
+		/// Getter for the number of pairs in every partition
+		/// </summary>
+		std::vector<size_t> partitionSizes() const;
+};
+
+#endif
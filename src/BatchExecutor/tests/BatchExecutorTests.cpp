@@ -0,0 +1,71 @@
+#include "src/Doctest/doctest.h"
+#include "src/BatchExecutor/BatchExecutor.cpp"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include <map>
+#include <vector>
+#include <random>
+
+template<typename Structure>
+void checkBatchesAgainstMap(const unsigned int& workersCount) {
+	typedef BatchExecutor<int, int, Structure> Executor;
+	Executor executor{ workersCount, 10000 };
+	std::map<int, int> expected;
+	std::mt19937 generator{ workersCount };
+
+	for (int round = 0; round < 20; round++) {
+		std::vector<typename Executor::Operation> batch;
+		std::vector<typename Executor::Result> expectedResults;
+		for (int i = 0; i < 2000; i++) {
+			//a small key space, so a batch holds several operations on the same key
+			int key = generator() % 3000;
+			unsigned int kind = generator() % 10;
+			auto it = expected.find(key);
+			typename Executor::Result result{ it != expected.end(), it != expected.end() ? it->second : 0 };
+			if (kind < 4) {
+				batch.push_back({ Executor::OperationType::Insert, key, round * 10000 + i });
+				expected[key] = round * 10000 + i;
+			} else if (kind < 6) {
+				batch.push_back({ Executor::OperationType::Remove, key, 0 });
+				expected.erase(key);
+			} else {
+				batch.push_back({ Executor::OperationType::Lookup, key, 0 });
+			}
+			expectedResults.push_back(result);
+		}
+
+		std::vector<typename Executor::Result> results;
+		executor.execute(batch, results);
+		REQUIRE(results.size() == batch.size());
+		for (size_t i = 0; i < batch.size(); i++) {
+			REQUIRE(results[i].found == expectedResults[i].found);
+			if (batch[i].type == Executor::OperationType::Lookup && results[i].found) {
+				CHECK(results[i].value == expectedResults[i].value);
+			}
+		}
+		CHECK(executor.pairsCount() == expected.size());
+	}
+
+	std::vector<size_t> sizes = executor.partitionSizes();
+	CHECK(sizes.size() == workersCount);
+	for (const size_t& size : sizes) {
+		CHECK(size > 0);
+	}
+}
+
+TEST_CASE("BatchExecutor Results in batch order with AVL partitions") {
+	checkBatchesAgainstMap<AVL<int, int>>(1);
+	checkBatchesAgainstMap<AVL<int, int>>(4);
+}
+
+TEST_CASE("BatchExecutor Results in batch order with SkipList partitions") {
+	checkBatchesAgainstMap<SkipList<int, int>>(3);
+}
+
+TEST_CASE("BatchExecutor Empty batches") {
+	BatchExecutor<int, int, AVL<int, int>> executor{ 2 };
+	std::vector<BatchExecutor<int, int, AVL<int, int>>::Result> results(5);
+	executor.execute({}, results);
+	CHECK(results.empty());
+	CHECK(executor.pairsCount() == 0);
+}
@@ -0,0 +1,108 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/BatchExecutor/BatchExecutor.cpp"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include <chrono>
+#include <mutex>
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Runs batches of mixed operations (50% lookups, 40% inserts, 10% removes) on a map of random keys:
+/// an AVL taking a mutex for every operation, against the BatchExecutor with AVL and SkipList partitions
+/// for several numbers of workers and batch sizes
+/// Options: --elements N (default 1000000), --operations N (default 4000000), --max-workers N (default 8)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int elements = (unsigned int)parseOption(argc, argv, "--elements", 1000000);
+	unsigned int operationsCount = (unsigned int)parseOption(argc, argv, "--operations", 4000000);
+	unsigned int maxWorkers = (unsigned int)parseOption(argc, argv, "--max-workers", 8);
+
+	KeyGenerator keys{ 13 };
+	std::vector<int> present = keys.uniqueKeys(elements);
+	std::vector<int> absent = keys.uniqueKeys(elements);
+
+	typedef BatchExecutor<int, int, AVL<int, int>> AVLExecutor;
+	std::vector<AVLExecutor::Operation> operations;
+	operations.reserve(operationsCount);
+	for (unsigned int i = 0; i < operationsCount; i++) {
+		unsigned int kind = keys.engine()() % 10;
+		int key = kind < 7 ? present[keys.engine()() % elements] : absent[keys.engine()() % elements];
+		AVLExecutor::OperationType type = kind < 5 ? AVLExecutor::OperationType::Lookup : kind < 9 ? AVLExecutor::OperationType::Insert : AVLExecutor::OperationType::Remove;
+		operations.push_back({ type, key, (int)i });
+	}
+
+	std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+	std::cout << std::left << std::setw(10) << "Workers" << std::setw(10) << "Batch" << std::setw(12) << "Structure" << "operations/s" << std::endl;
+
+	auto report = [](const std::string& workers, const std::string& batch, const char* structure, const double& rate) {
+		std::cout << std::left << std::setw(10) << workers << std::setw(10) << batch << std::setw(12) << structure
+			<< std::fixed << std::setprecision(0) << rate << std::endl;
+	};
+
+	{
+		AVL<int, int> tree;
+		std::mutex mutex;
+		for (const int& key : present) {
+			tree.insert(key, key);
+		}
+
+		unsigned int found = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (const AVLExecutor::Operation& operation : operations) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (operation.type == AVLExecutor::OperationType::Lookup) {
+				found += tree.getValue(operation.key) != nullptr;
+			} else if (operation.type == AVLExecutor::OperationType::Insert) {
+				tree.insert(operation.key, operation.value);
+			} else {
+				tree.remove(operation.key);
+			}
+		}
+		report("-", "1", "AVL+lock", operationsCount / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		if (found == 0) {
+			std::cout << "no lookup found its key" << std::endl;
+		}
+	}
+
+	//fills an executor with the present keys and runs the operations in batches, returning operations per second
+	auto run = [&](auto& executor, const unsigned int& batchSize) {
+		typedef typename std::remove_reference<decltype(executor)>::type Executor;
+		std::vector<typename Executor::Operation> batch;
+		std::vector<typename Executor::Result> results;
+		for (size_t i = 0; i < present.size(); i += batchSize) {
+			batch.clear();
+			for (size_t j = i; j < std::min(present.size(), i + batchSize); j++) {
+				batch.push_back({ Executor::OperationType::Insert, present[j], present[j] });
+			}
+			executor.execute(batch, results);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < operations.size(); i += batchSize) {
+			batch.clear();
+			for (size_t j = i; j < std::min(operations.size(), i + batchSize); j++) {
+				const AVLExecutor::Operation& operation = operations[j];
+				batch.push_back({ (typename Executor::OperationType)operation.type, operation.key, operation.value });
+			}
+			executor.execute(batch, results);
+		}
+
+		return operationsCount / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	for (unsigned int workers = 1; workers <= maxWorkers; workers *= 2) {
+		for (unsigned int batchSize : { 256u, 4096u }) {
+			{
+				AVLExecutor executor{ workers, elements };
+				report(std::to_string(workers), std::to_string(batchSize), "AVL", run(executor, batchSize));
+			}
+			{
+				BatchExecutor<int, int, SkipList<int, int>> executor{ workers, elements };
+				report(std::to_string(workers), std::to_string(batchSize), "SkipList", run(executor, batchSize));
+			}
+		}
+	}
+
+	return 0;
+}
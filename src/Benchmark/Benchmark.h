@@ -0,0 +1,367 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include<vector>
+#include<string>
+#include<random>
+#include<chrono>
+#include<algorithm>
+#include<unordered_set>
+#include<cmath>
+
+/// <summary>
+/// Creates the structures measured by the benchmarks
+/// Structures are default constructed, the specializations pass the expected number of elements when needed
+/// </summary>
+template<typename Structure>
+struct StructureFactory {
+	static Structure* create(const unsigned int&) {
+		return new Structure{};
+	}
+};
+
+template<typename Key, typename Value>
+class SkipList;
+
+template<typename Key, typename Value>
+struct StructureFactory<SkipList<Key, Value>> {
+	static SkipList<Key, Value>* create(const unsigned int& expectedElements) {
+		return new SkipList<Key, Value>{ expectedElements };
+	}
+};
+
+template<typename Key, typename Value>
+class UnrolledSkipList;
+
+template<typename Key, typename Value>
+struct StructureFactory<UnrolledSkipList<Key, Value>> {
+	static UnrolledSkipList<Key, Value>* create(const unsigned int& expectedElements) {
+		return new UnrolledSkipList<Key, Value>{ expectedElements };
+	}
+};
+
+template<typename Key, typename Value>
+class CompactAVL;
+
+template<typename Key, typename Value>
+struct StructureFactory<CompactAVL<Key, Value>> {
+	static CompactAVL<Key, Value>* create(const unsigned int& expectedElements) {
+		return new CompactAVL<Key, Value>{ expectedElements };
+	}
+};
+
+/// <summary>
+/// Exposes the insert/contains/remove interface of the project structures over a standard associative container
+/// so that the same workloads can be run against it
+/// </summary>
+template<typename Container>
+class StdAdapter
+{
+	private:
+		Container container;
+
+	public:
+		template<typename Key, typename Value>
+		void insert(const Key& key, const Value& value) {
+			this->insertInternal(this->container, key, value);
+		}
+
+		template<typename Key>
+		bool contains(const Key& key) const {
+			return this->container.find(key) != this->container.end();
+		}
+
+		template<typename Key>
+		void remove(const Key& key) {
+			this->container.erase(key);
+		}
+
+	private:
+		template<typename Map, typename Key, typename Value>
+		static auto insertInternal(Map& map, const Key& key, const Value& value) -> decltype(map[key] = value, void()) {
+			map[key] = value;
+		}
+
+		//sets store only the key
+		template<typename Set, typename Key, typename Value>
+		static auto insertInternal(Set& set, const Key& key, const Value&) -> decltype(set.insert(key), void()) {
+			set.insert(key);
+		}
+};
+
+/// <summary>
+/// Generates unique random keys for the benchmark workloads
+/// </summary>
+class KeyGenerator
+{
+	private:
+		std::mt19937 generator;
+		std::uniform_int_distribution<int> distribution;
+		std::unordered_set<int> used;
+
+	public:
+		/// <summary>
+		/// Creates a generator with a fixed seed so that every structure runs the same workload
+		/// </summary>
+		/// <param>const unsigned int& the seed</param>
+		KeyGenerator(const unsigned int& seed) :
+			generator(seed),
+			distribution(0, 0x7fffffff) {}
+
+		/// <summary>
+		/// Generates keys that were not returned by this generator before
+		/// </summary>
+		/// <param>const unsigned int& the number of keys</param>
+		/// <return>std::vector<int> the generated keys</return>
+		std::vector<int> uniqueKeys(const unsigned int& count) {
+			std::vector<int> keys;
+			keys.reserve(count);
+
+			while (keys.size() < count) {
+				int key = this->distribution(this->generator);
+				if (this->used.insert(key).second) {
+					keys.push_back(key);
+				}
+			}
+
+			return keys;
+		}
+
+		std::mt19937& engine() {
+			return this->generator;
+		}
+};
+
+/// <summary>
+/// The keys of a single measurement - the keys inserted before timing and the keys the timed operations use
+/// </summary>
+struct Workload {
+	std::vector<int> present;
+	std::vector<int> operations;
+
+	/// <summary>
+	/// Creates the workload for an operation as in the README table:
+	/// 'c' - contains, half of the looked up keys are present
+	/// 'i' - insert of absent keys
+	/// 'r' - remove of present keys
+	/// </summary>
+	/// <param>const unsigned int& the number of elements inserted before timing</param>
+	/// <param>const unsigned int& the number of timed operations</param>
+	/// <param>const char& the operation</param>
+	/// <param>const unsigned int& the seed of the keys</param>
+	Workload(const unsigned int& elements, const unsigned int& operationsCount, const char& operation, const unsigned int& seed) {
+		KeyGenerator keys{ seed };
+		this->present = keys.uniqueKeys(elements);
+
+		std::vector<int> shuffled = this->present;
+		std::shuffle(shuffled.begin(), shuffled.end(), keys.engine());
+
+		if (operation == 'i') {
+			this->operations = keys.uniqueKeys(operationsCount);
+		} else if (operation == 'r') {
+			this->operations.assign(shuffled.begin(), shuffled.begin() + std::min<size_t>(operationsCount, shuffled.size()));
+		} else {
+			std::vector<int> absent = keys.uniqueKeys(operationsCount / 2);
+			for (unsigned int i = 0; i < operationsCount; i++) {
+				this->operations.push_back(i % 2 == 0 && !shuffled.empty() ? shuffled[(i / 2) % shuffled.size()] : absent[(i / 2) % absent.size()]);
+			}
+		}
+	}
+};
+
+/// <summary>
+/// Runs all operations of a workload on a structure
+/// </summary>
+template<typename Structure>
+void runOperation(Structure& structure, const Workload& workload, const char& operation, unsigned long long& found) {
+	switch (operation) {
+		case 'c':
+			for (const int& key : workload.operations) {
+				found += structure.contains(key);
+			}
+			break;
+		case 'i':
+			for (const int& key : workload.operations) {
+				structure.insert(key, key);
+			}
+			break;
+		case 'r':
+			for (const int& key : workload.operations) {
+				structure.remove(key);
+			}
+			break;
+	}
+}
+
+/// <summary>
+/// Builds a structure with the present keys of a workload and times the operations on it
+/// </summary>
+/// <param>const Workload& the keys to use</param>
+/// <param>const char& the operation - 'c', 'i' or 'r'</param>
+/// <param>unsigned long long& receives the number of successful lookups so that they cannot be optimized away</param>
+/// <return>double the mean duration of an operation in nanoseconds</return>
+template<typename Structure>
+double measureOperation(const Workload& workload, const char& operation, unsigned long long& found) {
+	Structure* structure = StructureFactory<Structure>::create((unsigned int)(workload.present.size() + workload.operations.size()));
+	for (const int& key : workload.present) {
+		structure->insert(key, key);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	runOperation(*structure, workload, operation, found);
+	auto stop = std::chrono::steady_clock::now();
+
+	delete structure;
+
+	if (workload.operations.empty()) {
+		return 0;
+	}
+
+	return std::chrono::duration<double, std::nano>(stop - start).count() / workload.operations.size();
+}
+
+/// <summary>
+/// Builds a structure with the present keys of a workload and times every operation on it separately
+/// </summary>
+/// <param>const Workload& the keys to use</param>
+/// <param>const char& the operation - 'c', 'i' or 'r'</param>
+/// <param>unsigned long long& receives the number of successful lookups so that they cannot be optimized away</param>
+/// <return>std::vector<double> the duration of every operation in nanoseconds, sorted ascending</return>
+template<typename Structure>
+std::vector<double> measureLatencies(const Workload& workload, const char& operation, unsigned long long& found) {
+	Structure* structure = StructureFactory<Structure>::create((unsigned int)(workload.present.size() + workload.operations.size()));
+	for (const int& key : workload.present) {
+		structure->insert(key, key);
+	}
+
+	std::vector<double> latencies;
+	latencies.reserve(workload.operations.size());
+	for (const int& key : workload.operations) {
+		auto start = std::chrono::steady_clock::now();
+		switch (operation) {
+			case 'c':
+				found += structure->contains(key);
+				break;
+			case 'i':
+				structure->insert(key, key);
+				break;
+			case 'r':
+				structure->remove(key);
+				break;
+		}
+		auto stop = std::chrono::steady_clock::now();
+		latencies.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+	}
+
+	delete structure;
+
+	std::sort(latencies.begin(), latencies.end());
+	return latencies;
+}
+
+/// <summary>
+/// Runs an operation several times on freshly built structures
+/// </summary>
+/// <param>const unsigned int& the number of elements inserted before timing</param>
+/// <param>const unsigned int& the number of timed operations per repetition</param>
+/// <param>const char& the operation - 'c', 'i' or 'r'</param>
+/// <param>const unsigned int& the number of repetitions</param>
+/// <param>unsigned long long& receives the number of successful lookups</param>
+/// <return>std::vector<double> the mean duration of an operation in nanoseconds for every repetition</return>
+template<typename Structure>
+std::vector<double> measureRepeated(const unsigned int& elements, const unsigned int& operationsCount, const char& operation, const unsigned int& repetitions, unsigned long long& found) {
+	std::vector<double> samples;
+	for (unsigned int i = 0; i < repetitions; i++) {
+		Workload workload{ elements, operationsCount, operation, i + 1 };
+		samples.push_back(measureOperation<Structure>(workload, operation, found));
+	}
+
+	return samples;
+}
+
+/// <summary>
+/// Calculates the arithmetic mean of samples
+/// </summary>
+inline double mean(const std::vector<double>& samples) {
+	if (samples.empty()) {
+		return 0;
+	}
+
+	double sum = 0;
+	for (const double& sample : samples) {
+		sum += sample;
+	}
+
+	return sum / samples.size();
+}
+
+/// <summary>
+/// Finds a percentile of sorted samples by the nearest-rank method
+/// </summary>
+/// <param>const std::vector<double>& the samples sorted ascending</param>
+/// <param>const double& the percentile between 0 and 100</param>
+inline double percentile(const std::vector<double>& sortedSamples, const double& rank) {
+	if (sortedSamples.empty()) {
+		return 0;
+	}
+
+	size_t index = (size_t)std::ceil(rank / 100 * sortedSamples.size());
+	return sortedSamples[index > 0 ? index - 1 : 0];
+}
+
+/// <summary>
+/// Parses an unsigned integer command line option of the form --name value
+/// </summary>
+/// <return>unsigned long long the parsed value or the default if the option is missing</return>
+inline unsigned long long parseOption(int argc, char** argv, const std::string& name, const unsigned long long& defaultValue) {
+	for (int i = 1; i + 1 < argc; i++) {
+		if (name == argv[i]) {
+			return std::stoull(argv[i + 1]);
+		}
+	}
+
+	return defaultValue;
+}
+
+/// <summary>
+/// Parses a decimal command line option of the form --name value
+/// </summary>
+/// <return>double the parsed value or the default if the option is missing</return>
+inline double parseDecimalOption(int argc, char** argv, const std::string& name, const double& defaultValue) {
+	for (int i = 1; i + 1 < argc; i++) {
+		if (name == argv[i]) {
+			return std::stod(argv[i + 1]);
+		}
+	}
+
+	return defaultValue;
+}
+
+/// <summary>
+/// Parses a text command line option of the form --name value
+/// </summary>
+/// <return>std::string the value or the default if the option is missing</return>
+inline std::string parseTextOption(int argc, char** argv, const std::string& name, const std::string& defaultValue) {
+	for (int i = 1; i + 1 < argc; i++) {
+		if (name == argv[i]) {
+			return argv[i + 1];
+		}
+	}
+
+	return defaultValue;
+}
+
+/// <summary>
+/// Checks whether a command line flag is present
+/// </summary>
+inline bool hasFlag(int argc, char** argv, const std::string& name) {
+	for (int i = 1; i < argc; i++) {
+		if (name == argv[i]) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/SkipList/SkipList.cpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Measures checkpointing a SkipList to a file with dump and rebuilding it: restore appends the pairs of the snapshot
+/// behind the last node of every level, against inserting the same pairs with insert and with insertSorted
+/// The file is written through the page cache and not synced, so the write rate is bounded by memory rather than the disk
+/// Reports milliseconds and megabytes per second of the snapshot for every step
+/// Options: --max-elements N (default 5000000), --path FILE (default SkipListCheckpoint.bin)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+	std::string path = "SkipListCheckpoint.bin";
+	for (int i = 1; i + 1 < argc; i++) {
+		if (std::string(argv[i]) == "--path") {
+			path = argv[i + 1];
+		}
+	}
+
+	std::cout << std::left << std::setw(10) << "Elements" << std::setw(16) << "Step" << std::setw(12) << "ms" << "MB/s" << std::endl;
+
+	for (unsigned int elements = 50000; elements <= maxElements; elements *= 10) {
+		KeyGenerator keys{ elements };
+		SkipList<int, int> list{ elements };
+		for (const int& key : keys.uniqueKeys(elements)) {
+			list.insert(key, key);
+		}
+
+		double megabytes = 0;
+		auto report = [&](const char* step, const std::chrono::steady_clock::time_point& start) {
+			double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			std::cout << std::left << std::setw(10) << elements << std::setw(16) << step << std::fixed << std::setprecision(2)
+				<< std::setw(12) << milliseconds << megabytes / (milliseconds / 1000) << std::endl;
+		};
+
+		{
+			auto start = std::chrono::steady_clock::now();
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			list.dump(out);
+			out.close();
+			megabytes = (double)std::ifstream(path, std::ios::binary | std::ios::ate).tellg() / (1 << 20);
+			report("dump", start);
+		}
+
+		//the first rebuild grows the heap, so an untimed restore runs before the measured ones
+		{
+			std::ifstream in(path, std::ios::binary);
+			SkipList<int, int> warmup{ elements };
+			warmup.restore(in);
+		}
+
+		{
+			auto start = std::chrono::steady_clock::now();
+			std::ifstream in(path, std::ios::binary);
+			SkipList<int, int> restored{ elements };
+			restored.restore(in);
+			report("restore", start);
+		}
+
+		//the pairs are read in order without a file, so both rebuilds exclude the I/O
+		std::vector<std::pair<int, int>> pairs;
+		pairs.reserve(elements);
+		list.forEach([&pairs](const int& key, const int& value) {
+			pairs.emplace_back(key, value);
+		});
+
+		{
+			auto start = std::chrono::steady_clock::now();
+			SkipList<int, int> rebuilt{ elements };
+			for (const std::pair<int, int>& pair : pairs) {
+				rebuilt.insert(pair.first, pair.second);
+			}
+			report("insert", start);
+		}
+
+		{
+			auto start = std::chrono::steady_clock::now();
+			SkipList<int, int> rebuilt{ elements };
+			rebuilt.insertSorted(pairs.begin(), pairs.end());
+			report("insertSorted", start);
+		}
+	}
+
+	std::remove(path.c_str());
+
+	return 0;
+}
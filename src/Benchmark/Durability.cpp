@@ -0,0 +1,71 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/AVL/AVL.cpp"
+#include "src/WAL/WAL.cpp"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Measures durable updates on AVL: every insert is logged to a WAL before it is applied, and the log is committed
+/// with one fdatasync per group of records, for growing group sizes
+/// A group of 1 syncs every update, so it runs only --sync-updates updates
+/// Reports updates per second with and without the log, and the time to replay the log into an empty tree
+/// Options: --updates N (default 1000000), --sync-updates N (default 2000), --path FILE (default Durability.log)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int updates = (unsigned int)parseOption(argc, argv, "--updates", 1000000);
+	unsigned int syncUpdates = (unsigned int)parseOption(argc, argv, "--sync-updates", 2000);
+	std::string path = "Durability.log";
+	for (int i = 1; i + 1 < argc; i++) {
+		if (std::string(argv[i]) == "--path") {
+			path = argv[i + 1];
+		}
+	}
+
+	KeyGenerator keys{ updates };
+	std::vector<int> inserted = keys.uniqueKeys(updates);
+
+	std::cout << std::left << std::setw(12) << "Group" << std::setw(12) << "Updates" << std::setw(16) << "updates/s" << "replay ms" << std::endl;
+
+	{
+		auto start = std::chrono::steady_clock::now();
+		AVL<int, int> tree;
+		for (const int& key : inserted) {
+			tree.insert(key, key);
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << std::left << std::setw(12) << "no log" << std::setw(12) << updates << std::fixed << std::setprecision(0) << updates / seconds << std::endl;
+	}
+
+	for (unsigned int groupSize : { 1u, 16u, 256u, 4096u, 65536u }) {
+		unsigned int count = groupSize == 1 ? std::min(updates, syncUpdates) : updates;
+		std::remove(path.c_str());
+
+		auto start = std::chrono::steady_clock::now();
+		{
+			AVL<int, int> tree;
+			WAL<int, int> log{ groupSize };
+			log.open(path, tree);
+			for (unsigned int i = 0; i < count; i++) {
+				log.logInsert(inserted[i], inserted[i]);
+				tree.insert(inserted[i], inserted[i]);
+			}
+			log.commit();
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		start = std::chrono::steady_clock::now();
+		AVL<int, int> replayed;
+		WAL<int, int> log;
+		log.open(path, replayed);
+		double replayMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << std::left << std::setw(12) << groupSize << std::setw(12) << count << std::fixed << std::setprecision(0)
+			<< std::setw(16) << count / seconds << std::setprecision(2) << replayMilliseconds << std::endl;
+	}
+
+	std::remove(path.c_str());
+
+	return 0;
+}
@@ -0,0 +1,116 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include "src/LookupCache/LookupCached.cpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+template<typename Key, typename Value, typename Structure>
+struct StructureFactory<LookupCached<Key, Value, Structure>> {
+	static LookupCached<Key, Value, Structure>* create(const unsigned int& expectedElements) {
+		return new LookupCached<Key, Value, Structure>{ expectedElements };
+	}
+};
+
+/// <summary>
+/// Draws ranks from a Zipf distribution - rank r in [0, n) has a probability proportional to 1 / (r + 1)^s
+/// </summary>
+class ZipfGenerator
+{
+	private:
+		std::vector<double> cumulative;
+		std::uniform_real_distribution<double> distribution;
+
+	public:
+		ZipfGenerator(const unsigned int& n, const double& exponent) :
+			cumulative(n),
+			distribution(0, 1)
+		{
+			double sum = 0;
+			for (unsigned int i = 0; i < n; i++) {
+				sum += 1 / std::pow(i + 1.0, exponent);
+				this->cumulative[i] = sum;
+			}
+			for (double& value : this->cumulative) {
+				value /= sum;
+			}
+		}
+
+		template<typename Engine>
+		unsigned int next(Engine& engine) {
+			double point = this->distribution(engine);
+			return (unsigned int)std::min<size_t>(std::lower_bound(this->cumulative.begin(), this->cumulative.end(), point) - this->cumulative.begin(), this->cumulative.size() - 1);
+		}
+};
+
+/// <summary>
+/// Builds a structure with the present keys and measures the mean duration of getValue
+/// </summary>
+template<typename Structure>
+double measureLookups(Structure& structure, const std::vector<int>& lookups, unsigned long long& found) {
+	auto start = std::chrono::steady_clock::now();
+	for (const int& key : lookups) {
+		const int* value = structure.getValue(key);
+		found += value != nullptr;
+	}
+	auto stop = std::chrono::steady_clock::now();
+
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / lookups.size();
+}
+
+/// <summary>
+/// Prints the lookup cost of a structure with and without the cache in front of it and the hit rate of the cache
+/// </summary>
+template<typename Structure>
+void compareCached(const char* name, const std::vector<int>& present, const std::vector<int>& lookups, const unsigned int& slots, unsigned long long& found) {
+	Structure* plain = StructureFactory<Structure>::create((unsigned int)present.size());
+	LookupCached<int, int, Structure> cached{ (unsigned int)present.size(), slots };
+	for (const int& key : present) {
+		plain->insert(key, key);
+		cached.insert(key, key);
+	}
+
+	double plainDuration = measureLookups(*plain, lookups, found);
+	double cachedDuration = measureLookups(cached, lookups, found);
+	delete plain;
+
+	std::cout << std::left << std::setw(10) << name << std::setw(10) << present.size() << std::fixed << std::setprecision(1)
+		<< std::setw(10) << plainDuration << std::setw(10) << cachedDuration << std::setprecision(2)
+		<< std::setw(10) << plainDuration / cachedDuration << std::setprecision(1) << std::setw(10) << cached.hitRate() * 100 << std::endl;
+}
+
+/// <summary>
+/// Measures getValue on AVL and SkipList with and without the lookup cache when the keys are drawn from a Zipf distribution
+/// Options: --max-elements N (default 5000000), --operations N (default 1000000),
+/// --exponent S (default 0.99), --slots N (default 65536)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+	unsigned int operationsCount = (unsigned int)parseOption(argc, argv, "--operations", 1000000);
+	double exponent = parseDecimalOption(argc, argv, "--exponent", 0.99);
+	unsigned int slots = (unsigned int)parseOption(argc, argv, "--slots", 65536);
+	unsigned long long found = 0;
+
+	std::cout << "Mean duration of getValue in nanoseconds, Zipf exponent " << exponent << ", " << slots << " slots" << std::endl;
+	std::cout << std::left << std::setw(10) << "Structure" << std::setw(10) << "Elements" << std::setw(10) << "plain"
+		<< std::setw(10) << "cached" << std::setw(10) << "speedup" << std::setw(10) << "hit %" << std::endl;
+
+	for (unsigned int elements = 50000; elements <= maxElements; elements *= 10) {
+		KeyGenerator keys{ elements };
+		std::vector<int> present = keys.uniqueKeys(elements);
+
+		//the ranks are mapped to random keys, so that the hot keys are spread over the structure
+		ZipfGenerator zipf{ elements, exponent };
+		std::vector<int> lookups;
+		for (unsigned int i = 0; i < operationsCount; i++) {
+			lookups.push_back(present[zipf.next(keys.engine())]);
+		}
+
+		compareCached<AVL<int, int>>("AVL", present, lookups, slots, found);
+		compareCached<SkipList<int, int>>("SkipList", present, lookups, slots, found);
+	}
+
+	std::cout << "Keys found: " << found << std::endl;
+	return 0;
+}
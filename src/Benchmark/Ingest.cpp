@@ -0,0 +1,138 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/LSM/LSM.cpp"
+#include "src/AVL/AVL.cpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+/// <summary>
+/// Measures the LSM store against the in-memory AVL and SkipList: inserts of random keys, then lookups of present
+/// and of absent keys, the LSM store logging every insert and flushing its memtables to tables on the disk
+/// Reports operations per second, and for the LSM store the number of tables and the bytes in its directory
+/// Options: --max-elements N (default 5000000), --lookups N (default 1000000), --memtable N (default 65536), --path DIR (default IngestStore)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+	unsigned int lookupsCount = (unsigned int)parseOption(argc, argv, "--lookups", 1000000);
+	unsigned int memtableEntries = (unsigned int)parseOption(argc, argv, "--memtable", 1 << 16);
+	std::string path = "IngestStore";
+	for (int i = 1; i + 1 < argc; i++) {
+		if (std::string(argv[i]) == "--path") {
+			path = argv[i + 1];
+		}
+	}
+
+	std::cout << std::left << std::setw(10) << "Elements" << std::setw(10) << "Structure" << std::setw(14) << "inserts/s"
+		<< std::setw(14) << "hits/s" << std::setw(14) << "misses/s" << std::setw(8) << "tables" << "disk MB" << std::endl;
+
+	for (unsigned int elements = 50000; elements <= maxElements; elements *= 10) {
+		KeyGenerator keys{ elements };
+		std::vector<int> inserted = keys.uniqueKeys(elements);
+		std::vector<int> hits, misses = keys.uniqueKeys(lookupsCount);
+		for (unsigned int i = 0; i < lookupsCount; i++) {
+			hits.push_back(inserted[keys.engine()() % elements]);
+		}
+
+		auto rate = [](const unsigned int& operations, const std::chrono::steady_clock::time_point& start) {
+			return operations / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		};
+		auto report = [&](const char* structure, double inserts, double hitRate, double missRate, const std::string& tables, const std::string& disk) {
+			std::cout << std::left << std::setw(10) << elements << std::setw(10) << structure << std::fixed << std::setprecision(0)
+				<< std::setw(14) << inserts << std::setw(14) << hitRate << std::setw(14) << missRate << std::setw(8) << tables << disk << std::endl;
+		};
+
+		{
+			std::filesystem::remove_all(path);
+			LSM<int, int> store{ memtableEntries };
+			store.open(path);
+			unsigned int found = 0;
+			int value;
+
+			auto start = std::chrono::steady_clock::now();
+			for (const int& key : inserted) {
+				store.insert(key, key);
+			}
+			store.commit();
+			double inserts = rate(elements, start);
+			store.flush();
+
+			start = std::chrono::steady_clock::now();
+			for (const int& key : hits) {
+				found += store.getValue(key, value);
+			}
+			double hitRate = rate(lookupsCount, start);
+
+			start = std::chrono::steady_clock::now();
+			for (const int& key : misses) {
+				found += store.getValue(key, value);
+			}
+			double missRate = rate(lookupsCount, start);
+
+			std::uintmax_t bytes = 0;
+			for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator(path)) {
+				bytes += file.file_size();
+			}
+			std::ostringstream disk;
+			disk << std::fixed << std::setprecision(2) << (double)bytes / (1 << 20);
+			report("LSM", inserts, hitRate, missRate, std::to_string(store.tablesCount()), disk.str());
+			if (found != lookupsCount) {
+				std::cout << "LSM found " << found << " of " << lookupsCount << " present keys" << std::endl;
+			}
+		}
+		std::filesystem::remove_all(path);
+
+		{
+			SkipList<int, int> list{ elements };
+			unsigned int found = 0;
+			auto start = std::chrono::steady_clock::now();
+			for (const int& key : inserted) {
+				list.insert(key, key);
+			}
+			double inserts = rate(elements, start);
+
+			start = std::chrono::steady_clock::now();
+			for (const int& key : hits) {
+				found += list.contains(key);
+			}
+			double hitRate = rate(lookupsCount, start);
+
+			start = std::chrono::steady_clock::now();
+			for (const int& key : misses) {
+				found += list.contains(key);
+			}
+			report("SkipList", inserts, hitRate, rate(lookupsCount, start), "-", "-");
+			if (found != lookupsCount) {
+				std::cout << "SkipList found " << found << " of " << lookupsCount << " present keys" << std::endl;
+			}
+		}
+
+		{
+			AVL<int, int> tree;
+			unsigned int found = 0;
+			auto start = std::chrono::steady_clock::now();
+			for (const int& key : inserted) {
+				tree.insert(key, key);
+			}
+			double inserts = rate(elements, start);
+
+			start = std::chrono::steady_clock::now();
+			for (const int& key : hits) {
+				found += tree.contains(key);
+			}
+			double hitRate = rate(lookupsCount, start);
+
+			start = std::chrono::steady_clock::now();
+			for (const int& key : misses) {
+				found += tree.contains(key);
+			}
+			report("AVL", inserts, hitRate, rate(lookupsCount, start), "-", "-");
+			if (found != lookupsCount) {
+				std::cout << "AVL found " << found << " of " << lookupsCount << " present keys" << std::endl;
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/Benchmark/MemoryCounter.h"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include "src/ART/ART.cpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <unordered_set>
+
+/// <summary>
+/// The keys of a distribution - the keys inserted into the structure and as many absent keys of the same shape
+/// </summary>
+template<typename Key>
+struct KeySet {
+	std::vector<Key> present;
+	std::vector<Key> absent;
+};
+
+/// <summary>
+/// Consecutive 64-bit IDs in random order, the absent keys follow the present ones
+/// </summary>
+KeySet<std::uint64_t> denseKeys(const unsigned int& count, std::mt19937_64& generator) {
+	KeySet<std::uint64_t> keys;
+	for (std::uint64_t i = 0; i < count; i++) {
+		keys.present.push_back(i);
+		keys.absent.push_back(count + i);
+	}
+	std::shuffle(keys.present.begin(), keys.present.end(), generator);
+	std::shuffle(keys.absent.begin(), keys.absent.end(), generator);
+
+	return keys;
+}
+
+/// <summary>
+/// Uniformly random 64-bit IDs
+/// </summary>
+KeySet<std::uint64_t> sparseKeys(const unsigned int& count, std::mt19937_64& generator) {
+	KeySet<std::uint64_t> keys;
+	std::unordered_set<std::uint64_t> used;
+	while (keys.absent.size() < count) {
+		std::uint64_t key = generator();
+		if (used.insert(key).second) {
+			(keys.present.size() < count ? keys.present : keys.absent).push_back(key);
+		}
+	}
+
+	return keys;
+}
+
+/// <summary>
+/// Short strings sharing a prefix, such as "user:0000c0ffee42"
+/// </summary>
+KeySet<std::string> stringKeys(const unsigned int& count, std::mt19937_64& generator) {
+	KeySet<std::uint64_t> ids = sparseKeys(count, generator);
+	KeySet<std::string> keys;
+	char buffer[32];
+	for (unsigned int i = 0; i < count; i++) {
+		std::snprintf(buffer, sizeof(buffer), "user:%012llx", (unsigned long long)(ids.present[i] & 0xffffffffffffull));
+		keys.present.push_back(buffer);
+		std::snprintf(buffer, sizeof(buffer), "user:%012llx", (unsigned long long)(ids.absent[i] & 0xffffffffffffull));
+		keys.absent.push_back(buffer);
+	}
+
+	return keys;
+}
+
+/// <summary>
+/// Prints the mean duration of an insert while building the structure, of a lookup of a present and of an absent key
+/// and the requested heap bytes per key
+/// </summary>
+template<typename Structure, typename Key>
+void measureDistribution(const char* name, const char* distribution, const KeySet<Key>& keys, unsigned long long& found) {
+	long long before = allocatedBytes().load();
+	Structure* structure = StructureFactory<Structure>::create((unsigned int)keys.present.size());
+
+	auto start = std::chrono::steady_clock::now();
+	for (const Key& key : keys.present) {
+		structure->insert(key, 1);
+	}
+	auto inserted = std::chrono::steady_clock::now();
+	long long after = allocatedBytes().load();
+
+	for (const Key& key : keys.present) {
+		found += structure->contains(key);
+	}
+	auto hits = std::chrono::steady_clock::now();
+
+	for (const Key& key : keys.absent) {
+		found += structure->contains(key);
+	}
+	auto misses = std::chrono::steady_clock::now();
+	delete structure;
+
+	double count = (double)keys.present.size();
+	std::cout << std::left << std::setw(10) << name << std::setw(10) << distribution << std::setw(10) << keys.present.size()
+		<< std::fixed << std::setprecision(1)
+		<< std::setw(10) << std::chrono::duration_cast<std::chrono::nanoseconds>(inserted - start).count() / count
+		<< std::setw(10) << std::chrono::duration_cast<std::chrono::nanoseconds>(hits - inserted).count() / count
+		<< std::setw(10) << std::chrono::duration_cast<std::chrono::nanoseconds>(misses - hits).count() / count
+		<< std::setw(10) << (after - before) / count << std::endl;
+}
+
+template<typename Key>
+void measureAll(const char* distribution, const KeySet<Key>& keys, unsigned long long& found) {
+	measureDistribution<AVL<Key, int>>("AVL", distribution, keys, found);
+	measureDistribution<SkipList<Key, int>>("SkipList", distribution, keys, found);
+	measureDistribution<ART<Key, int>>("ART", distribution, keys, found);
+}
+
+/// <summary>
+/// Compares AVL, SkipList and ART on dense and sparse 64-bit IDs and on short strings
+/// Reports nanoseconds per insert, per lookup of a present key and of an absent key, and heap bytes per key
+/// Options: --max-elements N (default 5000000)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+	unsigned long long found = 0;
+
+	std::cout << std::left << std::setw(10) << "Structure" << std::setw(10) << "Keys" << std::setw(10) << "Elements"
+		<< std::setw(10) << "insert" << std::setw(10) << "hit" << std::setw(10) << "miss" << std::setw(10) << "bytes/key" << std::endl;
+
+	for (unsigned int elements = 50000; elements <= maxElements; elements *= 10) {
+		std::mt19937_64 generator{ elements };
+		measureAll("dense", denseKeys(elements, generator), found);
+		measureAll("sparse", sparseKeys(elements, generator), found);
+		measureAll("string", stringKeys(elements, generator), found);
+	}
+
+	std::cout << "Keys found: " << found << std::endl;
+	return 0;
+}
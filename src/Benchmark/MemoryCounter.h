@@ -0,0 +1,87 @@
+#ifndef MEMORYCOUNTER_H
+#define MEMORYCOUNTER_H
+
+#include<new>
+#include<cstdlib>
+#include<cstddef>
+#include<atomic>
+
+/// <summary>
+/// Replaces the global allocation functions to count the heap bytes in use, used to report bytes per key
+/// Must be included by a single translation unit of an executable
+/// Every block is prefixed by a header holding its size and the offset of the header
+/// </summary>
+inline std::atomic<long long>& allocatedBytes() {
+	static std::atomic<long long> bytes{ 0 };
+	return bytes;
+}
+
+static void* countedAllocate(std::size_t size, std::size_t alignment) {
+	alignment = alignment < 2 * sizeof(std::size_t) ? 2 * sizeof(std::size_t) : alignment;
+	std::size_t total = (size + 2 * alignment - 1) / alignment * alignment;
+
+#ifdef _WIN32
+	char* block = (char*)_aligned_malloc(total, alignment);
+#else
+	char* block = (char*)std::aligned_alloc(alignment, total);
+#endif
+	if (!block) {
+		return nullptr;
+	}
+
+	char* result = block + alignment;
+	((std::size_t*)result)[-1] = alignment;
+	((std::size_t*)result)[-2] = size;
+	allocatedBytes().fetch_add((long long)size, std::memory_order_relaxed);
+
+	return result;
+}
+
+static void countedFree(void* pointer) {
+	if (!pointer) {
+		return;
+	}
+
+	char* result = (char*)pointer;
+	std::size_t alignment = ((std::size_t*)result)[-1];
+	allocatedBytes().fetch_sub((long long)((std::size_t*)result)[-2], std::memory_order_relaxed);
+
+#ifdef _WIN32
+	_aligned_free(result - alignment);
+#else
+	std::free(result - alignment);
+#endif
+}
+
+static void* countedAllocateOrThrow(std::size_t size, std::size_t alignment) {
+	void* result = countedAllocate(size, alignment);
+	if (!result) {
+		throw std::bad_alloc{};
+	}
+
+	return result;
+}
+
+void* operator new(std::size_t size) { return countedAllocateOrThrow(size, 0); }
+void* operator new[](std::size_t size) { return countedAllocateOrThrow(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAllocateOrThrow(size, (std::size_t)alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAllocateOrThrow(size, (std::size_t)alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return countedAllocate(size, (std::size_t)alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return countedAllocate(size, (std::size_t)alignment); }
+
+void operator delete(void* pointer) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { countedFree(pointer); }
+
+#endif
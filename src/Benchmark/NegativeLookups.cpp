@@ -0,0 +1,91 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include "src/BloomFilter/BloomFiltered.cpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+template<typename Key, typename Value, typename Structure>
+struct StructureFactory<BloomFiltered<Key, Value, Structure>> {
+	static BloomFiltered<Key, Value, Structure>* create(const unsigned int& expectedElements) {
+		return new BloomFiltered<Key, Value, Structure>{ expectedElements };
+	}
+};
+
+/// <summary>
+/// Builds a structure with the present keys and measures the mean duration of the lookups
+/// </summary>
+template<typename Structure>
+double measureLookups(const std::vector<int>& present, const std::vector<int>& lookups, unsigned long long& found) {
+	Structure* structure = StructureFactory<Structure>::create((unsigned int)present.size());
+	for (const int& key : present) {
+		structure->insert(key, key);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (const int& key : lookups) {
+		found += structure->contains(key);
+	}
+	auto stop = std::chrono::steady_clock::now();
+	delete structure;
+
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / lookups.size();
+}
+
+/// <summary>
+/// Prints the lookup cost of a structure with and without the filter in front of it
+/// </summary>
+template<typename Structure>
+void compareFiltered(const char* name, const std::vector<int>& present, const std::vector<int>& lookups, const double& falsePositiveRate, unsigned long long& found) {
+	double plain = measureLookups<Structure>(present, lookups, found);
+	double filtered = measureLookups<BloomFiltered<int, int, Structure>>(present, lookups, found);
+
+	std::cout << std::left << std::setw(10) << name << std::setw(10) << present.size() << std::fixed << std::setprecision(1)
+		<< std::setw(10) << plain << std::setw(10) << filtered << std::setprecision(2) << std::setw(10) << plain / filtered
+		<< std::setprecision(3) << std::setw(10) << falsePositiveRate * 100 << std::endl;
+}
+
+/// <summary>
+/// Measures contains on AVL and SkipList with and without a Bloom filter in front of them
+/// when most of the looked up keys are absent, and the false positive rate of the filter
+/// Options: --max-elements N (default 5000000), --operations N (default 1000000), --miss-percent P (default 70)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+	unsigned int operationsCount = (unsigned int)parseOption(argc, argv, "--operations", 1000000);
+	unsigned int missPercent = (unsigned int)parseOption(argc, argv, "--miss-percent", 70);
+	unsigned long long found = 0;
+
+	std::cout << "Mean duration of contains in nanoseconds, " << missPercent << "% of the keys are absent" << std::endl;
+	std::cout << std::left << std::setw(10) << "Structure" << std::setw(10) << "Elements" << std::setw(10) << "plain"
+		<< std::setw(10) << "filtered" << std::setw(10) << "speedup" << std::setw(10) << "FPR %" << std::endl;
+
+	for (unsigned int elements = 50000; elements <= maxElements; elements *= 10) {
+		KeyGenerator keys{ elements };
+		std::vector<int> present = keys.uniqueKeys(elements);
+		std::vector<int> absent = keys.uniqueKeys(operationsCount);
+
+		std::vector<int> lookups;
+		std::uniform_int_distribution<unsigned int> percent{ 0, 99 };
+		for (unsigned int i = 0; i < operationsCount; i++) {
+			lookups.push_back(percent(keys.engine()) < missPercent ? absent[i] : present[keys.engine()() % present.size()]);
+		}
+
+		BlockedBloomFilter<int> filter{ elements };
+		for (const int& key : present) {
+			filter.add(key);
+		}
+		unsigned int falsePositives = 0;
+		for (const int& key : absent) {
+			falsePositives += filter.mayContain(key);
+		}
+		double falsePositiveRate = (double)falsePositives / absent.size();
+
+		compareFiltered<AVL<int, int>>("AVL", present, lookups, falsePositiveRate, found);
+		compareFiltered<SkipList<int, int>>("SkipList", present, lookups, falsePositiveRate, found);
+	}
+
+	std::cout << "Keys found: " << found << std::endl;
+	return 0;
+}
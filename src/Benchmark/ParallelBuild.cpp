@@ -0,0 +1,56 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/AVL/AVL.cpp"
+#include "src/Parallel/WorkStealingPool.h"
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Builds an AVL from a vector of random pairs serially and on a WorkStealingPool for several numbers of threads,
+/// reporting milliseconds per build (the sort of the pairs is serial in both) and the speedup over the serial build
+/// Options: --elements N (default 5000000), --max-threads N (default 8), --repetitions N (default 3)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int elements = (unsigned int)parseOption(argc, argv, "--elements", 5000000);
+	unsigned int maxThreads = (unsigned int)parseOption(argc, argv, "--max-threads", 8);
+	unsigned int repetitions = (unsigned int)parseOption(argc, argv, "--repetitions", 3);
+
+	KeyGenerator keys{ 17 };
+	std::vector<int> present = keys.uniqueKeys(elements);
+	std::vector<std::pair<int, int>> pairs;
+	pairs.reserve(elements);
+	for (const int& key : present) {
+		pairs.emplace_back(key, key);
+	}
+
+	//returns the best time of the repetitions in milliseconds
+	auto measure = [&](auto build) {
+		double best = 0;
+		for (unsigned int r = 0; r < repetitions; r++) {
+			auto start = std::chrono::steady_clock::now();
+			unsigned int nodes = build();
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			if (nodes != elements) {
+				std::cout << "the tree holds " << nodes << " nodes" << std::endl;
+			}
+			best = r == 0 ? ms : std::min(best, ms);
+		}
+		return best;
+	};
+
+	std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+	std::cout << std::left << std::setw(10) << "Threads" << std::setw(14) << "build ms" << "speedup" << std::endl;
+
+	double serial = measure([&]() { return AVL<int, int>{ pairs }.nodesCount(); });
+	std::cout << std::left << std::setw(10) << "serial" << std::setw(14) << std::fixed << std::setprecision(1) << serial << "1.00" << std::endl;
+
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+		WorkStealingPool pool{ threads };
+		double parallel = measure([&]() { return AVL<int, int>{ pairs, pool }.nodesCount(); });
+		std::cout << std::left << std::setw(10) << threads << std::setw(14) << std::fixed << std::setprecision(1) << parallel
+			<< std::setprecision(2) << serial / parallel << std::endl;
+	}
+
+	return 0;
+}
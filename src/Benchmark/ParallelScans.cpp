@@ -0,0 +1,89 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include "src/Parallel/WorkStealingPool.h"
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Sums the values of a key range of an AVL and a SkipList of random keys: serially with forEach
+/// against parallelForEach on a WorkStealingPool for several numbers of threads, with one accumulator per worker
+/// Reports millions of pairs scanned per second and the speedup over the serial scan
+/// Options: --elements N (default 10000000), --max-threads N (default 8), --repetitions N (default 3)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int elements = (unsigned int)parseOption(argc, argv, "--elements", 10000000);
+	unsigned int maxThreads = (unsigned int)parseOption(argc, argv, "--max-threads", 8);
+	unsigned int repetitions = (unsigned int)parseOption(argc, argv, "--repetitions", 3);
+
+	KeyGenerator keys{ 19 };
+	std::vector<int> present = keys.uniqueKeys(elements);
+	AVL<int, int> tree;
+	SkipList<int, int> skipList{ elements };
+	for (const int& key : present) {
+		tree.insert(key, key & 0xff);
+		skipList.insert(key, key & 0xff);
+	}
+
+	//padded so the accumulators of different workers do not share a cache line
+	struct alignas(64) Accumulator {
+		long long sum;
+	};
+
+	//returns the best rate of the repetitions in millions of pairs per second and checks the sum against the serial one
+	long long expected = 0;
+	auto measure = [&](auto scan) {
+		double best = 0;
+		for (unsigned int r = 0; r < repetitions; r++) {
+			auto start = std::chrono::steady_clock::now();
+			long long sum = scan();
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (expected != 0 && sum != expected) {
+				std::cout << "the sum " << sum << " differs from the serial one " << expected << std::endl;
+			}
+			best = std::max(best, elements / seconds / 1e6);
+		}
+		return best;
+	};
+
+	std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+	std::cout << std::left << std::setw(10) << "Threads" << std::setw(12) << "Structure" << std::setw(14) << "Mpairs/s" << "speedup" << std::endl;
+
+	auto report = [](const std::string& threads, const char* structure, const double& rate, const double& serial) {
+		std::cout << std::left << std::setw(10) << threads << std::setw(12) << structure << std::setw(14)
+			<< std::fixed << std::setprecision(1) << rate << std::setprecision(2) << rate / serial << std::endl;
+	};
+
+	auto serialScan = [](const auto& structure) {
+		long long sum = 0;
+		structure.forEach([&sum](const int&, const int& value) { sum += value; });
+		return sum;
+	};
+	expected = serialScan(tree);
+	double serialAVL = measure([&]() { return serialScan(tree); });
+	double serialSkipList = measure([&]() { return serialScan(skipList); });
+	report("serial", "AVL", serialAVL, serialAVL);
+	report("serial", "SkipList", serialSkipList, serialSkipList);
+
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+		WorkStealingPool pool{ threads };
+		auto parallelScan = [&](const auto& structure) {
+			std::vector<Accumulator> accumulators(threads, Accumulator{ 0 });
+			structure.parallelForEach(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), [&accumulators](const int&, const int& value) {
+				accumulators[WorkStealingPool::workerIndex()].sum += value;
+			}, pool);
+
+			long long sum = 0;
+			for (const Accumulator& accumulator : accumulators) {
+				sum += accumulator.sum;
+			}
+			return sum;
+		};
+		report(std::to_string(threads), "AVL", measure([&]() { return parallelScan(tree); }), serialAVL);
+		report(std::to_string(threads), "SkipList", measure([&]() { return parallelScan(skipList); }), serialSkipList);
+	}
+
+	return 0;
+}
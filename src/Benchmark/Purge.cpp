@@ -0,0 +1,84 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/AVL/AVL.cpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
+#ifdef AVL_WAVL
+static const char* policy = "WAVL";
+#else
+static const char* policy = "AVL";
+#endif
+
+/// <summary>
+/// Prints the latency distribution and the rebalancing work of a phase of updates
+/// </summary>
+/// <param>const char* the name of the phase</param>
+/// <param>std::vector<double>& the duration of every update in nanoseconds, sorted by the function</param>
+/// <param>const AVL<int, int>& the tree whose counters were reset before the phase</param>
+void printPhase(const char* phase, const unsigned int& elements, std::vector<double>& latencies, const AVL<int, int>& tree) {
+	std::sort(latencies.begin(), latencies.end());
+	const AVL<int, int>::Stats& stats = tree.getStats();
+	double updates = (double)latencies.size();
+
+	std::cout << std::left << std::setw(8) << policy << std::setw(8) << phase << std::setw(10) << elements << std::fixed << std::setprecision(1)
+		<< std::setw(10) << mean(latencies) << std::setw(10) << percentile(latencies, 99) << std::setw(10) << percentile(latencies, 99.9)
+		<< std::setw(10) << latencies.back() << std::setprecision(3)
+		<< std::setw(12) << (stats.singleRotations + 2 * stats.doubleRotations) / updates
+		<< std::setw(12) << stats.averageRebalanceDepth() << std::setw(10) << stats.maxRebalanceDepth
+		<< std::setw(8) << tree.height() << std::endl;
+}
+
+/// <summary>
+/// Measures a delete-heavy workload on AVL with the balancing policy the executable was built with:
+/// a purge removing three quarters of the keys in random order, then churn removing a random key and inserting a new one
+/// The executable is built as Purge with the AVL policy and as PurgeWAVL with AVL_WAVL defined
+/// Reports nanoseconds per update (mean, p99, p99.9 and max, including the cost of reading the clock),
+/// rotations per update, nodes touched while rebalancing and the final height or rank of the root
+/// Options: --max-elements N (default 5000000)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+
+	std::cout << std::left << std::setw(8) << "Policy" << std::setw(8) << "Phase" << std::setw(10) << "Elements"
+		<< std::setw(10) << "mean" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max"
+		<< std::setw(12) << "rotations" << std::setw(12) << "rebalance" << std::setw(10) << "maxDepth" << std::setw(8) << "height" << std::endl;
+
+	for (unsigned int elements = 50000; elements <= maxElements; elements *= 10) {
+		KeyGenerator keys{ elements };
+		std::vector<int> present = keys.uniqueKeys(elements);
+		AVL<int, int> tree;
+		for (const int& key : present) {
+			tree.insert(key, key);
+		}
+
+		std::shuffle(present.begin(), present.end(), keys.engine());
+		std::vector<double> latencies;
+		latencies.reserve(elements);
+		tree.resetStats();
+
+		unsigned int purged = elements / 4 * 3;
+		for (unsigned int i = 0; i < purged; i++) {
+			auto start = std::chrono::steady_clock::now();
+			tree.remove(present[i]);
+			auto stop = std::chrono::steady_clock::now();
+			latencies.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+		}
+		printPhase("purge", elements, latencies, tree);
+
+		//the remaining keys are present[purged..], every step removes one of them and inserts a new key in its place
+		std::vector<int> inserted = keys.uniqueKeys(elements - purged);
+		latencies.clear();
+		tree.resetStats();
+		for (unsigned int i = 0; i < inserted.size(); i++) {
+			auto start = std::chrono::steady_clock::now();
+			tree.remove(present[purged + i]);
+			tree.insert(inserted[i], inserted[i]);
+			auto stop = std::chrono::steady_clock::now();
+			latencies.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+		}
+		printPhase("churn", elements, latencies, tree);
+	}
+
+	return 0;
+}
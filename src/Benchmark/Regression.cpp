@@ -0,0 +1,93 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/Benchmark/Regression.h"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Measures every operation of a structure at 50 to maxElements elements, as in the README table
+/// </summary>
+template<typename Structure>
+void measureStructure(const std::string& name, RegressionReport& report, const unsigned int& maxElements, const unsigned int& operationsCount, const unsigned int& repetitions, unsigned long long& found) {
+	for (unsigned int elements = 50; elements <= maxElements; elements *= 10) {
+		for (const char& operation : { 'i', 'c', 'r' }) {
+			report.results.push_back({ name, operation, elements, measureRepeated<Structure>(elements, operationsCount, operation, repetitions, found) });
+		}
+	}
+}
+
+/// <summary>
+/// Measures AVL and SkipList and compares the results with a stored baseline
+/// A measurement regresses when its mean is slower than the baseline by more than the threshold
+/// and a one-sided Welch's t-test rejects equal means at the given significance level
+/// Options:
+/// --baseline PATH (default benchmark/baseline.json), --output PATH (default regression_results.json)
+/// --threshold PERCENT (default 5), --significance P (default 0.01)
+/// --max-elements N (default 5000000), --operations N (default 10000), --repetitions N (default 10)
+/// --update-baseline replaces the baseline with the current results when there are no regressions
+/// Exits with 1 when there are regressions
+/// </summary>
+int main(int argc, char** argv) {
+	std::string baselinePath = parseTextOption(argc, argv, "--baseline", "benchmark/baseline.json");
+	std::string outputPath = parseTextOption(argc, argv, "--output", "regression_results.json");
+	double threshold = parseDecimalOption(argc, argv, "--threshold", 5);
+	double significance = parseDecimalOption(argc, argv, "--significance", 0.01);
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+	unsigned int operationsCount = (unsigned int)parseOption(argc, argv, "--operations", 10000);
+	unsigned int repetitions = (unsigned int)parseOption(argc, argv, "--repetitions", 10);
+	unsigned long long found = 0;
+
+	RegressionReport baseline;
+	bool hasBaseline = baseline.load(baselinePath);
+	if (!hasBaseline) {
+		std::cout << "No baseline at " << baselinePath << ", only recording the results" << std::endl;
+	}
+
+	RegressionReport current;
+	current.version = baseline.version + 1;
+	measureStructure<AVL<int, int>>("AVL", current, maxElements, operationsCount, repetitions, found);
+	measureStructure<SkipList<int, int>>("SkipList", current, maxElements, operationsCount, repetitions, found);
+
+	std::cout << std::left << std::setw(10) << "Structure" << std::setw(11) << "Operation" << std::setw(10) << "Elements"
+		<< std::setw(14) << "baseline ns" << std::setw(14) << "current ns" << std::setw(10) << "change %"
+		<< std::setw(10) << "p-value" << "status" << std::endl;
+
+	unsigned int regressions = 0;
+	for (const RegressionResult& result : current.results) {
+		const RegressionResult* previous = baseline.find(result.structure, result.operation, result.elements);
+		double currentMean = mean(result.samples);
+
+		std::cout << std::left << std::setw(10) << result.structure << std::setw(11) << result.operation << std::setw(10) << result.elements
+			<< std::fixed << std::setprecision(1);
+		if (!previous) {
+			std::cout << std::setw(14) << "-" << std::setw(14) << currentMean << std::setw(10) << "-" << std::setw(10) << "-" << "new" << std::endl;
+			continue;
+		}
+
+		double previousMean = mean(previous->samples);
+		double change = previousMean > 0 ? (currentMean - previousMean) / previousMean * 100 : 0;
+		double pValue = welchPValue(previous->samples, result.samples);
+		bool regressed = change > threshold && pValue < significance;
+		regressions += regressed;
+
+		std::cout << std::setw(14) << previousMean << std::setw(14) << currentMean << std::setw(10) << change
+			<< std::setprecision(4) << std::setw(10) << pValue << (regressed ? "REGRESSION" : "ok") << std::endl;
+	}
+
+	current.save(outputPath);
+	std::cout << "Keys found: " << found << std::endl;
+	std::cout << "Results version " << current.version << " written to " << outputPath << std::endl;
+
+	if (regressions) {
+		std::cout << regressions << " regression(s) beyond " << threshold << "% at significance " << significance << std::endl;
+		return 1;
+	}
+
+	if (hasFlag(argc, argv, "--update-baseline")) {
+		current.save(baselinePath);
+		std::cout << "Baseline " << baselinePath << " updated to version " << current.version << std::endl;
+	}
+
+	return 0;
+}
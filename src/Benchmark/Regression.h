@@ -0,0 +1,291 @@
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+#include<vector>
+#include<string>
+#include<cmath>
+#include<fstream>
+#include<sstream>
+#include<stdexcept>
+#include<cctype>
+
+/// <summary>
+/// The samples of one structure/operation/size measurement, each sample is the mean duration of an operation in nanoseconds
+/// </summary>
+struct RegressionResult {
+	std::string structure;
+	char operation;
+	unsigned int elements;
+	std::vector<double> samples;
+};
+
+/// <summary>
+/// A versioned set of measurements as stored in the baseline files
+/// </summary>
+struct RegressionReport {
+	static const int formatVersion = 1;
+
+	unsigned int version;
+	std::vector<RegressionResult> results;
+
+	RegressionReport() :
+		version(0) {}
+
+	/// <summary>
+	/// Finds the measurement of a structure, operation and size
+	/// </summary>
+	/// <return>const RegressionResult* the measurement or nullptr if it was not run</return>
+	const RegressionResult* find(const std::string& structure, const char& operation, const unsigned int& elements) const {
+		for (const RegressionResult& result : this->results) {
+			if (result.structure == structure && result.operation == operation && result.elements == elements) {
+				return &result;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/// <summary>
+	/// Writes the report as JSON
+	/// </summary>
+	/// <param>const std::string& the path of the file</param>
+	void save(const std::string& path) const {
+		std::ofstream out{ path };
+		if (!out) {
+			throw std::runtime_error("Cannot write " + path);
+		}
+
+		out.precision(17);
+		out << "{\n\t\"formatVersion\": " << RegressionReport::formatVersion << ",\n\t\"version\": " << this->version << ",\n\t\"results\": [";
+		for (size_t i = 0; i < this->results.size(); i++) {
+			const RegressionResult& result = this->results[i];
+			out << (i ? ",\n" : "\n") << "\t\t{ \"structure\": \"" << result.structure << "\", \"operation\": \"" << result.operation
+				<< "\", \"elements\": " << result.elements << ", \"samples\": [";
+			for (size_t j = 0; j < result.samples.size(); j++) {
+				out << (j ? ", " : "") << result.samples[j];
+			}
+			out << "] }";
+		}
+		out << "\n\t]\n}\n";
+	}
+
+	/// <summary>
+	/// Reads a report written by save
+	/// Only the subset of JSON produced by save is understood
+	/// </summary>
+	/// <param>const std::string& the path of the file</param>
+	/// <return>bool whether the file exists and was read</return>
+	bool load(const std::string& path) {
+		std::ifstream in{ path };
+		if (!in) {
+			return false;
+		}
+
+		std::stringstream buffer;
+		buffer << in.rdbuf();
+		std::string content = buffer.str();
+		JsonReader reader{ content };
+
+		this->results.clear();
+		reader.expect('{');
+		do {
+			std::string name = reader.readString();
+			reader.expect(':');
+			if (name == "formatVersion") {
+				if ((int)reader.readNumber() != RegressionReport::formatVersion) {
+					throw std::runtime_error("Unsupported format version of " + path);
+				}
+			} else if (name == "version") {
+				this->version = (unsigned int)reader.readNumber();
+			} else if (name == "results") {
+				reader.expect('[');
+				if (!reader.consume(']')) {
+					do {
+						this->results.push_back(reader.readResult());
+					} while (reader.consume(','));
+					reader.expect(']');
+				}
+			} else {
+				throw std::runtime_error("Unknown field " + name + " in " + path);
+			}
+		} while (reader.consume(','));
+		reader.expect('}');
+
+		return true;
+	}
+
+	private:
+		class JsonReader
+		{
+			private:
+				const std::string& text;
+				size_t position;
+
+				void skipWhitespace() {
+					while (this->position < this->text.size() && std::isspace((unsigned char)this->text[this->position])) {
+						this->position++;
+					}
+				}
+
+			public:
+				JsonReader(const std::string& _text) :
+					text(_text),
+					position(0) {}
+
+				bool consume(const char& symbol) {
+					this->skipWhitespace();
+					if (this->position < this->text.size() && this->text[this->position] == symbol) {
+						this->position++;
+						return true;
+					}
+
+					return false;
+				}
+
+				void expect(const char& symbol) {
+					if (!this->consume(symbol)) {
+						throw std::runtime_error(std::string("Malformed baseline, expected ") + symbol);
+					}
+				}
+
+				std::string readString() {
+					this->expect('"');
+					size_t end = this->text.find('"', this->position);
+					if (end == std::string::npos) {
+						throw std::runtime_error("Malformed baseline, unterminated string");
+					}
+
+					std::string result = this->text.substr(this->position, end - this->position);
+					this->position = end + 1;
+					return result;
+				}
+
+				double readNumber() {
+					this->skipWhitespace();
+					size_t length = 0;
+					double result = std::stod(this->text.substr(this->position, 32), &length);
+					this->position += length;
+					return result;
+				}
+
+				RegressionResult readResult() {
+					RegressionResult result;
+					this->expect('{');
+					do {
+						std::string name = this->readString();
+						this->expect(':');
+						if (name == "structure") {
+							result.structure = this->readString();
+						} else if (name == "operation") {
+							result.operation = this->readString()[0];
+						} else if (name == "elements") {
+							result.elements = (unsigned int)this->readNumber();
+						} else if (name == "samples") {
+							this->expect('[');
+							if (!this->consume(']')) {
+								do {
+									result.samples.push_back(this->readNumber());
+								} while (this->consume(','));
+								this->expect(']');
+							}
+						} else {
+							throw std::runtime_error("Unknown result field " + name);
+						}
+					} while (this->consume(','));
+					this->expect('}');
+
+					return result;
+				}
+		};
+};
+
+/// <summary>
+/// Regularized incomplete beta function I_x(a, b) evaluated by its continued fraction
+/// </summary>
+inline double incompleteBeta(const double& a, const double& b, const double& x) {
+	if (x <= 0) {
+		return 0;
+	}
+	if (x >= 1) {
+		return 1;
+	}
+
+	//the continued fraction converges quickly only for x < (a + 1) / (a + b + 2)
+	if (x > (a + 1) / (a + b + 2)) {
+		return 1 - incompleteBeta(b, a, 1 - x);
+	}
+
+	const double tiny = 1e-300;
+	double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1 - x)) / a;
+
+	//Lentz's algorithm
+	double c = 1, d = 1 - (a + b) * x / (a + 1);
+	d = 1 / (std::fabs(d) < tiny ? tiny : d);
+	double result = d;
+	for (int m = 1; m <= 300; m++) {
+		for (int step = 0; step < 2; step++) {
+			double numerator = step == 0
+				? m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m))
+				: -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1));
+
+			d = 1 + numerator * d;
+			d = 1 / (std::fabs(d) < tiny ? tiny : d);
+			c = 1 + numerator / c;
+			c = std::fabs(c) < tiny ? tiny : c;
+			result *= c * d;
+		}
+
+		if (std::fabs(c * d - 1) < 1e-12) {
+			break;
+		}
+	}
+
+	return front * result;
+}
+
+/// <summary>
+/// One-sided Welch's t-test for the hypothesis that the current samples have a larger mean than the baseline samples
+/// </summary>
+/// <param>const std::vector<double>& the baseline samples</param>
+/// <param>const std::vector<double>& the current samples</param>
+/// <return>double the p-value, 1 if there are not enough samples</return>
+inline double welchPValue(const std::vector<double>& baseline, const std::vector<double>& current) {
+	if (baseline.size() < 2 || current.size() < 2) {
+		return 1;
+	}
+
+	auto moments = [](const std::vector<double>& samples, double& average, double& variance) {
+		average = 0;
+		for (const double& sample : samples) {
+			average += sample;
+		}
+		average /= samples.size();
+
+		variance = 0;
+		for (const double& sample : samples) {
+			variance += (sample - average) * (sample - average);
+		}
+		variance /= samples.size() - 1;
+	};
+
+	double baselineMean, baselineVariance, currentMean, currentVariance;
+	moments(baseline, baselineMean, baselineVariance);
+	moments(current, currentMean, currentVariance);
+
+	double baselineError = baselineVariance / baseline.size();
+	double currentError = currentVariance / current.size();
+	double error = baselineError + currentError;
+	if (error <= 0) {
+		return currentMean > baselineMean ? 0 : 1;
+	}
+
+	double t = (currentMean - baselineMean) / std::sqrt(error);
+	double degreesOfFreedom = error * error /
+		(baselineError * baselineError / (baseline.size() - 1) + currentError * currentError / (current.size() - 1));
+
+	//P(T > t) for Student's t distribution
+	double tail = 0.5 * incompleteBeta(degreesOfFreedom / 2, 0.5, degreesOfFreedom / (degreesOfFreedom + t * t));
+	return t > 0 ? tail : 1 - tail;
+}
+
+#endif
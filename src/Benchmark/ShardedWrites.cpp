@@ -0,0 +1,94 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/ShardedMap/ShardedMap.cpp"
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Measures insert throughput as writer threads are added: an AVL behind one global mutex against a ShardedMap of AVL
+/// shards split evenly over the key range, and against a ShardedMap whose split keys all lie below the keys, so every
+/// insert starts in the last shard and the map spreads the keys by online rebalancing
+/// Every thread inserts its own share of unique random keys
+/// Options: --elements N (default 2000000), --shards N (default 16), --max-threads N (default 8)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int elements = (unsigned int)parseOption(argc, argv, "--elements", 2000000);
+	unsigned int shardsCount = (unsigned int)parseOption(argc, argv, "--shards", 16);
+	unsigned int maxThreads = (unsigned int)parseOption(argc, argv, "--max-threads", 8);
+
+	KeyGenerator keys{ 11 };
+	std::vector<int> inserted = keys.uniqueKeys(elements);
+	//the generated keys are uniform over the non-negative ints
+	std::vector<int> evenSplits, lowSplits;
+	for (unsigned int i = 1; i < shardsCount; i++) {
+		evenSplits.push_back((int)(0x7fffffffLL * i / shardsCount));
+		lowSplits.push_back(-(int)(shardsCount - i));
+	}
+
+	std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+	std::cout << std::left << std::setw(10) << "Threads" << std::setw(20) << "Structure" << std::setw(14) << "inserts/s"
+		<< "largest shard %" << std::endl;
+
+	//runs the inserts split across the threads, returning inserts per second
+	auto run = [&](const unsigned int& threadsCount, auto insert) {
+		std::vector<std::thread> threads;
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < threadsCount; t++) {
+			threads.emplace_back([&, t]() {
+				for (size_t i = t; i < inserted.size(); i += threadsCount) {
+					insert(inserted[i]);
+				}
+			});
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		return elements / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	auto report = [](const unsigned int& threadsCount, const char* structure, const double& rate, const std::string& largest) {
+		std::cout << std::left << std::setw(10) << threadsCount << std::setw(20) << structure << std::fixed << std::setprecision(0)
+			<< std::setw(14) << rate << largest << std::endl;
+	};
+
+	auto largestShare = [&elements](const std::vector<size_t>& sizes) {
+		size_t largest = 0;
+		for (const size_t& size : sizes) {
+			largest = std::max(largest, size);
+		}
+		return std::to_string(100 * largest / elements);
+	};
+
+	for (unsigned int threadsCount = 1; threadsCount <= maxThreads; threadsCount *= 2) {
+		{
+			AVL<int, int> tree;
+			std::mutex mutex;
+			double rate = run(threadsCount, [&](const int& key) {
+				std::lock_guard<std::mutex> lock(mutex);
+				tree.insert(key, key);
+			});
+			report(threadsCount, "AVL+lock", rate, "-");
+		}
+
+		{
+			ShardedMap<int, int> map{ evenSplits };
+			double rate = run(threadsCount, [&](const int& key) {
+				map.insert(key, key);
+			});
+			report(threadsCount, "ShardedMap", rate, largestShare(map.shardSizes()));
+		}
+
+		{
+			ShardedMap<int, int> map{ lowSplits };
+			double rate = run(threadsCount, [&](const int& key) {
+				map.insert(key, key);
+			});
+			report(threadsCount, "ShardedMap skewed", rate, largestShare(map.shardSizes()));
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,119 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/MVCCSkipList/MVCCSkipList.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <iostream>
+#include <iomanip>
+
+/// <summary>
+/// Runs full scans in one thread while another thread updates random keys, for a fixed time
+/// The MVCCSkipList scans a snapshot and the writer collects old versions every 64k updates, the SkipList is guarded
+/// by a mutex held for a whole scan and every update, as a single-version structure must be to give scans a consistent view
+/// Reports scans per second, updates per second during the scans and the longest wait of an update
+/// Options: --elements N (default 1000000), --seconds N (default 5)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int elements = (unsigned int)parseOption(argc, argv, "--elements", 1000000);
+	double seconds = (double)parseOption(argc, argv, "--seconds", 5);
+
+	KeyGenerator keys{ elements };
+	std::vector<int> inserted = keys.uniqueKeys(elements);
+
+	std::cout << std::left << std::setw(14) << "Structure" << std::setw(12) << "scans/s" << std::setw(14) << "updates/s"
+		<< "max update wait ms" << std::endl;
+
+	auto report = [](const char* structure, const unsigned int& scans, const std::uint64_t& updates, const double& elapsed, const double& maxWait) {
+		std::cout << std::left << std::setw(14) << structure << std::fixed << std::setprecision(2) << std::setw(12) << scans / elapsed
+			<< std::setprecision(0) << std::setw(14) << updates / elapsed << std::setprecision(2) << maxWait << std::endl;
+	};
+
+	//runs the writer until the scans stop, returning the updates and the longest single update
+	auto runWriter = [&](auto update, std::atomic<bool>& stopping, std::uint64_t& updates, double& maxWait) {
+		std::default_random_engine engine{ 7 };
+		while (!stopping) {
+			int key = inserted[engine() % elements];
+			auto start = std::chrono::steady_clock::now();
+			update(key, (int)updates);
+			maxWait = std::max(maxWait, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+			updates++;
+		}
+	};
+
+	{
+		MVCCSkipList<int, int> list{ elements * 2 };
+		for (const int& key : inserted) {
+			list.insert(key, key);
+		}
+
+		std::atomic<bool> stopping{ false };
+		std::uint64_t updates = 0;
+		double maxWait = 0;
+		std::thread writer([&]() {
+			runWriter([&list, &updates](const int& key, const int& value) {
+				list.insert(key, value);
+				if ((updates & 0xffff) == 0xffff) {
+					list.gc();
+				}
+			}, stopping, updates, maxWait);
+		});
+
+		unsigned int scans = 0;
+		std::uint64_t sum = 0;
+		auto start = std::chrono::steady_clock::now();
+		while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < seconds) {
+			auto snapshot = list.snapshot();
+			list.forEach(snapshot, [&sum](const int&, const int& value) {
+				sum += value;
+			});
+			scans++;
+		}
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		stopping = true;
+		writer.join();
+		report("MVCCSkipList", scans, updates, elapsed, maxWait);
+		if (sum == 0) {
+			std::cout << "empty scans" << std::endl;
+		}
+	}
+
+	{
+		SkipList<int, int> list{ elements };
+		std::mutex mutex;
+		for (const int& key : inserted) {
+			list.insert(key, key);
+		}
+
+		std::atomic<bool> stopping{ false };
+		std::uint64_t updates = 0;
+		double maxWait = 0;
+		std::thread writer([&]() {
+			runWriter([&list, &mutex](const int& key, const int& value) {
+				std::lock_guard<std::mutex> lock(mutex);
+				list.insert(key, value);
+			}, stopping, updates, maxWait);
+		});
+
+		unsigned int scans = 0;
+		std::uint64_t sum = 0;
+		auto start = std::chrono::steady_clock::now();
+		while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < seconds) {
+			std::lock_guard<std::mutex> lock(mutex);
+			list.forEach([&sum](const int&, const int& value) {
+				sum += value;
+			});
+			scans++;
+		}
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		stopping = true;
+		writer.join();
+		report("SkipList+lock", scans, updates, elapsed, maxWait);
+		if (sum == 0) {
+			std::cout << "empty scans" << std::endl;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/AVL/AVL.cpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/// <summary>
+/// Drops the cached pages of a file, so the next mapping reads them from the disk
+/// Only done on POSIX systems, elsewhere the pages stay cached
+/// </summary>
+void evictFromCache(const char* path) {
+#ifndef _WIN32
+	int descriptor = open(path, O_RDONLY);
+	if (descriptor >= 0) {
+		fdatasync(descriptor);
+		posix_fadvise(descriptor, 0, 0, POSIX_FADV_DONTNEED);
+		close(descriptor);
+	}
+#endif
+}
+
+/// <summary>
+/// Measures how long a process takes to serve its first lookups from a stored AVL:
+/// rebuilding the tree by inserting all pairs again against memory-mapping an image written by saveTo
+/// The image is evicted from the page cache before it is mapped, so the mapped lookups include reading their pages
+/// Reports milliseconds until the tree is ready and until the first --lookups random lookups are done, and the image size
+/// Options: --max-elements N (default 5000000), --lookups N (default 10000), --path FILE (default AVLStartup.bin)
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+	unsigned int lookupsCount = (unsigned int)parseOption(argc, argv, "--lookups", 10000);
+	std::string path = "AVLStartup.bin";
+	for (int i = 1; i + 1 < argc; i++) {
+		if (std::string(argv[i]) == "--path") {
+			path = argv[i + 1];
+		}
+	}
+
+	std::cout << std::left << std::setw(10) << "Elements" << std::setw(10) << "Start"
+		<< std::setw(14) << "ready ms" << std::setw(14) << "lookups ms" << std::setw(12) << "found" << "image MB" << std::endl;
+
+	for (unsigned int elements = 50000; elements <= maxElements; elements *= 10) {
+		KeyGenerator keys{ elements };
+		std::vector<int> present = keys.uniqueKeys(elements);
+		std::vector<int> lookups;
+		for (unsigned int i = 0; i < lookupsCount; i++) {
+			lookups.push_back(present[keys.engine()() % elements]);
+		}
+
+		AVL<int, int> stored;
+		for (const int& key : present) {
+			stored.insert(key, key);
+		}
+		stored.saveTo(path);
+		evictFromCache(path.c_str());
+		double imageMegabytes = (double)std::ifstream(path, std::ios::binary | std::ios::ate).tellg() / (1 << 20);
+
+		auto report = [&](const char* start, double ready, double total, unsigned int found) {
+			std::cout << std::left << std::setw(10) << elements << std::setw(10) << start << std::fixed << std::setprecision(2)
+				<< std::setw(14) << ready << std::setw(14) << total << std::setw(12) << found
+				<< imageMegabytes << std::endl;
+		};
+
+		{
+			auto start = std::chrono::steady_clock::now();
+			AVL<int, int>::Mapped mapped = AVL<int, int>::mapFrom(path);
+			auto ready = std::chrono::steady_clock::now();
+			unsigned int found = 0;
+			for (const int& key : lookups) {
+				found += mapped.contains(key);
+			}
+			auto stop = std::chrono::steady_clock::now();
+			report("mapped", std::chrono::duration<double, std::milli>(ready - start).count(),
+				std::chrono::duration<double, std::milli>(stop - start).count(), found);
+		}
+
+		{
+			//the pairs are already in memory, so the rebuild excludes reading them from a file
+			auto start = std::chrono::steady_clock::now();
+			AVL<int, int> rebuilt;
+			for (const int& key : present) {
+				rebuilt.insert(key, key);
+			}
+			auto ready = std::chrono::steady_clock::now();
+			unsigned int found = 0;
+			for (const int& key : lookups) {
+				found += rebuilt.contains(key);
+			}
+			auto stop = std::chrono::steady_clock::now();
+			report("rebuilt", std::chrono::duration<double, std::milli>(ready - start).count(),
+				std::chrono::duration<double, std::milli>(stop - start).count(), found);
+		}
+	}
+
+	std::remove(path.c_str());
+
+	return 0;
+}
@@ -0,0 +1,360 @@
+#include "src/Benchmark/Benchmark.h"
+#include "src/Benchmark/MemoryCounter.h"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include "src/BPlusTree/BPlusTree.cpp"
+#include "src/UnrolledSkipList/UnrolledSkipList.cpp"
+#include "src/CompactAVL/CompactAVL.cpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+/// <summary>
+/// Prints the mean duration of an operation for a structure in the format of the README table
+/// </summary>
+template<typename Structure>
+void runStructure(const char* name, const unsigned int& elements, const unsigned int& operationsCount, const unsigned int& repetitions, unsigned long long& found) {
+	std::cout << std::left << std::setw(18) << name << std::setw(10) << elements;
+	for (const char& operation : { 'i', 'c', 'r' }) {
+		std::vector<double> samples = measureRepeated<Structure>(elements, operationsCount, operation, repetitions, found);
+		std::cout << std::setw(14) << std::fixed << std::setprecision(1) << mean(samples);
+	}
+	std::cout << std::endl;
+}
+
+/// <summary>
+/// Measures the heap bytes per key of a structure holding the present keys of a workload
+/// </summary>
+template<typename Structure>
+double measureBytesPerKey(const Workload& workload) {
+	long long before = allocatedBytes().load();
+	Structure* structure = StructureFactory<Structure>::create((unsigned int)workload.present.size());
+	for (const int& key : workload.present) {
+		structure->insert(key, key);
+	}
+	long long after = allocatedBytes().load();
+	delete structure;
+
+	return workload.present.empty() ? 0 : (double)(after - before) / workload.present.size();
+}
+
+/// <summary>
+/// Prints throughput, tail latency and memory of a structure for the insert/contains/remove workloads
+/// Every structure receives identical keys as the workloads are seeded the same way
+/// </summary>
+template<typename Structure>
+void compareStructure(const char* name, const unsigned int& elements, const unsigned int& operationsCount, unsigned long long& found) {
+	double bytesPerKey = measureBytesPerKey<Structure>(Workload{ elements, 0, 'i', 1 });
+
+	for (const char& operation : { 'i', 'c', 'r' }) {
+		Workload workload{ elements, operationsCount, operation, 1 };
+		double nanoseconds = measureOperation<Structure>(workload, operation, found);
+		std::vector<double> latencies = measureLatencies<Structure>(workload, operation, found);
+
+		std::cout << std::left << std::setw(22) << name << std::setw(10) << elements << std::setw(11) << operation
+			<< std::fixed << std::setprecision(2) << std::setw(10) << (nanoseconds > 0 ? 1000 / nanoseconds : 0)
+			<< std::setprecision(0) << std::setw(10) << percentile(latencies, 50)
+			<< std::setw(10) << percentile(latencies, 99)
+			<< std::setw(10) << percentile(latencies, 99.9)
+			<< std::setprecision(1) << std::setw(10) << bytesPerKey << std::endl;
+	}
+}
+
+/// <summary>
+/// Runs identical workloads against the project structures and the standard library containers
+/// Reports throughput in millions of operations per second, latency percentiles in nanoseconds
+/// (including the cost of reading the clock) and requested heap bytes per key
+/// </summary>
+void runComparison(const unsigned int& maxElements, const unsigned int& operationsCount, unsigned long long& found) {
+	std::cout << std::left << std::setw(22) << "Structure" << std::setw(10) << "Elements" << std::setw(11) << "Operation"
+		<< std::setw(10) << "Mops/s" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+		<< std::setw(10) << "bytes/key" << std::endl;
+
+	for (unsigned int elements = 50; elements <= maxElements; elements *= 10) {
+		compareStructure<AVL<int, int>>("AVL", elements, operationsCount, found);
+		compareStructure<CompactAVL<int, int>>("CompactAVL", elements, operationsCount, found);
+		compareStructure<SkipList<int, int>>("SkipList", elements, operationsCount, found);
+		compareStructure<BPlusTree<int, int>>("BPlusTree", elements, operationsCount, found);
+		compareStructure<UnrolledSkipList<int, int>>("UnrolledSkipList", elements, operationsCount, found);
+		compareStructure<StdAdapter<std::map<int, int>>>("std::map", elements, operationsCount, found);
+		compareStructure<StdAdapter<std::unordered_map<int, int>>>("std::unordered_map", elements, operationsCount, found);
+		compareStructure<StdAdapter<std::set<int>>>("std::set (keys only)", elements, operationsCount, found);
+	}
+}
+
+/// <summary>
+/// Measures the mean duration per key of a full in-order scan of a structure holding the present keys of a workload
+/// </summary>
+template<typename Structure>
+double measureScan(const Workload& workload, const unsigned int& repetitions, unsigned long long& found) {
+	Structure* structure = StructureFactory<Structure>::create((unsigned int)workload.present.size());
+	for (const int& key : workload.present) {
+		structure->insert(key, key);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < repetitions; i++) {
+		structure->forEach([&found](const int&, const int& value) {
+			found += value & 1;
+		});
+	}
+	auto stop = std::chrono::steady_clock::now();
+	delete structure;
+
+	double nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+	return workload.present.empty() ? 0 : nanoseconds / repetitions / workload.present.size();
+}
+
+/// <summary>
+/// Prints the scan cost per key of the skip list and the unrolled skip list
+/// </summary>
+void runScans(const unsigned int& maxElements, const unsigned int& repetitions, unsigned long long& found) {
+	std::cout << "Mean duration of a full scan per key in nanoseconds" << std::endl;
+	std::cout << std::left << std::setw(10) << "Elements" << std::setw(14) << "SkipList" << std::setw(18) << "UnrolledSkipList" << std::endl;
+
+	for (unsigned int elements = 50; elements <= maxElements; elements *= 10) {
+		Workload workload{ elements, 0, 'i', 1 };
+		std::cout << std::left << std::setw(10) << elements << std::fixed << std::setprecision(2)
+			<< std::setw(14) << measureScan<SkipList<int, int>>(workload, repetitions, found)
+			<< std::setw(18) << measureScan<UnrolledSkipList<int, int>>(workload, repetitions, found) << std::endl;
+	}
+}
+
+/// <summary>
+/// Prints the mean duration of contains called key by key and of containsBatch over the same keys
+/// The two passes alternate which one runs first, so neither is always the one warming the caches for the other
+/// </summary>
+template<typename Structure>
+void compareBatch(const char* name, const unsigned int& elements, const unsigned int& operationsCount, const unsigned int& repetitions, unsigned long long& found) {
+	Workload workload{ elements, operationsCount, 'c', 1 };
+	Structure* structure = StructureFactory<Structure>::create(elements);
+	for (const int& key : workload.present) {
+		structure->insert(key, key);
+	}
+
+	//the keys are passed in batches of 1024, as a join would pass its input
+	std::vector<std::vector<int>> batches;
+	for (size_t i = 0; i < workload.operations.size(); i += 1024) {
+		batches.emplace_back(workload.operations.begin() + i, workload.operations.begin() + std::min(workload.operations.size(), i + 1024));
+	}
+	std::vector<bool> results;
+
+	auto singlePass = [&]() {
+		auto start = std::chrono::steady_clock::now();
+		for (const int& key : workload.operations) {
+			found += structure->contains(key);
+		}
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	};
+	auto batchPass = [&]() {
+		auto start = std::chrono::steady_clock::now();
+		for (const std::vector<int>& batch : batches) {
+			structure->containsBatch(batch, results);
+			for (const bool& result : results) {
+				found += result;
+			}
+		}
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	long long singleNanoseconds = 0;
+	long long batchNanoseconds = 0;
+	for (unsigned int r = 0; r < repetitions; r++) {
+		if (r % 2 == 0) {
+			singleNanoseconds += singlePass();
+			batchNanoseconds += batchPass();
+		} else {
+			batchNanoseconds += batchPass();
+			singleNanoseconds += singlePass();
+		}
+	}
+	delete structure;
+
+	double single = (double)singleNanoseconds / repetitions / operationsCount;
+	double batched = (double)batchNanoseconds / repetitions / operationsCount;
+	std::cout << std::left << std::setw(10) << name << std::setw(10) << elements << std::fixed << std::setprecision(1)
+		<< std::setw(10) << single << std::setw(10) << batched << std::setprecision(2) << std::setw(10) << single / batched << std::endl;
+}
+
+/// <summary>
+/// Prints the cost of a lookup with contains and with containsBatch on AVL and SkipList
+/// </summary>
+void runBatches(const unsigned int& maxElements, const unsigned int& operationsCount, const unsigned int& repetitions, unsigned long long& found) {
+	std::cout << "Mean duration of a lookup in nanoseconds" << std::endl;
+	std::cout << std::left << std::setw(10) << "Structure" << std::setw(10) << "Elements" << std::setw(10) << "contains"
+		<< std::setw(10) << "batch" << std::setw(10) << "speedup" << std::endl;
+
+	for (unsigned int elements = 50; elements <= maxElements; elements *= 10) {
+		compareBatch<AVL<int, int>>("AVL", elements, operationsCount, repetitions, found);
+		compareBatch<SkipList<int, int>>("SkipList", elements, operationsCount, repetitions, found);
+	}
+}
+
+/// <summary>
+/// Prints the mean duration of inserting sorted batches into a skip list key by key and with insertSorted
+/// </summary>
+void compareSortedInsert(const unsigned int& elements, const unsigned int& operationsCount) {
+	Workload workload{ elements, operationsCount, 'i', 1 };
+	std::vector<std::pair<int, int>> pairs;
+	for (const int& key : workload.operations) {
+		pairs.emplace_back(key, key);
+	}
+	std::sort(pairs.begin(), pairs.end());
+
+	double durations[2];
+	for (int sorted = 0; sorted < 2; sorted++) {
+		SkipList<int, int> skipList{ elements + operationsCount };
+		for (const int& key : workload.present) {
+			skipList.insert(key, key);
+		}
+
+		//the sorted keys arrive in batches of 1024, as an ingestion would deliver them
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < pairs.size(); i += 1024) {
+			auto last = pairs.begin() + std::min(pairs.size(), i + 1024);
+			if (sorted) {
+				skipList.insertSorted(pairs.begin() + i, last);
+			} else {
+				for (auto pair = pairs.begin() + i; pair != last; ++pair) {
+					skipList.insert(pair->first, pair->second);
+				}
+			}
+		}
+		auto stop = std::chrono::steady_clock::now();
+		durations[sorted] = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / operationsCount;
+	}
+
+	std::cout << std::left << std::setw(10) << elements << std::fixed << std::setprecision(1)
+		<< std::setw(10) << durations[0] << std::setw(14) << durations[1] << std::setprecision(2) << std::setw(10) << durations[0] / durations[1] << std::endl;
+}
+
+/// <summary>
+/// Prints the cost of inserting sorted keys into SkipList with insert and with insertSorted
+/// </summary>
+void runSortedInserts(const unsigned int& maxElements, const unsigned int& operationsCount) {
+	std::cout << "Mean duration of a sorted insert into SkipList in nanoseconds" << std::endl;
+	std::cout << std::left << std::setw(10) << "Elements" << std::setw(10) << "insert" << std::setw(14) << "insertSorted"
+		<< std::setw(10) << "speedup" << std::endl;
+
+	for (unsigned int elements = 50; elements <= maxElements; elements *= 10) {
+		compareSortedInsert(elements, operationsCount);
+	}
+}
+
+/// <summary>
+/// Prints the mean duration of localized accesses to an AVL tree from the root and through a finger:
+/// lookups of sorted keys and inserts of ascending keys above the largest one, as time-ordered data arrives
+/// </summary>
+void compareFinger(const unsigned int& elements, const unsigned int& operationsCount, unsigned long long& found) {
+	Workload workload{ elements, operationsCount, 'c', 1 };
+	std::vector<int> lookups = workload.operations;
+	std::sort(lookups.begin(), lookups.end());
+	int largest = *std::max_element(workload.present.begin(), workload.present.end());
+
+	double durations[4];
+	for (int useFinger = 0; useFinger < 2; useFinger++) {
+		AVL<int, int> tree;
+		for (const int& key : workload.present) {
+			tree.insert(key, key);
+		}
+		AVL<int, int>::Finger finger = tree.finger();
+
+		auto start = std::chrono::steady_clock::now();
+		for (const int& key : lookups) {
+			found += useFinger ? finger.contains(key) : tree.contains(key);
+		}
+		auto middle = std::chrono::steady_clock::now();
+		for (unsigned int i = 1; i <= operationsCount; i++) {
+			if (useFinger) {
+				finger.insert(largest + (int)i, 0);
+			} else {
+				tree.insert(largest + (int)i, 0);
+			}
+		}
+		auto stop = std::chrono::steady_clock::now();
+
+		durations[useFinger] = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(middle - start).count() / operationsCount;
+		durations[2 + useFinger] = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - middle).count() / operationsCount;
+	}
+
+	std::cout << std::left << std::setw(10) << elements << std::fixed << std::setprecision(1);
+	for (const double& duration : durations) {
+		std::cout << std::setw(10) << duration;
+	}
+	std::cout << std::endl;
+}
+
+/// <summary>
+/// Prints the cost of sorted lookups and ascending inserts on AVL from the root and through a finger
+/// </summary>
+void runFingers(const unsigned int& maxElements, const unsigned int& operationsCount, unsigned long long& found) {
+	std::cout << "Mean duration of a localized operation on AVL in nanoseconds" << std::endl;
+	std::cout << std::left << std::setw(10) << "Elements" << std::setw(10) << "contains" << std::setw(10) << "finger"
+		<< std::setw(10) << "insert" << std::setw(10) << "finger" << std::endl;
+
+	for (unsigned int elements = 50; elements <= maxElements; elements *= 10) {
+		compareFinger(elements, operationsCount, found);
+	}
+}
+
+/// <summary>
+/// Runs the insert/contains/remove workload of the README table on AVL, SkipList, BPlusTree, UnrolledSkipList and CompactAVL
+/// The same workload is used as the training run of the profile-guided optimization build
+/// Options: --max-elements N (default 5000000), --operations N (default 10000), --repetitions N (default 10)
+/// --compare runs the comparison with the standard library containers instead, --scan measures full in-order scans,
+/// --batch compares contains with containsBatch, --sorted compares insert with insertSorted on sorted batches,
+/// --finger compares localized AVL accesses from the root and through a finger
+/// </summary>
+int main(int argc, char** argv) {
+	unsigned int maxElements = (unsigned int)parseOption(argc, argv, "--max-elements", 5000000);
+	unsigned int operationsCount = (unsigned int)parseOption(argc, argv, "--operations", 10000);
+	unsigned int repetitions = (unsigned int)parseOption(argc, argv, "--repetitions", 10);
+	unsigned long long found = 0;
+
+	if (hasFlag(argc, argv, "--compare")) {
+		runComparison(maxElements, operationsCount, found);
+		std::cout << "Keys found: " << found << std::endl;
+		return 0;
+	}
+
+	if (hasFlag(argc, argv, "--batch")) {
+		runBatches(maxElements, operationsCount, repetitions, found);
+		std::cout << "Keys found: " << found << std::endl;
+		return 0;
+	}
+
+	if (hasFlag(argc, argv, "--finger")) {
+		runFingers(maxElements, operationsCount, found);
+		std::cout << "Keys found: " << found << std::endl;
+		return 0;
+	}
+
+	if (hasFlag(argc, argv, "--sorted")) {
+		runSortedInserts(maxElements, operationsCount);
+		return 0;
+	}
+
+	if (hasFlag(argc, argv, "--scan")) {
+		runScans(maxElements, repetitions, found);
+		std::cout << "Keys found: " << found << std::endl;
+		return 0;
+	}
+
+	std::cout << "Mean duration of an operation in nanoseconds" << std::endl;
+	std::cout << std::left << std::setw(18) << "Structure" << std::setw(10) << "Elements"
+		<< std::setw(14) << "insert" << std::setw(14) << "contains" << std::setw(14) << "remove" << std::endl;
+
+	for (unsigned int elements = 50; elements <= maxElements; elements *= 10) {
+		runStructure<AVL<int, int>>("AVL", elements, operationsCount, repetitions, found);
+		runStructure<SkipList<int, int>>("SkipList", elements, operationsCount, repetitions, found);
+		runStructure<BPlusTree<int, int>>("BPlusTree", elements, operationsCount, repetitions, found);
+		runStructure<UnrolledSkipList<int, int>>("UnrolledSkipList", elements, operationsCount, repetitions, found);
+		runStructure<CompactAVL<int, int>>("CompactAVL", elements, operationsCount, repetitions, found);
+	}
+
+	std::cout << "Keys found: " << found << std::endl;
+	return 0;
+}
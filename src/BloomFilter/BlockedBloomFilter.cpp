@@ -0,0 +1,104 @@
+#include "BlockedBloomFilter.h"
+#include "../Simd/BloomBlock.h"
+#include <algorithm>
+#include <functional>
+#include <cstring>
+
+template<typename Key>
+const std::uint32_t BlockedBloomFilter<Key>::salts[lanesCount] = {
+	0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u,
+	0x8ebc2b4fu, 0x6ae5c3d1u, 0x3f9b6c2bu, 0xd1b54a33u, 0x2545f491u, 0x9e3779b1u, 0x7feb352du, 0x846ca68bu
+};
+
+template<typename Key>
+BlockedBloomFilter<Key>::BlockedBloomFilter(const unsigned int& expectedElements, const unsigned int& _bitsPerKey) :
+	bitsPerKey(_bitsPerKey)
+{
+	this->reset(expectedElements);
+}
+
+template<typename Key>
+std::uint64_t BlockedBloomFilter<Key>::hash(const Key& key) {
+	std::uint64_t h = (std::uint64_t)std::hash<Key>{}(key);
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ull;
+	h ^= h >> 33;
+
+	return h;
+}
+
+//the high half of the hash is mapped to [0, blocks) by a multiplication instead of a division
+template<typename Key>
+typename BlockedBloomFilter<Key>::Block& BlockedBloomFilter<Key>::blockOf(const std::uint64_t& h) {
+	return this->blocks[(size_t)(((h >> 32) * this->blocks.size()) >> 32)];
+}
+
+template<typename Key>
+const typename BlockedBloomFilter<Key>::Block& BlockedBloomFilter<Key>::blockOf(const std::uint64_t& h) const {
+	return this->blocks[(size_t)(((h >> 32) * this->blocks.size()) >> 32)];
+}
+
+template<typename Key>
+void BlockedBloomFilter<Key>::add(const Key& key) {
+	static const SimdKernels::BloomInsert kernel = SimdKernels::selectBloomInsert();
+
+	std::uint64_t h = hash(key);
+	Block& block = this->blockOf(h);
+	if (kernel) {
+		kernel(block.lanes, (std::uint32_t)h, salts);
+		return;
+	}
+
+	for (unsigned int i = 0; i < lanesCount; i++) {
+		block.lanes[i] |= 1u << (((std::uint32_t)h * salts[i]) >> 27);
+	}
+}
+
+template<typename Key>
+bool BlockedBloomFilter<Key>::mayContain(const Key& key) const {
+	static const SimdKernels::BloomProbe kernel = SimdKernels::selectBloomProbe();
+
+	std::uint64_t h = hash(key);
+	const Block& block = this->blockOf(h);
+	if (kernel) {
+		return kernel(block.lanes, (std::uint32_t)h, salts);
+	}
+
+	for (unsigned int i = 0; i < lanesCount; i++) {
+		if (!(block.lanes[i] & (1u << (((std::uint32_t)h * salts[i]) >> 27)))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename Key>
+void BlockedBloomFilter<Key>::reset(const unsigned int& expectedElements) {
+	size_t blocksCount = std::max<size_t>(1, ((size_t)expectedElements * this->bitsPerKey + blockBits - 1) / blockBits);
+	this->blocks.assign(blocksCount, Block{});
+}
+
+template<typename Key>
+size_t BlockedBloomFilter<Key>::sizeInBytes() const {
+	return this->blocks.size() * sizeof(Block);
+}
+
+template<typename Key>
+const void* BlockedBloomFilter<Key>::data() const {
+	return this->blocks.data();
+}
+
+template<typename Key>
+bool BlockedBloomFilter<Key>::assign(const void* bytes, const size_t& count) {
+	if (count == 0 || count % sizeof(Block) != 0) {
+		return false;
+	}
+
+	this->blocks.resize(count / sizeof(Block));
+	std::memcpy(this->blocks.data(), bytes, count);
+
+	return true;
+}
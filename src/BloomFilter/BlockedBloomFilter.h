@@ -0,0 +1,90 @@
+#ifndef BLOCKEDBLOOMFILTER_H
+#define BLOCKEDBLOOMFILTER_H
+
+#include<vector>
+#include<cstdint>
+#include<cstddef>
+
+/// <summary>
+/// A template class representing a blocked Bloom filter - a set of keys answering "maybe present" or "surely absent"
+/// Every key maps to a single cache-line-sized block and sets one bit in each of its 16 lanes,
+/// so adding and testing a key touch one cache line and are done with a few vector instructions
+/// Keys cannot be removed, the filter is cleared and refilled instead
+/// </summary>
+template<typename Key>
+class BlockedBloomFilter
+{
+	private:
+		static constexpr unsigned int lanesCount = 16;
+		static constexpr unsigned int blockBits = lanesCount * 32;
+
+		struct alignas(64) Block {
+			std::uint32_t lanes[lanesCount];
+		};
+
+		/// <summary>
+		/// Odd multipliers spreading the key hash over the lanes
+		/// </summary>
+		static const std::uint32_t salts[lanesCount];
+
+		/// <summary>
+		/// Hashes a key with std::hash and mixes the result, as std::hash of an integer is often the identity
+		/// </summary>
+		/// <return>std::uint64_t the high half selects the block, the low half the bits inside it</return>
+		static std::uint64_t hash(const Key&);
+
+		/// <summary>
+		/// Finds the block of a key hash
+		/// </summary>
+		Block& blockOf(const std::uint64_t&);
+		const Block& blockOf(const std::uint64_t&) const;
+
+		std::vector<Block> blocks;
+		unsigned int bitsPerKey;
+	public:
+		/// <summary>
+		/// Creates an empty filter sized for a number of keys
+		/// </summary>
+		/// <param>const unsigned int& the expected number of keys</param>
+		/// <param>const unsigned int& the bits per expected key, default is 16 for a false positive rate of about 0.2%</param>
+		BlockedBloomFilter(const unsigned int&, const unsigned int& = 16);
+
+		/// <summary>
+		/// Adds a key to the filter
+		/// </summary>
+		void add(const Key&);
+
+		/// <summary>
+		/// Tests a key
+		/// </summary>
+		/// <return>bool false if the key was surely not added, true if it may have been added</return>
+		bool mayContain(const Key&) const;
+
+		/// <summary>
+		/// Removes all keys and resizes the filter for a new number of keys
+		/// </summary>
+		/// <param>const unsigned int& the expected number of keys</param>
+		void reset(const unsigned int&);
+
+		/// <summary>
+		/// Getter for the size of the bit array
+		/// </summary>
+		/// <return>size_t the size in bytes</return>
+		size_t sizeInBytes() const;
+
+		/// <summary>
+		/// Getter for the bit array, to store the filter together with its keys
+		/// </summary>
+		/// <return>const void* sizeInBytes() bytes of blocks</return>
+		const void* data() const;
+
+		/// <summary>
+		/// Replaces the bit array with one stored from data(), the filter must be read by a build with the same std::hash
+		/// </summary>
+		/// <param>const void* the stored bytes</param>
+		/// <param>const size_t& the number of bytes</param>
+		/// <return>bool false if the size is not a whole number of blocks, the filter is unchanged then</return>
+		bool assign(const void*, const size_t&);
+};
+
+#endif
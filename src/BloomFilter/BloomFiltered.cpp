@@ -0,0 +1,82 @@
+#include "BloomFiltered.h"
+#include "BlockedBloomFilter.cpp"
+#include <algorithm>
+
+template<typename Key, typename Value, typename Structure>
+Structure* BloomFiltered<Key, Value, Structure>::createStructure(const unsigned int& expectedElements, std::true_type) {
+	return new Structure{ expectedElements };
+}
+
+template<typename Key, typename Value, typename Structure>
+Structure* BloomFiltered<Key, Value, Structure>::createStructure(const unsigned int&, std::false_type) {
+	return new Structure{};
+}
+
+template<typename Key, typename Value, typename Structure>
+BloomFiltered<Key, Value, Structure>::BloomFiltered(const unsigned int& _expectedElements, const unsigned int& bitsPerKey) :
+	structure(createStructure(_expectedElements, std::is_constructible<Structure, const unsigned int&>{})),
+	filter(_expectedElements, bitsPerKey),
+	expectedElements(_expectedElements),
+	removals(0) {}
+
+template<typename Key, typename Value, typename Structure>
+BloomFiltered<Key, Value, Structure>::~BloomFiltered() {
+	delete this->structure;
+}
+
+template<typename Key, typename Value, typename Structure>
+void BloomFiltered<Key, Value, Structure>::insert(const Key& key, const Value& value) {
+	this->structure->insert(key, value);
+	this->filter.add(key);
+}
+
+template<typename Key, typename Value, typename Structure>
+bool BloomFiltered<Key, Value, Structure>::contains(const Key& key) const {
+	return this->filter.mayContain(key) && this->structure->contains(key);
+}
+
+template<typename Key, typename Value, typename Structure>
+const Value* BloomFiltered<Key, Value, Structure>::getValue(const Key& key) const {
+	if (!this->filter.mayContain(key)) {
+		return nullptr;
+	}
+
+	return this->structure->getValue(key);
+}
+
+template<typename Key, typename Value, typename Structure>
+void BloomFiltered<Key, Value, Structure>::remove(const Key& key) {
+	this->structure->remove(key);
+	this->removals++;
+}
+
+template<typename Key, typename Value, typename Structure>
+void BloomFiltered<Key, Value, Structure>::rebuild() {
+	unsigned int elements = 0;
+	this->structure->forEach([&elements](const Key&, const Value&) {
+		elements++;
+	});
+
+	this->filter.reset(std::max(elements, this->expectedElements));
+	BlockedBloomFilter<Key>& filter = this->filter;
+	this->structure->forEach([&filter](const Key& key, const Value&) {
+		filter.add(key);
+	});
+
+	this->removals = 0;
+}
+
+template<typename Key, typename Value, typename Structure>
+unsigned int BloomFiltered<Key, Value, Structure>::removalsSinceRebuild() const {
+	return this->removals;
+}
+
+template<typename Key, typename Value, typename Structure>
+const Structure& BloomFiltered<Key, Value, Structure>::getStructure() const {
+	return *this->structure;
+}
+
+template<typename Key, typename Value, typename Structure>
+const BlockedBloomFilter<Key>& BloomFiltered<Key, Value, Structure>::getFilter() const {
+	return this->filter;
+}
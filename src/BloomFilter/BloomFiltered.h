@@ -0,0 +1,81 @@
+#ifndef BLOOMFILTERED_H
+#define BLOOMFILTERED_H
+
+#include<type_traits>
+#include "BlockedBloomFilter.h"
+
+/// <summary>
+/// A template class putting a blocked Bloom filter in front of a structure with the insert/contains/remove interface,
+/// e.g. AVL or SkipList, so that most lookups of absent keys are answered without searching the structure
+/// The filter is maintained on insert, removed keys stay in it until rebuild is called
+/// </summary>
+template<typename Key, typename Value, typename Structure>
+class BloomFiltered
+{
+	private:
+		/// <summary>
+		/// Creates the structure, passing the expected number of elements to the structures taking it (SkipList)
+		/// </summary>
+		static Structure* createStructure(const unsigned int&, std::true_type);
+		static Structure* createStructure(const unsigned int&, std::false_type);
+
+		Structure* structure;
+		BlockedBloomFilter<Key> filter;
+		unsigned int expectedElements;
+		unsigned int removals;
+	public:
+		~BloomFiltered();
+		BloomFiltered(const BloomFiltered&) = delete;
+		BloomFiltered& operator=(const BloomFiltered&) = delete;
+
+		/// <summary>
+		/// Creates an empty structure with a filter sized for a number of keys
+		/// </summary>
+		/// <param>const unsigned int& the expected number of keys</param>
+		/// <param>const unsigned int& the bits of the filter per expected key, default is 16</param>
+		BloomFiltered(const unsigned int&, const unsigned int& = 16);
+
+		/// <summary>
+		/// Inserts a key-value pair into the structure and adds the key to the filter
+		/// </summary>
+		void insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Checks the filter and searches the structure only if the key may be present
+		/// </summary>
+		bool contains(const Key&) const;
+
+		/// <summary>
+		/// Getter for the value of a key, for the structures with getValue
+		/// </summary>
+		/// <return>const Value* the value or nullptr if the key is not in the structure</return>
+		const Value* getValue(const Key&) const;
+
+		/// <summary>
+		/// Removes a key from the structure, the key stays in the filter until the next rebuild
+		/// </summary>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Clears the filter and adds the keys of the structure again, resizing the filter if the structure
+		/// has grown over the expected number of keys
+		/// </summary>
+		void rebuild();
+
+		/// <summary>
+		/// Getter for the number of removes since the last rebuild - every one of them may leave a stale key in the filter
+		/// </summary>
+		unsigned int removalsSinceRebuild() const;
+
+		/// <summary>
+		/// Getter for the structure behind the filter
+		/// </summary>
+		const Structure& getStructure() const;
+
+		/// <summary>
+		/// Getter for the filter
+		/// </summary>
+		const BlockedBloomFilter<Key>& getFilter() const;
+};
+
+#endif
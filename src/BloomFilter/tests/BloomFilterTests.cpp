@@ -0,0 +1,103 @@
+#include "src/Doctest/doctest.h"
+#include "src/BloomFilter/BloomFiltered.cpp"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include <string>
+#include <vector>
+
+TEST_CASE("BlockedBloomFilter No false negatives") {
+	BlockedBloomFilter<int> filter{ 10000 };
+	for (int i = 0; i < 10000; i++) {
+		filter.add(i * 7);
+	}
+
+	bool allFound = true;
+	for (int i = 0; i < 10000; i++) {
+		allFound = allFound && filter.mayContain(i * 7);
+	}
+	CHECK(allFound);
+}
+
+TEST_CASE("BlockedBloomFilter False positive rate") {
+	BlockedBloomFilter<int> filter{ 100000 };
+	for (int i = 0; i < 100000; i++) {
+		filter.add(i);
+	}
+
+	int falsePositives = 0;
+	for (int i = 100000; i < 1100000; i++) {
+		falsePositives += filter.mayContain(i);
+	}
+
+	CHECK(falsePositives < 3000);
+	CHECK(filter.sizeInBytes() == 100000 * 16 / 8);
+}
+
+TEST_CASE("BlockedBloomFilter Reset") {
+	BlockedBloomFilter<std::string> filter{ 10 };
+	filter.add("key");
+	CHECK(filter.mayContain("key"));
+
+	filter.reset(1000);
+	CHECK(filter.mayContain("key") == false);
+}
+
+TEST_CASE("BlockedBloomFilter Assign stored bits") {
+	BlockedBloomFilter<int> filter{ 1000 };
+	for (int i = 0; i < 1000; i++) {
+		filter.add(i * 3);
+	}
+	std::vector<char> stored((const char*)filter.data(), (const char*)filter.data() + filter.sizeInBytes());
+
+	BlockedBloomFilter<int> loaded{ 10 };
+	CHECK(loaded.assign(stored.data(), stored.size() - 1) == false);
+	REQUIRE(loaded.assign(stored.data(), stored.size()));
+	CHECK(loaded.sizeInBytes() == filter.sizeInBytes());
+
+	bool same = true;
+	for (int i = 0; i < 5000 && same; i++) {
+		same = loaded.mayContain(i) == filter.mayContain(i);
+	}
+	CHECK(same);
+}
+
+TEST_CASE("BloomFiltered AVL") {
+	BloomFiltered<int, int, AVL<int, int>> tree{ 1000 };
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i * 2, i);
+	}
+
+	CHECK(tree.contains(10));
+	CHECK(tree.contains(11) == false);
+	CHECK(*tree.getValue(10) == 5);
+	CHECK(tree.getValue(11) == nullptr);
+
+	tree.remove(10);
+	CHECK(tree.contains(10) == false);
+	CHECK(tree.getFilter().mayContain(10));
+	CHECK(tree.removalsSinceRebuild() == 1);
+
+	tree.rebuild();
+	CHECK(tree.removalsSinceRebuild() == 0);
+	CHECK(tree.contains(12));
+	CHECK(tree.getStructure().nodesCount() == 999);
+}
+
+TEST_CASE("BloomFiltered SkipList, rebuild after growing") {
+	BloomFiltered<int, int, SkipList<int, int>> skipList{ 100 };
+	for (int i = 0; i < 5000; i++) {
+		skipList.insert(i, i);
+	}
+	for (int i = 0; i < 5000; i += 2) {
+		skipList.remove(i);
+	}
+
+	skipList.rebuild();
+	CHECK(skipList.getFilter().sizeInBytes() >= 2500 * 16 / 8);
+
+	bool same = true;
+	for (int i = 0; i < 5000; i++) {
+		same = same && skipList.contains(i) == (i % 2 == 1);
+	}
+	CHECK(same);
+}
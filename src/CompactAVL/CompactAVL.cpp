@@ -0,0 +1,381 @@
+#include "CompactAVL.h"
+#include <algorithm>
+#include <utility>
+
+template<typename Key, typename Value>
+CompactAVL<Key, Value>::CompactNode::CompactNode(const Key& _key, const Value& _value) :
+	key(_key),
+	value(_value),
+	left(nil),
+	right(nil) {}
+
+template<typename Key, typename Value>
+CompactAVL<Key, Value>::CompactAVL() :
+	root(nil) {}
+
+template<typename Key, typename Value>
+CompactAVL<Key, Value>::CompactAVL(const unsigned int& expectedElements) :
+	root(nil)
+{
+	this->nodes.reserve(expectedElements);
+}
+
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::leftOf(const std::uint32_t& node) const {
+	return this->nodes[node].left & indexMask;
+}
+
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::rightOf(const std::uint32_t& node) const {
+	return this->nodes[node].right & indexMask;
+}
+
+template<typename Key, typename Value>
+void CompactAVL<Key, Value>::setLeft(const std::uint32_t& node, const std::uint32_t& child) {
+	this->nodes[node].left = (this->nodes[node].left & heavyBit) | child;
+}
+
+template<typename Key, typename Value>
+void CompactAVL<Key, Value>::setRight(const std::uint32_t& node, const std::uint32_t& child) {
+	this->nodes[node].right = (this->nodes[node].right & heavyBit) | child;
+}
+
+template<typename Key, typename Value>
+int CompactAVL<Key, Value>::balanceOf(const std::uint32_t& node) const {
+	return (int)(this->nodes[node].right >> 31) - (int)(this->nodes[node].left >> 31);
+}
+
+template<typename Key, typename Value>
+void CompactAVL<Key, Value>::setBalance(const std::uint32_t& node, const int& balance) {
+	CompactNode& n = this->nodes[node];
+	n.left = (n.left & indexMask) | (balance < 0 ? heavyBit : 0);
+	n.right = (n.right & indexMask) | (balance > 0 ? heavyBit : 0);
+}
+
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::rotateRight(const std::uint32_t& x) {
+	std::uint32_t y = this->leftOf(x);
+	this->setLeft(x, this->rightOf(y));
+	this->setRight(y, x);
+
+	return y;
+}
+
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::rotateLeft(const std::uint32_t& x) {
+	std::uint32_t y = this->rightOf(x);
+	this->setRight(x, this->leftOf(y));
+	this->setLeft(y, x);
+
+	return y;
+}
+
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::balanceLeftHeavy(const std::uint32_t& x, bool& lower) {
+	std::uint32_t y = this->leftOf(x);
+	int balance = this->balanceOf(y);
+
+	if (balance <= 0) {//left left case, a balanced child happens only after a remove
+		std::uint32_t root = this->rotateRight(x);
+		this->setBalance(x, balance ? 0 : -1);
+		this->setBalance(y, balance ? 0 : 1);
+		lower = balance != 0;
+
+		return root;
+	}
+
+	//left right case
+	std::uint32_t z = this->rightOf(y);
+	int balanceZ = this->balanceOf(z);
+	this->setLeft(x, this->rotateLeft(y));
+	std::uint32_t root = this->rotateRight(x);
+	this->setBalance(x, balanceZ < 0 ? 1 : 0);
+	this->setBalance(y, balanceZ > 0 ? -1 : 0);
+	this->setBalance(z, 0);
+	lower = true;
+
+	return root;
+}
+
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::balanceRightHeavy(const std::uint32_t& x, bool& lower) {
+	std::uint32_t y = this->rightOf(x);
+	int balance = this->balanceOf(y);
+
+	if (balance >= 0) {//right right case, a balanced child happens only after a remove
+		std::uint32_t root = this->rotateLeft(x);
+		this->setBalance(x, balance ? 0 : 1);
+		this->setBalance(y, balance ? 0 : -1);
+		lower = balance != 0;
+
+		return root;
+	}
+
+	//right left case
+	std::uint32_t z = this->leftOf(y);
+	int balanceZ = this->balanceOf(z);
+	this->setRight(x, this->rotateRight(y));
+	std::uint32_t root = this->rotateLeft(x);
+	this->setBalance(x, balanceZ > 0 ? -1 : 0);
+	this->setBalance(y, balanceZ < 0 ? 1 : 0);
+	this->setBalance(z, 0);
+	lower = true;
+
+	return root;
+}
+
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::find(const Key& key) const {
+	std::uint32_t current = this->root;
+	while (current != nil) {
+		const CompactNode& node = this->nodes[current];
+		if (key < node.key) {
+			current = node.left & indexMask;
+		} else if (key > node.key) {
+			current = node.right & indexMask;
+		} else {
+			return current;
+		}
+	}
+
+	return nil;
+}
+
+//the vector may grow during the recursion, so nodes are referenced by index across the calls
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::insertFromNode(std::uint32_t node, const Key& key, const Value& value, bool& higher) {
+	if (node == nil) {
+		this->nodes.emplace_back(key, value);
+		higher = true;
+		return (std::uint32_t)(this->nodes.size() - 1);
+	}
+
+	if (key < this->nodes[node].key) {
+		std::uint32_t child = this->insertFromNode(this->leftOf(node), key, value, higher);
+		this->setLeft(node, child);
+		if (!higher) {
+			return node;
+		}
+
+		int balance = this->balanceOf(node);
+		if (balance > 0) {
+			this->setBalance(node, 0);
+			higher = false;
+		} else if (balance == 0) {
+			this->setBalance(node, -1);
+		} else {
+			bool lower;
+			node = this->balanceLeftHeavy(node, lower);
+			higher = false;
+		}
+	} else if (key > this->nodes[node].key) {
+		std::uint32_t child = this->insertFromNode(this->rightOf(node), key, value, higher);
+		this->setRight(node, child);
+		if (!higher) {
+			return node;
+		}
+
+		int balance = this->balanceOf(node);
+		if (balance < 0) {
+			this->setBalance(node, 0);
+			higher = false;
+		} else if (balance == 0) {
+			this->setBalance(node, 1);
+		} else {
+			bool lower;
+			node = this->balanceRightHeavy(node, lower);
+			higher = false;
+		}
+	} else {
+		this->nodes[node].value = value;
+		higher = false;
+	}
+
+	return node;
+}
+
+template<typename Key, typename Value>
+std::uint32_t CompactAVL<Key, Value>::removeFromNode(std::uint32_t node, const Key& key, bool& lower, std::uint32_t& removed) {
+	if (node == nil) {
+		lower = false;
+		return nil;
+	}
+
+	bool fromLeft;
+	if (key < this->nodes[node].key) {
+		this->setLeft(node, this->removeFromNode(this->leftOf(node), key, lower, removed));
+		fromLeft = true;
+	} else if (key > this->nodes[node].key) {
+		this->setRight(node, this->removeFromNode(this->rightOf(node), key, lower, removed));
+		fromLeft = false;
+	} else if (this->leftOf(node) == nil || this->rightOf(node) == nil) {//node's # of children <= 1
+		removed = node;
+		lower = true;
+		return this->leftOf(node) != nil ? this->leftOf(node) : this->rightOf(node);
+	} else {//node's # of children == 2, the node takes the pair of the largest node in its left subtree
+		std::uint32_t largest = this->leftOf(node);
+		while (this->rightOf(largest) != nil) {
+			largest = this->rightOf(largest);
+		}
+
+		this->nodes[node].key = this->nodes[largest].key;
+		this->nodes[node].value = this->nodes[largest].value;
+		this->setLeft(node, this->removeFromNode(this->leftOf(node), this->nodes[node].key, lower, removed));
+		fromLeft = true;
+	}
+
+	if (!lower) {
+		return node;
+	}
+
+	int balance = this->balanceOf(node);
+	if (fromLeft) {
+		if (balance < 0) {
+			this->setBalance(node, 0);
+		} else if (balance == 0) {
+			this->setBalance(node, 1);
+			lower = false;
+		} else {
+			node = this->balanceRightHeavy(node, lower);
+		}
+	} else {
+		if (balance > 0) {
+			this->setBalance(node, 0);
+		} else if (balance == 0) {
+			this->setBalance(node, -1);
+			lower = false;
+		} else {
+			node = this->balanceLeftHeavy(node, lower);
+		}
+	}
+
+	return node;
+}
+
+template<typename Key, typename Value>
+void CompactAVL<Key, Value>::releaseNode(const std::uint32_t& released) {
+	std::uint32_t last = (std::uint32_t)(this->nodes.size() - 1);
+	if (released != last) {
+		//the keys are unique once the released node is unlinked, so the parent of the last node is found by its key
+		const Key& key = this->nodes[last].key;
+		if (this->root == last) {
+			this->root = released;
+		} else {
+			std::uint32_t current = this->root;
+			while (true) {
+				if (key < this->nodes[current].key) {
+					if (this->leftOf(current) == last) {
+						this->setLeft(current, released);
+						break;
+					}
+					current = this->leftOf(current);
+				} else {
+					if (this->rightOf(current) == last) {
+						this->setRight(current, released);
+						break;
+					}
+					current = this->rightOf(current);
+				}
+			}
+		}
+
+		this->nodes[released] = std::move(this->nodes[last]);
+	}
+
+	this->nodes.pop_back();
+}
+
+template<typename Key, typename Value>
+void CompactAVL<Key, Value>::insert(const Key& key, const Value& value) {
+	bool higher;
+	this->root = this->insertFromNode(this->root, key, value, higher);
+}
+
+template<typename Key, typename Value>
+const Value* CompactAVL<Key, Value>::getValue(const Key& key) const {
+	std::uint32_t node = this->find(key);
+	if (node == nil) {
+		return nullptr;
+	}
+
+	return &this->nodes[node].value;
+}
+
+template<typename Key, typename Value>
+bool CompactAVL<Key, Value>::contains(const Key& key) const {
+	return this->find(key) != nil;
+}
+
+template<typename Key, typename Value>
+void CompactAVL<Key, Value>::remove(const Key& key) {
+	bool lower;
+	std::uint32_t removed = nil;
+	this->root = this->removeFromNode(this->root, key, lower, removed);
+
+	if (removed != nil) {
+		this->releaseNode(removed);
+	}
+}
+
+template<typename Key, typename Value>
+int CompactAVL<Key, Value>::nodesCount() const {
+	return (int)this->nodes.size();
+}
+
+template<typename Key, typename Value>
+int CompactAVL<Key, Value>::height() const {
+	int result = -1;
+	for (std::uint32_t current = this->root; current != nil; result++) {
+		current = this->balanceOf(current) > 0 ? this->rightOf(current) : this->leftOf(current);
+	}
+
+	return result;
+}
+
+template<typename Key, typename Value>
+size_t CompactAVL<Key, Value>::sizeInBytes() const {
+	return this->nodes.capacity() * sizeof(CompactNode);
+}
+
+template<typename Key, typename Value>
+int CompactAVL<Key, Value>::checkedHeight(const std::uint32_t& node, bool& valid) const {
+	if (node == nil) {
+		return -1;
+	}
+
+	int left = this->checkedHeight(this->leftOf(node), valid);
+	int right = this->checkedHeight(this->rightOf(node), valid);
+	//both heavy bits set would read as 0
+	bool bothBits = (this->nodes[node].left & heavyBit) && (this->nodes[node].right & heavyBit);
+	if (bothBits || right - left != this->balanceOf(node)) {
+		valid = false;
+	}
+
+	return 1 + std::max(left, right);
+}
+
+template<typename Key, typename Value>
+bool CompactAVL<Key, Value>::isAVL() const {
+	bool valid = true;
+	this->checkedHeight(this->root, valid);
+
+	return valid;
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void CompactAVL<Key, Value>::forEachFromNode(const std::uint32_t& node, Function& function) const {
+	if (node == nil) {
+		return;
+	}
+
+	this->forEachFromNode(this->leftOf(node), function);
+	function(this->nodes[node].key, this->nodes[node].value);
+	this->forEachFromNode(this->rightOf(node), function);
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void CompactAVL<Key, Value>::forEach(Function function) const {
+	this->forEachFromNode(this->root, function);
+}
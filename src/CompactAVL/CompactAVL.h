@@ -0,0 +1,190 @@
+#ifndef COMPACTAVL_H
+#define COMPACTAVL_H
+
+#include<vector>
+#include<cstdint>
+#include<cstddef>
+
+/// <summary>
+/// A template class representing an AVL tree with the interface of AVL and compact nodes:
+/// the nodes are stored in a contiguous vector and link their children by 32-bit indices,
+/// and instead of a height every node keeps a balance factor in the top bits of the two indices
+/// For AVL<int, int> a node takes 16 bytes instead of 32 and there is no allocation per node
+/// A removed node is replaced by the last node of the vector, so the vector stays dense
+/// Holds at most 2^31 - 1 nodes
+/// Duplicate keys are not supported - the lastly added value for a key is taken
+/// </summary>
+template<typename Key, typename Value>
+class CompactAVL
+{
+	private:
+		/// <summary>
+		/// The top bit of left marks a node whose left subtree is higher, the top bit of right one whose right subtree is
+		/// </summary>
+		struct CompactNode {
+			Key key;
+			Value value;
+			std::uint32_t left;
+			std::uint32_t right;
+
+			CompactNode(const Key&, const Value&);
+		};
+
+		static constexpr std::uint32_t indexMask = 0x7fffffff;
+		static constexpr std::uint32_t heavyBit = 0x80000000;
+
+		/// <summary>
+		/// The index of a missing child
+		/// </summary>
+		static constexpr std::uint32_t nil = indexMask;
+
+		std::uint32_t leftOf(const std::uint32_t&) const;
+		std::uint32_t rightOf(const std::uint32_t&) const;
+		void setLeft(const std::uint32_t&, const std::uint32_t&);
+		void setRight(const std::uint32_t&, const std::uint32_t&);
+
+		/// <summary>
+		/// Getter for the balance factor of a node - the height of its right subtree minus the height of its left one
+		/// </summary>
+		/// <return>int -1, 0 or 1</return>
+		int balanceOf(const std::uint32_t&) const;
+
+		/// <summary>
+		/// Stores a balance factor of -1, 0 or 1 in the top bits of the child indices of a node
+		/// </summary>
+		void setBalance(const std::uint32_t&, const int&);
+
+		/// <summary>
+		/// Performs a right rotation on a node, the balance factors are updated by the caller
+		/// </summary>
+		/// <return>std::uint32_t the new root of the rotated tree</return>
+		std::uint32_t rotateRight(const std::uint32_t&);
+
+		/// <summary>
+		/// Performs a left rotation on a node, the balance factors are updated by the caller
+		/// </summary>
+		/// <return>std::uint32_t the new root of the rotated tree</return>
+		std::uint32_t rotateLeft(const std::uint32_t&);
+
+		/// <summary>
+		/// Rotates a node whose left subtree became two levels higher than its right one
+		/// </summary>
+		/// <param>const std::uint32_t& the node</param>
+		/// <param>bool& receives whether the rotated tree is lower than before the rotation</param>
+		/// <return>std::uint32_t the new root of the rotated tree</return>
+		std::uint32_t balanceLeftHeavy(const std::uint32_t&, bool&);
+
+		/// <summary>
+		/// Rotates a node whose right subtree became two levels higher than its left one
+		/// </summary>
+		/// <param>const std::uint32_t& the node</param>
+		/// <param>bool& receives whether the rotated tree is lower than before the rotation</param>
+		/// <return>std::uint32_t the new root of the rotated tree</return>
+		std::uint32_t balanceRightHeavy(const std::uint32_t&, bool&);
+
+		/// <summary>
+		/// Finds a node by key
+		/// </summary>
+		/// <return>std::uint32_t the index of the node or nil</return>
+		std::uint32_t find(const Key&) const;
+
+		/// <summary>
+		/// Inserts a key-value pair into the tree with root the parameter
+		/// If a node with the same key exists, its value will be changed
+		/// </summary>
+		/// <param>std::uint32_t the root of the tree</param>
+		/// <param>const Key& the key to insert</param>
+		/// <param>const Value& the new value</param>
+		/// <param>bool& receives whether the tree became higher</param>
+		/// <return>std::uint32_t the new root of the tree</return>
+		std::uint32_t insertFromNode(std::uint32_t, const Key&, const Value&, bool&);
+
+		/// <summary>
+		/// Unlinks the node of a key from the tree with root the parameter, the node is left in the vector
+		/// </summary>
+		/// <param>std::uint32_t the root of the tree</param>
+		/// <param>const Key& the key to look for</param>
+		/// <param>bool& receives whether the tree became lower</param>
+		/// <param>std::uint32_t& receives the index of the unlinked node or nil if the key was not found</param>
+		/// <return>std::uint32_t the new root of the tree</return>
+		std::uint32_t removeFromNode(std::uint32_t, const Key&, bool&, std::uint32_t&);
+
+		/// <summary>
+		/// Moves the last node of the vector into the slot of an unlinked node and shrinks the vector
+		/// </summary>
+		void releaseNode(const std::uint32_t&);
+
+		/// <summary>
+		/// Calculates the height of a tree and checks the balance factors against it
+		/// </summary>
+		/// <param>const std::uint32_t& the root of the tree</param>
+		/// <param>bool& set to false if a balance factor is wrong or not in -1..1</param>
+		/// <return>int the height of the tree, -1 for an empty tree</return>
+		int checkedHeight(const std::uint32_t&, bool&) const;
+
+		template<typename Function>
+		void forEachFromNode(const std::uint32_t&, Function&) const;
+
+		std::vector<CompactNode> nodes;
+		std::uint32_t root;
+	public:
+		CompactAVL();
+
+		/// <summary>
+		/// Creates an empty tree with room for a number of nodes
+		/// </summary>
+		/// <param>const unsigned int& the expected number of elements</param>
+		CompactAVL(const unsigned int&);
+
+		/// <summary>
+		/// Inserts a key-value pair or updates the value of an existing key
+		/// </summary>
+		void insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Getter for the value of a key
+		/// </summary>
+		/// <return>const Value* the value or nullptr if the key is not in the tree</return>
+		const Value* getValue(const Key&) const;
+
+		/// <summary>
+		/// Checks whether a key is inside the tree
+		/// </summary>
+		bool contains(const Key&) const;
+
+		/// <summary>
+		/// Removes a key from the tree
+		/// </summary>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Getter for the number of nodes in the tree
+		/// </summary>
+		int nodesCount() const;
+
+		/// <summary>
+		/// Getter for the height of the tree, found by following the higher subtree from the root
+		/// </summary>
+		/// <return>int the height of the tree, -1 for an empty tree</return>
+		int height() const;
+
+		/// <summary>
+		/// Getter for the memory reserved for the nodes
+		/// </summary>
+		/// <return>size_t the capacity of the node vector in bytes</return>
+		size_t sizeInBytes() const;
+
+		/// <summary>
+		/// Checks whether the tree is a valid AVL tree with correct balance factors
+		/// </summary>
+		bool isAVL() const;
+
+		/// <summary>
+		/// Calls a function for all key-value pairs in ascending order of the keys
+		/// </summary>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEach(Function) const;
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include "src/Doctest/doctest.h"
+#include "src/CompactAVL/CompactAVL.cpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+
+TEST_CASE("CompactAVL Size in bytes") {
+	//the pair and two 32-bit indices holding the balance bits
+	CompactAVL<int, int> tree{ 1000 };
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i, i);
+	}
+
+	CHECK(tree.sizeInBytes() == 16 * 1000);
+}
+
+TEST_CASE("CompactAVL Insert") {
+	CompactAVL<int, int> tree;
+	for (int i : { 8, 9, 10, 1, 2, 3, 4, 5, 11, 12, 7 }) {
+		tree.insert(i, i);
+	}
+
+	CHECK(tree.nodesCount() == 11);
+	CHECK(tree.height() == 3);
+	CHECK(tree.isAVL());
+	CHECK(*tree.getValue(5) == 5);
+	CHECK(tree.contains(6) == false);
+}
+
+TEST_CASE("CompactAVL Insert, duplicate key") {
+	CompactAVL<int, int> tree{ 10 };
+	tree.insert(1, 1);
+	tree.insert(1, 2);
+
+	CHECK(tree.nodesCount() == 1);
+	CHECK(*tree.getValue(1) == 2);
+}
+
+TEST_CASE("CompactAVL Insert, ascending keys") {
+	CompactAVL<int, int> tree;
+	for (int i = 0; i < 100000; i++) {
+		tree.insert(i, i);
+	}
+
+	CHECK(tree.isAVL());
+	CHECK(tree.height() <= 1.45 * std::log2(100000 + 2));
+}
+
+TEST_CASE("CompactAVL Remove") {
+	CompactAVL<int, int> tree;
+	for (int i = 1; i <= 10; i++) {
+		tree.insert(i, i * 10);
+	}
+
+	tree.remove(1);
+	tree.remove(4);
+	tree.remove(8);
+	tree.remove(143);
+
+	CHECK(tree.nodesCount() == 7);
+	CHECK(tree.isAVL());
+	CHECK(tree.contains(4) == false);
+	CHECK(*tree.getValue(10) == 100);
+}
+
+TEST_CASE("CompactAVL Remove, all keys") {
+	CompactAVL<int, int> tree;
+	tree.remove(1);
+	for (int i = 0; i < 1000; i++) {
+		tree.insert(i * 7, i);
+	}
+	for (int i = 0; i < 1000; i++) {
+		tree.remove(i * 7);
+	}
+
+	CHECK(tree.nodesCount() == 0);
+	CHECK(tree.height() == -1);
+
+	tree.insert(5, 5);
+	CHECK(*tree.getValue(5) == 5);
+}
+
+TEST_CASE("CompactAVL Random operations") {
+	CompactAVL<int, std::string> tree;
+	std::map<int, std::string> expected;
+	std::mt19937 generator{ 13 };
+	std::uniform_int_distribution<int> keys{ 0, 4000 };
+
+	bool valid = true;
+	for (int i = 0; i < 40000 && valid; i++) {
+		int key = keys(generator);
+		if (i % 5 < 3) {
+			tree.insert(key, std::to_string(i));
+			expected[key] = std::to_string(i);
+		} else {
+			tree.remove(key);
+			expected.erase(key);
+		}
+
+		valid = i % 1000 || tree.isAVL();
+	}
+
+	CHECK(valid);
+	CHECK(tree.nodesCount() == (int)expected.size());
+
+	std::vector<std::pair<int, std::string>> pairs;
+	tree.forEach([&pairs](const int& key, const std::string& value) {
+		pairs.emplace_back(key, value);
+	});
+	CHECK(pairs == std::vector<std::pair<int, std::string>>(expected.begin(), expected.end()));
+}
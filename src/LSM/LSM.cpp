@@ -0,0 +1,643 @@
+#include "LSM.h"
+#include "../SkipList/SkipList.cpp"
+#include "../BloomFilter/BlockedBloomFilter.cpp"
+#include "../WAL/WAL.cpp"
+#include "../Simd/Crc32.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+template<typename Key, typename Value>
+LSM<Key, Value>::Table::Table() :
+	filter(1),
+	records(nullptr),
+	index(nullptr),
+	obsolete(false)
+{
+	std::memset(&this->footer, 0, sizeof(this->footer));
+}
+
+template<typename Key, typename Value>
+LSM<Key, Value>::Table::~Table() {
+	this->file.close();
+	if (this->obsolete) {
+		std::error_code error;
+		std::filesystem::remove(this->path, error);
+	}
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::Table::open(const std::string& _path) {
+	this->path = _path;
+	if (!this->file.open(_path) || this->file.size() < sizeof(TableFooter)) {
+		return false;
+	}
+
+	const char* data = (const char*)this->file.data();
+	std::memcpy(&this->footer, data + this->file.size() - sizeof(TableFooter), sizeof(TableFooter));
+	const TableFooter& f = this->footer;
+	std::uint64_t blocks = f.blockRecords ? (f.count + f.blockRecords - 1) / f.blockRecords : 0;
+
+	//the sizes are checked one after another, so no sum can overflow
+	bool valid = std::memcmp(f.magic, "DSPLSM1", 8) == 0
+		&& f.checksum == SimdKernels::crc32c(&f, offsetof(TableFooter, checksum))
+		&& f.keySize == sizeof(Key) && f.valueSize == sizeof(Value) && f.blockRecords > 0
+		&& f.indexOffset == f.count * recordSize
+		&& f.filterOffset == f.indexOffset + blocks * sizeof(Key)
+		&& f.filterOffset + f.filterBytes + sizeof(TableFooter) == this->file.size()
+		&& this->filter.assign(data + f.filterOffset, (size_t)f.filterBytes);
+	if (!valid) {
+		this->file.close();
+		return false;
+	}
+
+	this->records = data;
+	this->index = data + f.indexOffset;
+
+	return true;
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::Table::find(const Key& key, Entry& entry) const {
+	if (!this->filter.mayContain(key)) {
+		return false;
+	}
+
+	//the block of the key is the last one whose first key is not greater than it
+	std::uint64_t low = 0;
+	std::uint64_t high = (this->footer.count + this->footer.blockRecords - 1) / this->footer.blockRecords;
+	while (low < high) {
+		std::uint64_t middle = low + (high - low) / 2;
+		Key first;
+		std::memcpy(&first, this->index + middle * sizeof(Key), sizeof(Key));
+		if (key < first) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+	if (low == 0) {
+		return false;
+	}
+
+	std::uint64_t begin = (low - 1) * this->footer.blockRecords;
+	std::uint64_t end = std::min(this->footer.count, begin + this->footer.blockRecords);
+	while (begin < end) {
+		std::uint64_t middle = begin + (end - begin) / 2;
+		Key current;
+		std::memcpy(&current, this->records + middle * recordSize, sizeof(Key));
+		if (current < key) {
+			begin = middle + 1;
+		} else if (key < current) {
+			end = middle;
+		} else {
+			this->read(middle, current, entry);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template<typename Key, typename Value>
+void LSM<Key, Value>::Table::read(const std::uint64_t& position, Key& key, Entry& entry) const {
+	const char* record = this->records + position * recordSize;
+	std::memcpy(&key, record, sizeof(Key));
+	std::memcpy(&entry.value, record + sizeof(Key), sizeof(Value));
+	entry.removed = record[sizeof(Key) + sizeof(Value)] != 0;
+}
+
+template<typename Key, typename Value>
+std::uint64_t LSM<Key, Value>::Table::count() const {
+	return this->footer.count;
+}
+
+template<typename Key, typename Value>
+std::uint64_t LSM<Key, Value>::Table::firstSequence() const {
+	return this->footer.firstSequence;
+}
+
+template<typename Key, typename Value>
+std::uint64_t LSM<Key, Value>::Table::lastSequence() const {
+	return this->footer.lastSequence;
+}
+
+template<typename Key, typename Value>
+void LSM<Key, Value>::Table::markObsolete() {
+	this->obsolete = true;
+}
+
+template<typename Key, typename Value>
+LSM<Key, Value>::TableWriter::TableWriter(const std::string& path, const std::uint64_t& expected, const unsigned int& blockBytes) :
+	filter((unsigned int)std::min<std::uint64_t>(std::max<std::uint64_t>(expected, 1), 0xffffffffu)),
+	blockRecords((std::uint32_t)std::max<size_t>(1, blockBytes / recordSize)),
+	count(0)
+{
+	this->failed = !this->file.open(path) || !this->file.truncate(0);
+	this->buffer.reserve(1 << 20);
+}
+
+template<typename Key, typename Value>
+void LSM<Key, Value>::TableWriter::flushBuffer() {
+	if (!this->failed && !this->buffer.empty()) {
+		this->failed = !this->file.append(this->buffer.data(), this->buffer.size());
+	}
+	this->buffer.clear();
+}
+
+template<typename Key, typename Value>
+void LSM<Key, Value>::TableWriter::add(const Key& key, const Entry& entry) {
+	if (this->count % this->blockRecords == 0) {
+		this->firstKeys.push_back(key);
+	}
+
+	size_t start = this->buffer.size();
+	this->buffer.resize(start + recordSize);
+	std::memcpy(&this->buffer[start], &key, sizeof(Key));
+	std::memcpy(&this->buffer[start + sizeof(Key)], &entry.value, sizeof(Value));
+	this->buffer[start + sizeof(Key) + sizeof(Value)] = entry.removed ? 1 : 0;
+
+	this->filter.add(key);
+	this->count++;
+	if (this->buffer.size() + recordSize > this->buffer.capacity()) {
+		this->flushBuffer();
+	}
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::TableWriter::finish(const std::uint64_t& firstSequence, const std::uint64_t& lastSequence) {
+	this->flushBuffer();
+
+	TableFooter footer;
+	std::memset(&footer, 0, sizeof(footer));
+	footer.count = this->count;
+	footer.indexOffset = this->count * recordSize;
+	footer.filterOffset = footer.indexOffset + this->firstKeys.size() * sizeof(Key);
+	footer.filterBytes = this->filter.sizeInBytes();
+	footer.firstSequence = firstSequence;
+	footer.lastSequence = lastSequence;
+	footer.keySize = sizeof(Key);
+	footer.valueSize = sizeof(Value);
+	footer.blockRecords = this->blockRecords;
+	std::memcpy(footer.magic, "DSPLSM1", 8);
+	footer.checksum = SimdKernels::crc32c(&footer, offsetof(TableFooter, checksum));
+
+	return !this->failed
+		&& this->file.append(this->firstKeys.data(), this->firstKeys.size() * sizeof(Key))
+		&& this->file.append(this->filter.data(), this->filter.sizeInBytes())
+		&& this->file.append(&footer, sizeof(footer))
+		&& this->file.sync();
+}
+
+template<typename Key, typename Value>
+LSM<Key, Value>::LSM(const unsigned int& _memtableEntries, const unsigned int& _compactionTrigger, const unsigned int& _walGroupSize) :
+	memtableEntries(std::max(1u, _memtableEntries)),
+	compactionTrigger(std::max(2u, _compactionTrigger)),
+	walGroupSize(_walGroupSize),
+	memtableSequence(0),
+	memtableUpdates(0),
+	frozenSequence(0),
+	compactionRequested(false),
+	backgroundFailed(false),
+	stopping(false) {}
+
+template<typename Key, typename Value>
+LSM<Key, Value>::~LSM() {
+	this->close();
+}
+
+template<typename Key, typename Value>
+std::string LSM<Key, Value>::tablePath(const std::uint64_t& lastSequence, const std::uint64_t& firstSequence) const {
+	char name[64];
+	std::snprintf(name, sizeof(name), "/table-%020llu-%020llu.sst", (unsigned long long)lastSequence, (unsigned long long)firstSequence);
+
+	return this->directory + name;
+}
+
+template<typename Key, typename Value>
+std::string LSM<Key, Value>::logPath(const std::uint64_t& sequence) const {
+	char name[64];
+	std::snprintf(name, sizeof(name), "/wal-%020llu.log", (unsigned long long)sequence);
+
+	return this->directory + name;
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::openLog(const std::uint64_t& sequence) {
+	this->wal.reset(new WAL<Key, Entry>{ this->walGroupSize });
+	this->memtableSequence = sequence;
+	if (!this->wal->open(this->logPath(sequence), *this->memtable)) {
+		return false;
+	}
+
+	this->memtableUpdates += (unsigned int)this->wal->replayed();
+
+	return true;
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::open(const std::string& path) {
+	static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "LSM needs trivially copyable keys and values");
+
+	this->close();
+	this->directory = path;
+	std::error_code error;
+	std::filesystem::create_directories(path, error);
+	if (!std::filesystem::is_directory(path, error)) {
+		return false;
+	}
+
+	std::vector<std::shared_ptr<Table>> found;
+	std::vector<std::uint64_t> logs;
+	for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator(path, error)) {
+		std::string name = file.path().filename().string();
+		unsigned long long first, last;
+		char rest;
+		if (std::sscanf(name.c_str(), "table-%llu-%llu.sst%c", &last, &first, &rest) == 2) {
+			std::shared_ptr<Table> table{ new Table{} };
+			if (table->open(file.path().string())) {
+				found.push_back(table);
+			} else {//a table whose write was interrupted, its memtables are still in their logs
+				table->markObsolete();
+			}
+		} else if (std::sscanf(name.c_str(), "wal-%llu.log%c", &last, &rest) == 1) {
+			logs.push_back(last);
+		}
+	}
+
+	//a compaction deletes its inputs after the merged table is written, a crash in between leaves inputs covered by it
+	for (const std::shared_ptr<Table>& table : found) {
+		bool covered = false;
+		for (const std::shared_ptr<Table>& other : found) {
+			covered = covered || (other != table && other->firstSequence() <= table->firstSequence() && table->lastSequence() <= other->lastSequence());
+		}
+
+		if (covered) {
+			table->markObsolete();
+		} else {
+			this->tables.push_back(table);
+		}
+	}
+	std::sort(this->tables.begin(), this->tables.end(), [](const std::shared_ptr<Table>& a, const std::shared_ptr<Table>& b) {
+		return a->lastSequence() < b->lastSequence();
+	});
+
+	//the logs of memtables already in a table are deleted, the others are replayed in order into one memtable
+	std::uint64_t flushed = this->tables.empty() ? 0 : this->tables.back()->lastSequence();
+	std::sort(logs.begin(), logs.end());
+	this->memtable.reset(new Memtable{ this->memtableEntries });
+	this->memtableUpdates = 0;
+	std::uint64_t sequence = flushed + 1;
+	for (const std::uint64_t& log : logs) {
+		if (log <= flushed) {
+			std::filesystem::remove(this->logPath(log), error);
+		} else if (log != logs.back()) {
+			WAL<Key, Entry> replayed{ this->walGroupSize };
+			replayed.open(this->logPath(log), *this->memtable);
+			this->memtableUpdates += (unsigned int)replayed.replayed();
+			this->replayedLogs.push_back(log);
+		} else {
+			sequence = log;
+		}
+	}
+
+	bool opened = this->openLog(sequence);
+	this->stopping = false;
+	this->backgroundFailed = false;
+	this->compactionRequested = false;
+	this->worker = std::thread(&LSM::backgroundWork, this);
+
+	return opened;
+}
+
+template<typename Key, typename Value>
+void LSM<Key, Value>::close() {
+	if (this->worker.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stopping = true;
+		}
+		this->changed.notify_all();
+		this->worker.join();
+	}
+
+	//a frozen memtable which was not flushed keeps its log, the next open replays it
+	this->wal.reset();
+	this->memtable.reset();
+	this->frozen.reset();
+	this->frozenLogs.clear();
+	this->replayedLogs.clear();
+	this->tables.clear();
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::freeze() {
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->changed.wait(lock, [this] { return !this->frozen || this->backgroundFailed; });
+		if (this->backgroundFailed) {
+			return false;
+		}
+	}
+
+	//the log is committed and closed before the background thread may delete it
+	this->wal.reset();
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->frozen = std::shared_ptr<Memtable>(this->memtable.release());
+		this->frozenSequence = this->memtableSequence;
+		this->frozenLogs.swap(this->replayedLogs);
+		this->frozenLogs.push_back(this->memtableSequence);
+		this->replayedLogs.clear();
+	}
+	this->changed.notify_all();
+
+	this->memtable.reset(new Memtable{ this->memtableEntries });
+	this->memtableUpdates = 0;
+
+	return this->openLog(this->frozenSequence + 1);
+}
+
+template<typename Key, typename Value>
+std::shared_ptr<typename LSM<Key, Value>::Table> LSM<Key, Value>::writeFrozen(const Memtable& frozenMemtable, const std::uint64_t& sequence) const {
+	std::string path = this->tablePath(sequence, sequence);
+	TableWriter writer{ path, frozenMemtable.numberOfElements(), blockSize };
+	frozenMemtable.forEach([&writer](const Key& key, const Entry& entry) {
+		writer.add(key, entry);
+	});
+
+	std::shared_ptr<Table> table{ new Table{} };
+	if (!writer.finish(sequence, sequence) || !AppendFile::syncDirectory(this->directory) || !table->open(path)) {
+		return nullptr;
+	}
+
+	return table;
+}
+
+template<typename Key, typename Value>
+std::shared_ptr<typename LSM<Key, Value>::Table> LSM<Key, Value>::merge(const std::vector<std::shared_ptr<Table>>& inputs, const bool& dropTombstones) const {
+	std::uint64_t expected = 0;
+	for (const std::shared_ptr<Table>& input : inputs) {
+		expected += input->count();
+	}
+
+	std::uint64_t firstSequence = inputs.front()->firstSequence();
+	std::uint64_t lastSequence = inputs.back()->lastSequence();
+	std::string path = this->tablePath(lastSequence, firstSequence);
+	TableWriter writer{ path, expected, blockSize };
+
+	//the inputs are ordered oldest first, so of equal keys the one of the last input wins
+	std::vector<std::uint64_t> positions(inputs.size(), 0);
+	std::vector<Key> keys(inputs.size());
+	std::vector<Entry> entries(inputs.size());
+	for (size_t i = 0; i < inputs.size(); i++) {
+		if (inputs[i]->count()) {
+			inputs[i]->read(0, keys[i], entries[i]);
+		}
+	}
+
+	while (true) {
+		size_t newest = inputs.size();
+		for (size_t i = 0; i < inputs.size(); i++) {
+			if (positions[i] < inputs[i]->count() && (newest == inputs.size() || !(keys[newest] < keys[i]))) {
+				newest = i;
+			}
+		}
+		if (newest == inputs.size()) {
+			break;
+		}
+
+		Key key = keys[newest];
+		if (!dropTombstones || !entries[newest].removed) {
+			writer.add(key, entries[newest]);
+		}
+
+		for (size_t i = 0; i < inputs.size(); i++) {
+			if (positions[i] < inputs[i]->count() && !(key < keys[i]) && ++positions[i] < inputs[i]->count()) {
+				inputs[i]->read(positions[i], keys[i], entries[i]);
+			}
+		}
+	}
+
+	std::shared_ptr<Table> table{ new Table{} };
+	if (!writer.finish(firstSequence, lastSequence) || !AppendFile::syncDirectory(this->directory) || !table->open(path)) {
+		return nullptr;
+	}
+
+	return table;
+}
+
+template<typename Key, typename Value>
+unsigned int LSM<Key, Value>::tierOf(const std::uint64_t& count) const {
+	unsigned int tier = 0;
+	for (std::uint64_t limit = (std::uint64_t)this->memtableEntries * this->compactionTrigger; count >= limit; limit *= this->compactionTrigger) {
+		tier++;
+	}
+
+	return tier;
+}
+
+template<typename Key, typename Value>
+size_t LSM<Key, Value>::compactionInputs(size_t& first) const {
+	first = 0;
+	if (this->tables.size() < 2) {
+		return 0;
+	}
+	if (this->compactionRequested) {
+		return this->tables.size();
+	}
+
+	//a run may sit behind newer tables of a lower tier, flushed while the merge producing its last table ran
+	size_t end = this->tables.size();
+	while (end > 0) {
+		unsigned int tier = this->tierOf(this->tables[end - 1]->count());
+		size_t start = end - 1;
+		while (start > 0 && this->tierOf(this->tables[start - 1]->count()) == tier) {
+			start--;
+		}
+
+		if (end - start >= this->compactionTrigger) {
+			first = start;
+			return end - start;
+		}
+		end = start;
+	}
+
+	return 0;
+}
+
+template<typename Key, typename Value>
+void LSM<Key, Value>::backgroundWork() {
+	std::unique_lock<std::mutex> lock(this->mutex);
+	while (true) {
+		this->changed.wait(lock, [this] {
+			size_t first;
+			return this->stopping || (!this->backgroundFailed && (this->frozen || this->compactionInputs(first) > 0));
+		});
+		if (this->stopping) {
+			return;
+		}
+
+		if (this->frozen) {
+			std::shared_ptr<Memtable> flushed = this->frozen;
+			std::uint64_t sequence = this->frozenSequence;
+			std::vector<std::uint64_t> logs = this->frozenLogs;
+			lock.unlock();
+
+			std::shared_ptr<Table> table = this->writeFrozen(*flushed, sequence);
+			if (table) {
+				std::error_code error;
+				for (const std::uint64_t& log : logs) {
+					std::filesystem::remove(this->logPath(log), error);
+				}
+			}
+
+			lock.lock();
+			if (table) {
+				this->tables.push_back(table);
+				this->frozen.reset();
+			} else {
+				this->backgroundFailed = true;
+			}
+			this->changed.notify_all();
+			continue;
+		}
+
+		//only this thread changes the tables, so they are the same when the merged table replaces them
+		size_t first;
+		size_t count = this->compactionInputs(first);
+		std::vector<std::shared_ptr<Table>> inputs(this->tables.begin() + first, this->tables.begin() + first + count);
+		bool requested = this->compactionRequested;
+		lock.unlock();
+
+		std::shared_ptr<Table> merged = this->merge(inputs, first == 0);
+
+		lock.lock();
+		if (merged) {
+			for (const std::shared_ptr<Table>& input : inputs) {
+				input->markObsolete();
+			}
+			this->tables.erase(this->tables.begin() + first, this->tables.begin() + first + count);
+			this->tables.insert(this->tables.begin() + first, merged);
+		} else {
+			this->backgroundFailed = true;
+		}
+		//compact may have asked while a tier was merged, a merge leaving one table fulfils its request too
+		if (requested || !merged || this->tables.size() <= 1) {
+			this->compactionRequested = false;
+		}
+		this->changed.notify_all();
+	}
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::find(const Key& key, Entry& entry) {
+	const Entry* current = this->memtable->getValue(key);
+	if (current) {
+		entry = *current;
+		return true;
+	}
+
+	//the background thread publishes under the mutex, so the frozen memtable and the tables stay alive while it is held
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (this->frozen && (current = this->frozen->getValue(key))) {
+		entry = *current;
+		return true;
+	}
+
+	for (size_t i = this->tables.size(); i > 0; i--) {
+		if (this->tables[i - 1]->find(key, entry)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template<typename Key, typename Value>
+void LSM<Key, Value>::insert(const Key& key, const Value& value) {
+	Entry entry{ value, false };
+	this->wal->logInsert(key, entry);
+	this->memtable->insert(key, entry);
+
+	if (++this->memtableUpdates >= this->memtableEntries) {
+		this->freeze();
+	}
+}
+
+template<typename Key, typename Value>
+void LSM<Key, Value>::remove(const Key& key) {
+	Entry entry{};
+	entry.removed = true;
+	this->wal->logInsert(key, entry);
+	this->memtable->insert(key, entry);
+
+	if (++this->memtableUpdates >= this->memtableEntries) {
+		this->freeze();
+	}
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::getValue(const Key& key, Value& value) {
+	Entry entry;
+	if (!this->find(key, entry) || entry.removed) {
+		return false;
+	}
+
+	value = entry.value;
+
+	return true;
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::contains(const Key& key) {
+	Entry entry;
+
+	return this->find(key, entry) && !entry.removed;
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::commit() {
+	return this->wal->commit();
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::flush() {
+	if (this->memtableUpdates > 0 && !this->freeze()) {
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+	size_t first;
+	this->changed.wait(lock, [this, &first] { return (!this->frozen && this->compactionInputs(first) == 0) || this->backgroundFailed; });
+
+	return !this->backgroundFailed;
+}
+
+template<typename Key, typename Value>
+bool LSM<Key, Value>::compact() {
+	if (!this->flush()) {
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+	if (this->tables.size() < 2) {
+		return true;
+	}
+
+	this->compactionRequested = true;
+	this->changed.notify_all();
+	this->changed.wait(lock, [this] { return !this->compactionRequested || this->backgroundFailed; });
+
+	return !this->backgroundFailed;
+}
+
+template<typename Key, typename Value>
+unsigned int LSM<Key, Value>::tablesCount() {
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	return (unsigned int)this->tables.size();
+}
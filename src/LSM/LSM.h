@@ -0,0 +1,313 @@
+#ifndef LSM_H
+#define LSM_H
+
+#include<vector>
+#include<string>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<condition_variable>
+#include<cstdint>
+#include "../SkipList/SkipList.h"
+#include "../BloomFilter/BlockedBloomFilter.h"
+#include "../WAL/WAL.h"
+#include "../Persistence/MappedFile.h"
+
+/// <summary>
+/// A template class representing a log-structured merge key-value store kept in a directory
+/// Updates go to a SkipList memtable and its write-ahead log; when the memtable holds memtableEntries updates
+/// it is frozen and a background thread writes it to an immutable sorted table. Reads check the memtable,
+/// the frozen memtable and the tables newest-first
+/// Compactions are size-tiered: a table is in tier t when it holds at least memtableEntries * compactionTrigger^t entries
+/// and fewer than memtableEntries * compactionTrigger^(t + 1), and when compactionTrigger consecutive tables or more share
+/// a tier the thread merges them into one of the next tier, so an entry is rewritten about log(N / memtableEntries)
+/// times, with the logarithm to the base compactionTrigger
+/// A table is fixed-size records in blocks, the first key of every block as an index and a BlockedBloomFilter,
+/// tables are memory-mapped, so a lookup reads the filter and then one block at most
+/// Removes are stored as tombstones until a compaction includes the oldest table
+/// The store is used from one thread at a time, only the flushes and compactions run concurrently with it
+/// Key and Value must be trivially copyable, the files are read back only by a build with the same types and byte order
+/// </summary>
+template<typename Key, typename Value>
+class LSM
+{
+	private:
+		/// <summary>
+		/// The value of a key in the memtable, in the write-ahead log and in the tables, or the tombstone of a removed key
+		/// </summary>
+		struct Entry {
+			Value value;
+			bool removed;
+		};
+
+		typedef SkipList<Key, Entry> Memtable;
+
+		/// <summary>
+		/// The last bytes of a table file
+		/// </summary>
+		struct TableFooter {
+			std::uint64_t count;
+			std::uint64_t indexOffset;
+			std::uint64_t filterOffset;
+			std::uint64_t filterBytes;
+			std::uint64_t firstSequence;
+			std::uint64_t lastSequence;
+			std::uint32_t keySize;
+			std::uint32_t valueSize;
+			std::uint32_t blockRecords;
+			std::uint32_t checksum;
+			char magic[8];
+		};
+
+		static constexpr size_t recordSize = sizeof(Key) + sizeof(Value) + 1;
+
+		/// <summary>
+		/// An immutable sorted table, holding the updates of the memtables numbered firstSequence to lastSequence
+		/// A table replaced by a compaction deletes its file when the last reader releases it
+		/// </summary>
+		class Table
+		{
+			private:
+				MappedFile file;
+				BlockedBloomFilter<Key> filter;
+				TableFooter footer;
+				std::string path;
+				const char* records;
+				const char* index;
+				bool obsolete;
+
+			public:
+				Table();
+				~Table();
+
+				Table(const Table&) = delete;
+				Table& operator=(const Table&) = delete;
+
+				/// <summary>
+				/// Maps a table file and checks its footer
+				/// </summary>
+				/// <return>bool whether the file is a whole table for the key and value types</return>
+				bool open(const std::string&);
+
+				/// <summary>
+				/// Finds the entry of a key
+				/// </summary>
+				/// <param>const Key& the key</param>
+				/// <param>Entry& receives the entry if the key is in the table</param>
+				/// <return>bool whether the key is in the table</return>
+				bool find(const Key&, Entry&) const;
+
+				/// <summary>
+				/// Reads the record at a position, the records are sorted by key
+				/// </summary>
+				void read(const std::uint64_t&, Key&, Entry&) const;
+
+				std::uint64_t count() const;
+				std::uint64_t firstSequence() const;
+				std::uint64_t lastSequence() const;
+
+				/// <summary>
+				/// Marks the file to be deleted with the table
+				/// </summary>
+				void markObsolete();
+		};
+
+		/// <summary>
+		/// Writes a table from entries added in ascending order of the keys
+		/// </summary>
+		class TableWriter
+		{
+			private:
+				AppendFile file;
+				BlockedBloomFilter<Key> filter;
+				std::vector<char> buffer;
+				std::vector<Key> firstKeys;
+				std::uint32_t blockRecords;
+				std::uint64_t count;
+				bool failed;
+
+				void flushBuffer();
+
+			public:
+				/// <summary>
+				/// Creates a table file, replacing a file left by an interrupted write
+				/// </summary>
+				/// <param>const std::string& the path of the file</param>
+				/// <param>const std::uint64_t& the expected number of entries, used to size the filter</param>
+				/// <param>const unsigned int& the size of a block in bytes</param>
+				TableWriter(const std::string&, const std::uint64_t&, const unsigned int&);
+
+				void add(const Key&, const Entry&);
+
+				/// <summary>
+				/// Writes the index, the filter and the footer and waits until the file is on the disk
+				/// </summary>
+				/// <return>bool whether the whole table was written</return>
+				bool finish(const std::uint64_t&, const std::uint64_t&);
+		};
+
+		static constexpr unsigned int blockSize = 4096;
+
+		std::string directory;
+		unsigned int memtableEntries;
+		unsigned int compactionTrigger;
+		unsigned int walGroupSize;
+
+		std::unique_ptr<Memtable> memtable;
+		std::unique_ptr<WAL<Key, Entry>> wal;
+		std::uint64_t memtableSequence;
+		unsigned int memtableUpdates;
+		/// <summary>
+		/// Logs replayed into the memtable when the store was opened, deleted once the memtable is in a table
+		/// </summary>
+		std::vector<std::uint64_t> replayedLogs;
+
+		//shared with the background thread
+		std::mutex mutex;
+		std::condition_variable changed;
+		std::shared_ptr<Memtable> frozen;
+		std::uint64_t frozenSequence;
+		std::vector<std::uint64_t> frozenLogs;
+		std::vector<std::shared_ptr<Table>> tables;
+		bool compactionRequested;
+		bool backgroundFailed;
+		bool stopping;
+		std::thread worker;
+
+		std::string tablePath(const std::uint64_t&, const std::uint64_t&) const;
+		std::string logPath(const std::uint64_t&) const;
+
+		/// <summary>
+		/// Opens the write-ahead log of the memtable, replaying the log into the memtable if it exists
+		/// If the log cannot be opened, the updates wait in the log buffer and commit reports the failure
+		/// </summary>
+		/// <param>const std::uint64_t& the sequence number of the memtable</param>
+		/// <return>bool whether the log was opened</return>
+		bool openLog(const std::uint64_t&);
+
+		/// <summary>
+		/// Hands the memtable to the background thread and starts a new one, waiting while the previous one is still being flushed
+		/// </summary>
+		/// <return>bool whether a new memtable was started</return>
+		bool freeze();
+
+		/// <summary>
+		/// Writes the frozen memtable to a table, called by the background thread without holding the mutex
+		/// </summary>
+		/// <return>std::shared_ptr<Table> the new table or nullptr if it could not be written</return>
+		std::shared_ptr<Table> writeFrozen(const Memtable&, const std::uint64_t&) const;
+
+		/// <summary>
+		/// Merges consecutive tables into one, the newest entry of a key wins
+		/// </summary>
+		/// <param>const std::vector<std::shared_ptr<Table>>& the tables, oldest first</param>
+		/// <param>const bool& whether to drop the tombstones, only when the oldest table is merged, else a dropped tombstone would uncover an older entry</param>
+		/// <return>std::shared_ptr<Table> the merged table or nullptr if it could not be written</return>
+		std::shared_ptr<Table> merge(const std::vector<std::shared_ptr<Table>>&, const bool&) const;
+
+		/// <summary>
+		/// Getter for the size tier of a table
+		/// </summary>
+		/// <param>const std::uint64_t& the number of entries of the table</param>
+		/// <return>unsigned int 0 below memtableEntries * compactionTrigger entries, one more for every further factor of compactionTrigger</return>
+		unsigned int tierOf(const std::uint64_t&) const;
+
+		/// <summary>
+		/// Chooses the tables of the next compaction, the newest run of consecutive tables of one tier long enough,
+		/// or all tables when a compaction was requested, called with the mutex held
+		/// </summary>
+		/// <param>size_t& receives the index of the first table to merge</param>
+		/// <return>size_t the number of tables to merge, 0 if no compaction is due</return>
+		size_t compactionInputs(size_t&) const;
+
+		/// <summary>
+		/// The loop of the background thread, flushing frozen memtables and compacting tables
+		/// </summary>
+		void backgroundWork();
+
+		/// <summary>
+		/// Stops the background thread and closes the store
+		/// </summary>
+		void close();
+
+		/// <summary>
+		/// Finds the newest entry of a key
+		/// </summary>
+		/// <return>bool whether the key has an entry, which may be a tombstone</return>
+		bool find(const Key&, Entry&);
+
+	public:
+		/// <summary>
+		/// Creates a closed store
+		/// </summary>
+		/// <param>const unsigned int& the number of updates which freezes the memtable, default is 65536</param>
+		/// <param>const unsigned int& the number of tables which starts a compaction, default is 4</param>
+		/// <param>const unsigned int& the number of updates committed to the write-ahead log together, default is 1024</param>
+		LSM(const unsigned int& = 1 << 16, const unsigned int& = 4, const unsigned int& = 1024);
+
+		LSM(const LSM&) = delete;
+		LSM& operator=(const LSM&) = delete;
+
+		/// <summary>
+		/// Commits the write-ahead log and stops the background thread, a frozen memtable not yet flushed is replayed from its log by the next open
+		/// </summary>
+		~LSM();
+
+		/// <summary>
+		/// Opens the store in a directory, creating the directory if needed
+		/// Tables left incomplete by a crash and tables replaced by a compaction are deleted, the logs of memtables
+		/// which were not flushed are replayed
+		/// </summary>
+		/// <param>const std::string& the path of the directory</param>
+		/// <return>bool whether the store was opened</return>
+		bool open(const std::string&);
+
+		/// <summary>
+		/// Inserts a key-value pair or updates the value of an existing key
+		/// </summary>
+		void insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Removes a key
+		/// </summary>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Getter for the value of a key
+		/// </summary>
+		/// <param>const Key& the key</param>
+		/// <param>Value& receives the value if the key is in the store</param>
+		/// <return>bool whether the key is in the store</return>
+		bool getValue(const Key&, Value&);
+
+		/// <summary>
+		/// Checks whether a key is inside the store
+		/// </summary>
+		bool contains(const Key&);
+
+		/// <summary>
+		/// Makes the updates durable by committing the write-ahead log
+		/// </summary>
+		/// <return>bool whether the log was committed</return>
+		bool commit();
+
+		/// <summary>
+		/// Freezes the memtable if it holds updates and waits until all frozen memtables are written to tables
+		/// and the compactions they made due are done
+		/// </summary>
+		/// <return>bool false if the background thread failed to write a table</return>
+		bool flush();
+
+		/// <summary>
+		/// Flushes the memtable and waits until the background thread has merged all tables into one
+		/// </summary>
+		/// <return>bool false if the background thread failed to write a table</return>
+		bool compact();
+
+		/// <summary>
+		/// Getter for the number of tables
+		/// </summary>
+		unsigned int tablesCount();
+};
+
+#endif
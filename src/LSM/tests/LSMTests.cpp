@@ -0,0 +1,218 @@
+#include "src/Doctest/doctest.h"
+#include "src/LSM/LSM.cpp"
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+
+static const char* lsmDirectory = "LSMTest";
+
+bool matches(LSM<int, int>& store, const std::map<int, int>& expected, const int& keysCount) {
+	for (int key = 0; key < keysCount; key++) {
+		int value;
+		bool found = store.getValue(key, value);
+		auto it = expected.find(key);
+		if (found != (it != expected.end()) || (found && value != it->second) || store.contains(key) != found) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+TEST_CASE("LSM Insert and remove across flushes and compactions") {
+	std::filesystem::remove_all(lsmDirectory);
+	LSM<int, int> store{ 1000, 3 };
+	REQUIRE(store.open(lsmDirectory));
+
+	std::map<int, int> expected;
+	std::mt19937 generator{ 17 };
+	for (int i = 0; i < 30000; i++) {
+		int key = generator() % 5000;
+		if (i % 4) {
+			store.insert(key, i);
+			expected[key] = i;
+		} else {
+			store.remove(key);
+			expected.erase(key);
+		}
+	}
+
+	CHECK(matches(store, expected, 5000));
+	REQUIRE(store.flush());
+	CHECK(store.tablesCount() >= 1);
+	CHECK(matches(store, expected, 5000));
+
+	REQUIRE(store.compact());
+	CHECK(store.tablesCount() == 1);
+	CHECK(matches(store, expected, 5000));
+	std::filesystem::remove_all(lsmDirectory);
+}
+
+TEST_CASE("LSM Newest entry wins") {
+	std::filesystem::remove_all(lsmDirectory);
+	LSM<int, int> store{ 100 };
+	REQUIRE(store.open(lsmDirectory));
+
+	store.insert(1, 1);
+	store.insert(2, 2);
+	REQUIRE(store.flush());
+	store.insert(1, 10);
+	store.remove(2);
+	REQUIRE(store.flush());
+	CHECK(store.tablesCount() == 2);
+
+	int value = 0;
+	CHECK(store.getValue(1, value));
+	CHECK(value == 10);
+	CHECK(store.contains(2) == false);
+
+	store.insert(1, 100);
+	CHECK(store.getValue(1, value));
+	CHECK(value == 100);
+
+	REQUIRE(store.compact());
+	CHECK(store.getValue(1, value));
+	CHECK(value == 100);
+	CHECK(store.contains(2) == false);
+	std::filesystem::remove_all(lsmDirectory);
+}
+
+TEST_CASE("LSM Size-tiered compactions") {
+	std::filesystem::remove_all(lsmDirectory);
+	LSM<int, int> store{ 100, 4 };
+	REQUIRE(store.open(lsmDirectory));
+
+	//every 100 inserts fill a table, four of them are merged into one of 400 entries in the next tier
+	for (int i = 0; i < 600; i++) {
+		store.insert(i, i);
+	}
+	REQUIRE(store.flush());
+	CHECK(store.tablesCount() == 3);
+
+	//the merge of the newest tables keeps their tombstones, which still hide the keys in the oldest table
+	for (int i = 0; i < 100; i++) {
+		store.remove(i);
+	}
+	for (int i = 600; i < 700; i++) {
+		store.insert(i, i);
+	}
+	REQUIRE(store.flush());
+	CHECK(store.tablesCount() == 2);
+
+	std::map<int, int> expected;
+	for (int i = 100; i < 700; i++) {
+		expected[i] = i;
+	}
+	CHECK(matches(store, expected, 800));
+
+	//ten more tables: two more runs of four are merged, then the four tables of the next tier, behind the newest two
+	for (int i = 700; i < 1700; i++) {
+		store.insert(i, i);
+		expected[i] = i;
+	}
+	REQUIRE(store.flush());
+	CHECK(store.tablesCount() == 3);
+	CHECK(matches(store, expected, 1800));
+	std::filesystem::remove_all(lsmDirectory);
+}
+
+TEST_CASE("LSM Compact when its flush starts a compaction") {
+	std::filesystem::remove_all(lsmDirectory);
+	LSM<int, int> store{ 100, 4 };
+	REQUIRE(store.open(lsmDirectory));
+
+	std::map<int, int> expected;
+	for (int i = 0; i < 300; i++) {
+		store.insert(i, i);
+		expected[i] = i;
+	}
+	REQUIRE(store.flush());
+	CHECK(store.tablesCount() == 3);
+
+	//the flush of compact brings the tables to the trigger, the merge it starts already leaves one table
+	for (int i = 300; i < 310; i++) {
+		store.insert(i, i);
+		expected[i] = i;
+	}
+	REQUIRE(store.compact());
+	CHECK(store.tablesCount() == 1);
+	CHECK(matches(store, expected, 400));
+	std::filesystem::remove_all(lsmDirectory);
+}
+
+TEST_CASE("LSM Reopen from tables and logs") {
+	std::filesystem::remove_all(lsmDirectory);
+	std::map<int, int> expected;
+	{
+		LSM<int, int> store{ 500 };
+		REQUIRE(store.open(lsmDirectory));
+		for (int i = 0; i < 1200; i++) {
+			store.insert(i * 7 % 2000, i);
+			expected[i * 7 % 2000] = i;
+		}
+		store.remove(7);
+		expected.erase(7);
+		REQUIRE(store.commit());
+	}
+
+	LSM<int, int> store{ 500 };
+	REQUIRE(store.open(lsmDirectory));
+	CHECK(matches(store, expected, 2000));
+
+	store.insert(5000, 1);
+	REQUIRE(store.compact());
+	CHECK(store.contains(5000));
+	CHECK(matches(store, expected, 2000));
+	std::filesystem::remove_all(lsmDirectory);
+}
+
+TEST_CASE("LSM Interrupted table writes and compactions") {
+	std::filesystem::remove_all(lsmDirectory);
+	{
+		LSM<int, int> store{ 100 };
+		REQUIRE(store.open(lsmDirectory));
+		for (int i = 0; i < 100; i++) {
+			store.insert(i, i);
+		}
+		REQUIRE(store.flush());
+		for (int i = 0; i < 100; i++) {
+			store.insert(i, -i);
+		}
+		REQUIRE(store.flush());
+	}
+
+	//the inputs of a compaction which crashed before deleting them
+	std::vector<std::string> tables;
+	for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator(lsmDirectory)) {
+		tables.push_back(file.path().string());
+	}
+	std::filesystem::create_directories(std::string(lsmDirectory) + "/inputs");
+	for (const std::string& table : tables) {
+		std::filesystem::copy_file(table, std::string(lsmDirectory) + "/inputs/" + std::filesystem::path(table).filename().string());
+	}
+	{
+		LSM<int, int> store{ 100 };
+		REQUIRE(store.open(lsmDirectory));
+		REQUIRE(store.compact());
+	}
+	for (const std::string& table : tables) {
+		std::filesystem::copy_file(std::string(lsmDirectory) + "/inputs/" + std::filesystem::path(table).filename().string(), table, std::filesystem::copy_options::overwrite_existing);
+	}
+	std::filesystem::remove_all(std::string(lsmDirectory) + "/inputs");
+
+	//a table whose write was interrupted
+	{
+		std::ofstream out(std::string(lsmDirectory) + "/table-00000000000000000099-00000000000000000099.sst", std::ios::binary);
+		out << "partial";
+	}
+
+	LSM<int, int> store{ 100 };
+	REQUIRE(store.open(lsmDirectory));
+	CHECK(store.tablesCount() == 1);
+	int value = 0;
+	CHECK(store.getValue(5, value));
+	CHECK(value == -5);
+	CHECK(std::filesystem::exists(std::string(lsmDirectory) + "/table-00000000000000000099-00000000000000000099.sst") == false);
+	std::filesystem::remove_all(lsmDirectory);
+}
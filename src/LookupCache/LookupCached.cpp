@@ -0,0 +1,112 @@
+#include "LookupCached.h"
+#include <functional>
+
+template<typename Key, typename Value, typename Structure>
+LookupCached<Key, Value, Structure>::Slot::Slot() :
+	key(),
+	value(nullptr),
+	epoch(0) {}
+
+template<typename Key, typename Value, typename Structure>
+Structure* LookupCached<Key, Value, Structure>::createStructure(const unsigned int& expectedElements, std::true_type) {
+	return new Structure{ expectedElements };
+}
+
+template<typename Key, typename Value, typename Structure>
+Structure* LookupCached<Key, Value, Structure>::createStructure(const unsigned int&, std::false_type) {
+	return new Structure{};
+}
+
+template<typename Key, typename Value, typename Structure>
+LookupCached<Key, Value, Structure>::LookupCached(const unsigned int& expectedElements, const unsigned int& slotsCount) :
+	structure(createStructure(expectedElements, std::is_constructible<Structure, const unsigned int&>{})),
+	epoch(1),
+	hits(0),
+	misses(0)
+{
+	unsigned int size = 1;
+	while (size < slotsCount) {
+		size *= 2;
+	}
+
+	this->slots.resize(size);
+}
+
+template<typename Key, typename Value, typename Structure>
+LookupCached<Key, Value, Structure>::~LookupCached() {
+	delete this->structure;
+}
+
+template<typename Key, typename Value, typename Structure>
+typename LookupCached<Key, Value, Structure>::Slot& LookupCached<Key, Value, Structure>::slotOf(const Key& key) const {
+	std::uint64_t h = (std::uint64_t)std::hash<Key>{}(key);
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+
+	return this->slots[(size_t)(h & (this->slots.size() - 1))];
+}
+
+template<typename Key, typename Value, typename Structure>
+void LookupCached<Key, Value, Structure>::insert(const Key& key, const Value& value) {
+	this->structure->insert(key, value);
+	this->slotOf(key).epoch = 0;
+}
+
+template<typename Key, typename Value, typename Structure>
+const Value* LookupCached<Key, Value, Structure>::getValue(const Key& key) const {
+	Slot& slot = this->slotOf(key);
+	if (slot.epoch == this->epoch && !(slot.key < key) && !(key < slot.key)) {
+		this->hits++;
+		return slot.value;
+	}
+
+	//absent keys are cached too, with a null value
+	this->misses++;
+	slot.key = key;
+	slot.value = this->structure->getValue(key);
+	slot.epoch = this->epoch;
+
+	return slot.value;
+}
+
+template<typename Key, typename Value, typename Structure>
+bool LookupCached<Key, Value, Structure>::contains(const Key& key) const {
+	return this->getValue(key) != nullptr;
+}
+
+template<typename Key, typename Value, typename Structure>
+void LookupCached<Key, Value, Structure>::remove(const Key& key) {
+	this->structure->remove(key);
+	this->epoch++;
+}
+
+template<typename Key, typename Value, typename Structure>
+unsigned long long LookupCached<Key, Value, Structure>::cacheHits() const {
+	return this->hits;
+}
+
+template<typename Key, typename Value, typename Structure>
+unsigned long long LookupCached<Key, Value, Structure>::cacheMisses() const {
+	return this->misses;
+}
+
+template<typename Key, typename Value, typename Structure>
+double LookupCached<Key, Value, Structure>::hitRate() const {
+	if (!this->hits && !this->misses) {
+		return 0;
+	}
+
+	return (double)this->hits / (this->hits + this->misses);
+}
+
+template<typename Key, typename Value, typename Structure>
+void LookupCached<Key, Value, Structure>::resetCounters() {
+	this->hits = 0;
+	this->misses = 0;
+}
+
+template<typename Key, typename Value, typename Structure>
+const Structure& LookupCached<Key, Value, Structure>::getStructure() const {
+	return *this->structure;
+}
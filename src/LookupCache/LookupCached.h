@@ -0,0 +1,109 @@
+#ifndef LOOKUPCACHED_H
+#define LOOKUPCACHED_H
+
+#include<vector>
+#include<cstdint>
+#include<type_traits>
+
+/// <summary>
+/// A template class putting a direct-mapped cache of recent lookups in front of a structure with
+/// the insert/getValue/contains/remove interface, e.g. AVL or SkipList, so that repeated lookups of hot keys
+/// cost a single probe instead of a search
+/// A slot remembers a key and the address of its value inside the structure or that the key is absent
+/// The structure must keep the addresses of the values of other keys on insert, as AVL and SkipList do -
+/// insert invalidates only the slot of its key while remove invalidates all slots at once,
+/// as removing from an AVL tree may move values between nodes
+/// </summary>
+template<typename Key, typename Value, typename Structure>
+class LookupCached
+{
+	private:
+		struct Slot {
+			Key key;
+			const Value* value;
+			std::uint64_t epoch;
+
+			Slot();
+		};
+
+		/// <summary>
+		/// Creates the structure, passing the expected number of elements to the structures taking it (SkipList)
+		/// </summary>
+		static Structure* createStructure(const unsigned int&, std::true_type);
+		static Structure* createStructure(const unsigned int&, std::false_type);
+
+		/// <summary>
+		/// Finds the slot of a key by a mixed std::hash
+		/// </summary>
+		Slot& slotOf(const Key&) const;
+
+		Structure* structure;
+		mutable std::vector<Slot> slots;
+
+		/// <summary>
+		/// Slots written in an older epoch are empty, increasing it empties all slots
+		/// </summary>
+		std::uint64_t epoch;
+		mutable unsigned long long hits;
+		mutable unsigned long long misses;
+	public:
+		~LookupCached();
+		LookupCached(const LookupCached&) = delete;
+		LookupCached& operator=(const LookupCached&) = delete;
+
+		/// <summary>
+		/// Creates an empty structure with a cache of a number of slots
+		/// </summary>
+		/// <param>const unsigned int& the expected number of elements of the structure</param>
+		/// <param>const unsigned int& the number of slots, rounded up to a power of 2, default is 65536</param>
+		LookupCached(const unsigned int&, const unsigned int& = 65536);
+
+		/// <summary>
+		/// Inserts a key-value pair into the structure and invalidates the slot of the key
+		/// </summary>
+		void insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Getter for the value of a key, answered from the cache if the key was looked up recently
+		/// </summary>
+		/// <return>const Value* the value or nullptr if the key is not in the structure</return>
+		const Value* getValue(const Key&) const;
+
+		/// <summary>
+		/// Checks whether a key is inside the structure, answered from the cache if the key was looked up recently
+		/// </summary>
+		bool contains(const Key&) const;
+
+		/// <summary>
+		/// Removes a key from the structure and invalidates all slots
+		/// </summary>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Getter for the number of lookups answered from the cache
+		/// </summary>
+		unsigned long long cacheHits() const;
+
+		/// <summary>
+		/// Getter for the number of lookups which searched the structure
+		/// </summary>
+		unsigned long long cacheMisses() const;
+
+		/// <summary>
+		/// Getter for the share of lookups answered from the cache
+		/// </summary>
+		/// <return>double the hit rate between 0 and 1, 0 if there were no lookups</return>
+		double hitRate() const;
+
+		/// <summary>
+		/// Clears the hit and miss counters
+		/// </summary>
+		void resetCounters();
+
+		/// <summary>
+		/// Getter for the structure behind the cache
+		/// </summary>
+		const Structure& getStructure() const;
+};
+
+#endif
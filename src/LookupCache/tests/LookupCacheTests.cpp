@@ -0,0 +1,61 @@
+#include "src/Doctest/doctest.h"
+#include "src/LookupCache/LookupCached.cpp"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+
+TEST_CASE("LookupCached Hits") {
+	LookupCached<int, int, AVL<int, int>> tree{ 100 };
+	for (int i = 0; i < 100; i++) {
+		tree.insert(i, i * 10);
+	}
+
+	CHECK(*tree.getValue(5) == 50);
+	CHECK(*tree.getValue(5) == 50);
+	CHECK(tree.contains(5));
+	CHECK(tree.cacheHits() == 2);
+	CHECK(tree.cacheMisses() == 1);
+	CHECK(tree.hitRate() == doctest::Approx(2.0 / 3));
+
+	tree.resetCounters();
+	CHECK(tree.hitRate() == 0);
+}
+
+TEST_CASE("LookupCached Insert after a cached miss") {
+	LookupCached<int, int, SkipList<int, int>> skipList{ 100 };
+	CHECK(skipList.contains(7) == false);
+	CHECK(skipList.contains(7) == false);
+
+	skipList.insert(7, 70);
+	CHECK(*skipList.getValue(7) == 70);
+
+	skipList.insert(7, 71);
+	CHECK(*skipList.getValue(7) == 71);
+}
+
+TEST_CASE("LookupCached Remove invalidates moved values") {
+	//removing the root of an AVL tree copies its predecessor into the root node and deletes the predecessor node
+	LookupCached<int, int, AVL<int, int>> tree{ 3 };
+	tree.insert(1, 10);
+	tree.insert(2, 20);
+	tree.insert(3, 30);
+	CHECK(*tree.getValue(1) == 10);
+
+	tree.remove(2);
+	CHECK(tree.contains(2) == false);
+	CHECK(*tree.getValue(1) == 10);
+	CHECK(tree.getStructure().nodesCount() == 2);
+}
+
+TEST_CASE("LookupCached Colliding keys") {
+	LookupCached<int, int, SkipList<int, int>> skipList{ 1000, 1 };
+	for (int i = 0; i < 1000; i++) {
+		skipList.insert(i, i);
+	}
+
+	bool same = true;
+	for (int i = 0; i < 2000; i++) {
+		const int* value = skipList.getValue(i % 1000);
+		same = same && value && *value == i % 1000;
+	}
+	CHECK(same);
+}
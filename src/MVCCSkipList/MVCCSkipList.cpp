@@ -0,0 +1,322 @@
+#include "MVCCSkipList.h"
+#include <math.h>
+#include <limits>
+
+template<typename Key, typename Value>
+MVCCSkipList<Key, Value>::Node::Node(const Key& _key, const Value& _value, const std::uint64_t& _sequence, const bool& _removed, const unsigned int& _height) :
+	key(_key),
+	value(_value),
+	sequence(_sequence),
+	removed(_removed),
+	height(_height),
+	forward(new std::atomic<Node*>[_height])
+{
+	for (unsigned int i = 0; i < this->height; i++) {
+		this->forward[i].store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+template<typename Key, typename Value>
+MVCCSkipList<Key, Value>::Node::Node(const unsigned int& _height) :
+	key(),
+	value(),
+	sequence(0),
+	removed(false),
+	height(_height),
+	forward(new std::atomic<Node*>[_height])
+{
+	for (unsigned int i = 0; i < this->height; i++) {
+		this->forward[i].store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+template<typename Key, typename Value>
+MVCCSkipList<Key, Value>::Node::~Node() {
+	delete[] this->forward;
+}
+
+template<typename Key, typename Value>
+MVCCSkipList<Key, Value>::Snapshot::Snapshot(MVCCSkipList* _list, const std::uint64_t& _at) :
+	list(_list),
+	at(_at) {}
+
+template<typename Key, typename Value>
+MVCCSkipList<Key, Value>::Snapshot::Snapshot(Snapshot&& other) noexcept :
+	list(other.list),
+	at(other.at)
+{
+	other.list = nullptr;
+}
+
+template<typename Key, typename Value>
+MVCCSkipList<Key, Value>::Snapshot::~Snapshot() {
+	if (this->list) {
+		this->list->releaseSnapshot(this->at);
+	}
+}
+
+template<typename Key, typename Value>
+std::uint64_t MVCCSkipList<Key, Value>::Snapshot::sequence() const {
+	return this->at;
+}
+
+template<typename Key, typename Value>
+MVCCSkipList<Key, Value>::MVCCSkipList(const unsigned int& maximumElements, const float& _probability) :
+	maxLevel(maximumElements > 0 ? std::log2(maximumElements) : 0),
+	probability(_probability),
+	distribution(0.0, 1.0),
+	lastSequence(0),
+	versions(0),
+	epoch(0),
+	retiredEpoch(0)
+{
+	this->head = new Node(this->maxLevel + 1);
+	this->readers[0].store(0);
+	this->readers[1].store(0);
+}
+
+template<typename Key, typename Value>
+MVCCSkipList<Key, Value>::~MVCCSkipList() {
+	for (Node* node : this->retired) {
+		delete node;
+	}
+
+	Node* current = this->head;
+	while (current) {
+		Node* next = current->forward[0].load(std::memory_order_relaxed);
+		delete current;
+		current = next;
+	}
+}
+
+template<typename Key, typename Value>
+std::uint64_t MVCCSkipList<Key, Value>::beginRead() const {
+	while (true) {
+		std::uint64_t current = this->epoch.load();
+		this->readers[current & 1].fetch_add(1);
+		//a gc advancing the epoch between the two loads may already have checked the counter
+		if (this->epoch.load() == current) {
+			return current;
+		}
+		this->readers[current & 1].fetch_sub(1);
+	}
+}
+
+template<typename Key, typename Value>
+void MVCCSkipList<Key, Value>::endRead(const std::uint64_t& current) const {
+	this->readers[current & 1].fetch_sub(1, std::memory_order_release);
+}
+
+template<typename Key, typename Value>
+size_t MVCCSkipList<Key, Value>::freeRetired() {
+	if (this->retired.empty() || this->readers[this->retiredEpoch & 1].load() != 0) {
+		return 0;
+	}
+
+	size_t freed = this->retired.size();
+	for (Node* node : this->retired) {
+		delete node;
+	}
+	this->retired.clear();
+
+	return freed;
+}
+
+template<typename Key, typename Value>
+unsigned int MVCCSkipList<Key, Value>::generateLevel() {
+	unsigned int levels = 0;
+
+	while (this->distribution(this->generator) < this->probability && levels < this->maxLevel) {
+		levels++;
+	}
+
+	return levels;
+}
+
+template<typename Key, typename Value>
+typename MVCCSkipList<Key, Value>::Node* MVCCSkipList<Key, Value>::findVersion(const Key& key, const std::uint64_t& sequence, Node** update) const {
+	Node* current = this->head;
+
+	for (int i = this->maxLevel; i >= 0; i--) {
+		Node* next = current->forward[i].load(std::memory_order_acquire);
+		//the versions of a key are ordered newest first
+		while (next && (next->key < key || (!(key < next->key) && next->sequence > sequence))) {
+			current = next;
+			next = current->forward[i].load(std::memory_order_acquire);
+		}
+
+		if (update) {
+			update[i] = current;
+		}
+	}
+
+	return current->forward[0].load(std::memory_order_acquire);
+}
+
+template<typename Key, typename Value>
+void MVCCSkipList<Key, Value>::addVersion(const Key& key, const Value& value, const bool& removed) {
+	std::lock_guard<std::mutex> lock(this->updateMutex);
+
+	std::uint64_t sequence = this->lastSequence.load(std::memory_order_relaxed) + 1;
+	std::vector<Node*> update(this->maxLevel + 1);
+	this->findVersion(key, sequence, update.data());
+
+	Node* node = new Node(key, value, sequence, removed, this->generateLevel() + 1);
+	//the node is complete before a read can reach it, readers which miss it on an upper level find it on a lower one
+	for (unsigned int i = 0; i < node->height; i++) {
+		node->forward[i].store(update[i]->forward[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		update[i]->forward[i].store(node, std::memory_order_release);
+	}
+	this->versions++;
+
+	//a snapshot taken from now on sees the version
+	this->lastSequence.store(sequence, std::memory_order_release);
+}
+
+template<typename Key, typename Value>
+bool MVCCSkipList<Key, Value>::getAt(const Key& key, Value& value, const std::uint64_t& sequence) const {
+	std::uint64_t current = this->beginRead();
+
+	Node* node = this->findVersion(key, sequence, nullptr);
+	bool found = node && !(key < node->key) && !node->removed;
+	if (found) {
+		value = node->value;
+	}
+
+	this->endRead(current);
+	return found;
+}
+
+template<typename Key, typename Value>
+void MVCCSkipList<Key, Value>::releaseSnapshot(const std::uint64_t& sequence) {
+	std::lock_guard<std::mutex> lock(this->snapshotsMutex);
+	this->activeSnapshots.erase(this->activeSnapshots.find(sequence));
+}
+
+template<typename Key, typename Value>
+void MVCCSkipList<Key, Value>::insert(const Key& key, const Value& value) {
+	this->addVersion(key, value, false);
+}
+
+template<typename Key, typename Value>
+void MVCCSkipList<Key, Value>::remove(const Key& key) {
+	this->addVersion(key, Value(), true);
+}
+
+template<typename Key, typename Value>
+typename MVCCSkipList<Key, Value>::Snapshot MVCCSkipList<Key, Value>::snapshot() {
+	std::lock_guard<std::mutex> lock(this->snapshotsMutex);
+	std::uint64_t sequence = this->lastSequence.load(std::memory_order_acquire);
+	this->activeSnapshots.insert(sequence);
+
+	return Snapshot(this, sequence);
+}
+
+template<typename Key, typename Value>
+bool MVCCSkipList<Key, Value>::get(const Key& key, Value& value) const {
+	//the newest linked version, gc never unlinks it unless it marks a removed key
+	return this->getAt(key, value, std::numeric_limits<std::uint64_t>::max());
+}
+
+template<typename Key, typename Value>
+bool MVCCSkipList<Key, Value>::get(const Key& key, Value& value, const Snapshot& snapshot) const {
+	return this->getAt(key, value, snapshot.sequence());
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void MVCCSkipList<Key, Value>::forEach(const Snapshot& snapshot, Function function) const {
+	std::uint64_t current = this->beginRead();
+	std::uint64_t sequence = snapshot.sequence();
+
+	const Node* node = this->head->forward[0].load(std::memory_order_acquire);
+	while (node) {
+		//skip the versions newer than the snapshot, the next one is the visible version
+		if (node->sequence > sequence) {
+			node = node->forward[0].load(std::memory_order_acquire);
+			continue;
+		}
+
+		if (!node->removed) {
+			function(node->key, node->value);
+		}
+
+		//skip the older versions of the key
+		const Node* next = node->forward[0].load(std::memory_order_acquire);
+		while (next && !(node->key < next->key)) {
+			next = next->forward[0].load(std::memory_order_acquire);
+		}
+		node = next;
+	}
+
+	this->endRead(current);
+}
+
+template<typename Key, typename Value>
+size_t MVCCSkipList<Key, Value>::gc() {
+	std::lock_guard<std::mutex> lock(this->updateMutex);
+
+	//the retired versions of the previous gc must be freed before the epoch can advance again
+	size_t freed = this->freeRetired();
+	if (!this->retired.empty()) {
+		return freed;
+	}
+
+	std::uint64_t oldest;
+	{
+		std::lock_guard<std::mutex> snapshotsLock(this->snapshotsMutex);
+		//a snapshot taken later sees at least the current versions
+		oldest = this->activeSnapshots.empty() ? this->lastSequence.load(std::memory_order_relaxed) : *this->activeSnapshots.begin();
+	}
+
+	//the last node before the walk on every level which stays linked
+	std::vector<Node*> update(this->maxLevel + 1, this->head);
+	Node* node = this->head->forward[0].load(std::memory_order_relaxed);
+	Node* visible = nullptr;
+	while (node) {
+		Node* next = node->forward[0].load(std::memory_order_relaxed);
+		if (visible && !(visible->key < node->key)) {
+			//older than the version the oldest snapshot reads
+		} else if (node->sequence > oldest) {
+			visible = nullptr;
+			for (unsigned int i = 0; i < node->height; i++) {
+				update[i] = node;
+			}
+			node = next;
+			continue;
+		} else {
+			visible = node;
+			//a removal is unlinked once no older version is left, so a read never skips it to find an older value
+			if (!node->removed || (next && !(node->key < next->key))) {
+				for (unsigned int i = 0; i < node->height; i++) {
+					update[i] = node;
+				}
+				node = next;
+				continue;
+			}
+		}
+
+		//unlinked from the top, a read standing on it still follows its forward pointers
+		for (int i = (int)node->height - 1; i >= 0; i--) {
+			update[i]->forward[i].store(node->forward[i].load(std::memory_order_relaxed), std::memory_order_release);
+		}
+		this->retired.push_back(node);
+		this->versions--;
+		node = next;
+	}
+
+	if (this->retired.empty()) {
+		return freed;
+	}
+
+	//reads starting from now on cannot reach the retired versions
+	this->retiredEpoch = this->epoch.fetch_add(1);
+
+	return freed + this->freeRetired();
+}
+
+template<typename Key, typename Value>
+size_t MVCCSkipList<Key, Value>::versionsCount() {
+	std::lock_guard<std::mutex> lock(this->updateMutex);
+	return this->versions;
+}
@@ -0,0 +1,192 @@
+#ifndef MVCCSKIPLIST_H
+#define MVCCSKIPLIST_H
+
+#include<vector>
+#include<set>
+#include<atomic>
+#include<mutex>
+#include<random>
+#include<cstdint>
+#include<cstddef>
+
+/// <summary>
+/// A template class representing a multi-version Skip list: every insert or remove adds a version of its key
+/// numbered by a sequence number, and the versions of a key are ordered newest first
+/// A snapshot is the sequence number of the last update when it was taken, reads through it see the newest version
+/// of every key not newer than it, so scans read a consistent point-in-time view while updates continue
+/// Updates are serialized by a mutex, reads take no lock: a new version is linked with release stores, and versions
+/// removed by gc are freed only after the reads which may stand on them have ended
+/// </summary>
+template<typename Key, typename Value>
+class MVCCSkipList
+{
+	private:
+		struct Node {
+			Key key;
+			Value value;
+			std::uint64_t sequence;
+			bool removed;
+			unsigned int height;
+			std::atomic<Node*>* forward;
+
+			Node(const Key&, const Value&, const std::uint64_t&, const bool&, const unsigned int&);
+			Node(const unsigned int&);
+			~Node();
+		};
+
+		unsigned int maxLevel;
+		float probability;
+		Node* head;
+
+		//updates
+		std::mutex updateMutex;
+		std::default_random_engine generator;
+		std::uniform_real_distribution<double> distribution;
+		std::atomic<std::uint64_t> lastSequence;
+		size_t versions;
+
+		//snapshots
+		mutable std::mutex snapshotsMutex;
+		std::multiset<std::uint64_t> activeSnapshots;
+
+		/// <summary>
+		/// Reads announce themselves in the counter of the current epoch; gc unlinks versions, advances the epoch
+		/// and frees the versions once the counter of the previous epoch drops to zero
+		/// </summary>
+		mutable std::atomic<std::uint64_t> epoch;
+		mutable std::atomic<unsigned int> readers[2];
+		std::vector<Node*> retired;
+		std::uint64_t retiredEpoch;
+
+		/// <summary>
+		/// Registers a read in the current epoch
+		/// </summary>
+		/// <return>std::uint64_t the epoch to pass to endRead</return>
+		std::uint64_t beginRead() const;
+		void endRead(const std::uint64_t&) const;
+
+		/// <summary>
+		/// Frees the retired versions if no read of their epoch is running
+		/// </summary>
+		/// <return>size_t the number of freed versions</return>
+		size_t freeRetired();
+
+		unsigned int generateLevel();
+
+		/// <summary>
+		/// Finds the first node not before a key and a sequence number in the order of the list
+		/// </summary>
+		/// <param>const Key& the key</param>
+		/// <param>const std::uint64_t& the sequence number, the found node is the newest version of the key not newer than it</param>
+		/// <param>Node** receives the last node before the position at every level or nullptr</param>
+		/// <return>Node* the node or nullptr</return>
+		Node* findVersion(const Key&, const std::uint64_t&, Node**) const;
+
+		/// <summary>
+		/// Links a new version of a key
+		/// </summary>
+		void addVersion(const Key&, const Value&, const bool&);
+
+		/// <summary>
+		/// Reads the version of a key visible at a sequence number
+		/// </summary>
+		bool getAt(const Key&, Value&, const std::uint64_t&) const;
+
+		void releaseSnapshot(const std::uint64_t&);
+
+	public:
+		/// <summary>
+		/// A registered point-in-time view, gc keeps the versions it reads until it is destroyed
+		/// </summary>
+		class Snapshot
+		{
+			private:
+				MVCCSkipList* list;
+				std::uint64_t at;
+
+				Snapshot(MVCCSkipList*, const std::uint64_t&);
+
+				friend class MVCCSkipList;
+
+			public:
+				Snapshot(Snapshot&&) noexcept;
+				Snapshot(const Snapshot&) = delete;
+				Snapshot& operator=(const Snapshot&) = delete;
+				~Snapshot();
+
+				/// <summary>
+				/// Getter for the sequence number of the last update the snapshot sees
+				/// </summary>
+				std::uint64_t sequence() const;
+		};
+
+		/// <summary>
+		/// Creates a list with maximum elements expected and probability for new node levels generation
+		/// </summary>
+		/// <param>const unsigned int& the number of maximum versions</param>
+		/// <param>const float& the probability for generating levels, default is 0.5</param>
+		MVCCSkipList(const unsigned int&, const float& = 0.50);
+
+		MVCCSkipList(const MVCCSkipList&) = delete;
+		MVCCSkipList& operator=(const MVCCSkipList&) = delete;
+
+		/// <summary>
+		/// Frees all versions, no read or snapshot may be active
+		/// </summary>
+		~MVCCSkipList();
+
+		/// <summary>
+		/// Adds a version with a value for a key
+		/// </summary>
+		void insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Adds a version marking a key as removed
+		/// </summary>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Takes a snapshot of the current contents
+		/// </summary>
+		Snapshot snapshot();
+
+		/// <summary>
+		/// Getter for the newest value of a key
+		/// </summary>
+		/// <param>const Key& the key</param>
+		/// <param>Value& receives the value if the key is present</param>
+		/// <return>bool whether the key is present</return>
+		bool get(const Key&, Value&) const;
+
+		/// <summary>
+		/// Getter for the value of a key in a snapshot
+		/// </summary>
+		/// <param>const Key& the key</param>
+		/// <param>Value& receives the value if the key was present when the snapshot was taken</param>
+		/// <param>const Snapshot& the snapshot</param>
+		/// <return>bool whether the key was present</return>
+		bool get(const Key&, Value&, const Snapshot&) const;
+
+		/// <summary>
+		/// Calls a function for all pairs present in a snapshot in ascending order of the keys
+		/// </summary>
+		/// <param>const Snapshot& the snapshot</param>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEach(const Snapshot&, Function) const;
+
+		/// <summary>
+		/// Removes the versions no snapshot can read: the versions older than the newest version of their key
+		/// not newer than the oldest snapshot, and removed keys with no other version left
+		/// A version is freed when the reads running during the gc have ended, at the latest by a later gc
+		/// </summary>
+		/// <return>size_t the number of freed versions</return>
+		size_t gc();
+
+		/// <summary>
+		/// Getter for the number of linked versions
+		/// </summary>
+		size_t versionsCount();
+};
+
+#endif
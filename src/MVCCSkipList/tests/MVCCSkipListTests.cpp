@@ -0,0 +1,206 @@
+#include "src/Doctest/doctest.h"
+#include "src/MVCCSkipList/MVCCSkipList.cpp"
+#include <map>
+#include <vector>
+#include <deque>
+#include <random>
+#include <thread>
+#include <atomic>
+
+std::map<int, int> contentsOf(const MVCCSkipList<int, int>& list, const MVCCSkipList<int, int>::Snapshot& snapshot) {
+	std::map<int, int> contents;
+	list.forEach(snapshot, [&contents](const int& key, const int& value) {
+		contents[key] = value;
+	});
+
+	return contents;
+}
+
+TEST_CASE("MVCCSkipList Snapshots read the versions of their time") {
+	MVCCSkipList<int, int> list{ 1000 };
+	for (int key = 0; key < 100; key++) {
+		list.insert(key, key);
+	}
+
+	auto before = list.snapshot();
+	for (int key = 0; key < 100; key += 2) {
+		list.insert(key, -key);
+	}
+	list.remove(1);
+	list.insert(500, 500);
+
+	auto after = list.snapshot();
+	CHECK(after.sequence() > before.sequence());
+
+	int value;
+	for (int key = 0; key < 100; key++) {
+		REQUIRE(list.get(key, value, before));
+		CHECK(value == key);
+	}
+	CHECK_FALSE(list.get(500, value, before));
+
+	CHECK_FALSE(list.get(1, value, after));
+	CHECK_FALSE(list.get(1, value));
+	REQUIRE(list.get(2, value, after));
+	CHECK(value == -2);
+	REQUIRE(list.get(500, value));
+	CHECK(value == 500);
+
+	std::map<int, int> expected;
+	for (int key = 0; key < 100; key++) {
+		expected[key] = key;
+	}
+	CHECK(contentsOf(list, before) == expected);
+
+	for (int key = 0; key < 100; key += 2) {
+		expected[key] = -key;
+	}
+	expected.erase(1);
+	expected[500] = 500;
+	CHECK(contentsOf(list, after) == expected);
+}
+
+TEST_CASE("MVCCSkipList Garbage collection keeps the versions of active snapshots") {
+	MVCCSkipList<int, int> list{ 1000 };
+	for (int round = 0; round < 5; round++) {
+		for (int key = 0; key < 50; key++) {
+			list.insert(key, round);
+		}
+	}
+	CHECK(list.versionsCount() == 250);
+
+	{
+		auto snapshot = list.snapshot();
+		for (int key = 0; key < 50; key++) {
+			list.insert(key, 5);
+		}
+		list.remove(7);
+
+		//the versions of round 4 are read by the snapshot
+		CHECK(list.gc() == 200);
+		CHECK(list.versionsCount() == 101);
+
+		int value;
+		REQUIRE(list.get(7, value, snapshot));
+		CHECK(value == 4);
+		CHECK_FALSE(list.get(7, value));
+		REQUIRE(list.get(8, value));
+		CHECK(value == 5);
+		CHECK(contentsOf(list, snapshot).size() == 50);
+	}
+
+	//the removal of key 7 goes one collection after its older version
+	CHECK(list.gc() == 51);
+	CHECK(list.versionsCount() == 50);
+	CHECK(list.gc() == 1);
+	CHECK(list.versionsCount() == 49);
+	CHECK(list.gc() == 0);
+
+	auto snapshot = list.snapshot();
+	std::map<int, int> contents = contentsOf(list, snapshot);
+	CHECK(contents.size() == 49);
+	CHECK(contents.count(7) == 0);
+	CHECK(contents[49] == 5);
+}
+
+TEST_CASE("MVCCSkipList Random updates against a history of maps") {
+	MVCCSkipList<int, int> list{ 1 << 14 };
+	std::mt19937 generator{ 31 };
+	std::map<int, int> current;
+	std::deque<std::map<int, int>> history;
+	std::deque<MVCCSkipList<int, int>::Snapshot> snapshots;
+
+	for (int i = 0; i < 20000; i++) {
+		int key = generator() % 1000;
+		if (generator() % 4) {
+			list.insert(key, i);
+			current[key] = i;
+		} else {
+			list.remove(key);
+			current.erase(key);
+		}
+
+		if (i % 2000 == 0) {
+			snapshots.push_back(list.snapshot());
+			history.push_back(current);
+		}
+		if (i % 3000 == 0) {
+			list.gc();
+		}
+		if (i % 5000 == 0 && !snapshots.empty()) {
+			snapshots.pop_front();
+			history.pop_front();
+		}
+	}
+	list.gc();
+
+	for (size_t i = 0; i < snapshots.size(); i++) {
+		CHECK(contentsOf(list, snapshots[i]) == history[i]);
+		for (int key = 0; key < 1000; key++) {
+			int value;
+			bool found = list.get(key, value, snapshots[i]);
+			auto it = history[i].find(key);
+			REQUIRE(found == (it != history[i].end()));
+			if (found) {
+				CHECK(value == it->second);
+			}
+		}
+	}
+}
+
+TEST_CASE("MVCCSkipList Scans stay consistent during updates and collections") {
+	MVCCSkipList<int, int> list{ 1 << 12 };
+	const int keysCount = 200;
+	for (int key = 0; key < keysCount; key++) {
+		list.insert(key, 0);
+	}
+
+	//every round writes all keys in ascending order, so a consistent view holds a prefix of the keys at some round and the rest at the round before
+	std::atomic<bool> stopping{ false };
+	std::atomic<int> scans{ 0 };
+	std::thread writer([&]() {
+		for (int round = 1; round <= 300 || scans < 20; round++) {
+			for (int key = 0; key < keysCount; key++) {
+				list.insert(key, round);
+			}
+			list.gc();
+		}
+		stopping = true;
+	});
+
+	std::vector<std::thread> readers;
+	std::atomic<int> inconsistent{ 0 };
+	for (int r = 0; r < 2; r++) {
+		readers.emplace_back([&]() {
+			while (!stopping) {
+				auto snapshot = list.snapshot();
+				std::vector<int> values;
+				list.forEach(snapshot, [&values](const int&, const int& value) {
+					values.push_back(value);
+				});
+
+				bool consistent = values.size() == keysCount && values.front() - values.back() <= 1;
+				for (size_t i = 1; consistent && i < values.size(); i++) {
+					consistent = values[i] <= values[i - 1];
+				}
+
+				int value;
+				if (!consistent || !list.get(keysCount / 2, value, snapshot) || value != values[keysCount / 2]) {
+					inconsistent++;
+				}
+				scans++;
+			}
+		});
+	}
+
+	writer.join();
+	for (std::thread& reader : readers) {
+		reader.join();
+	}
+
+	CHECK(inconsistent == 0);
+	CHECK(scans > 0);
+	list.gc();
+	list.gc();
+	CHECK(list.versionsCount() == keysCount);
+}
@@ -0,0 +1,161 @@
+#ifndef CHASELEVDEQUE_H
+#define CHASELEVDEQUE_H
+
+#include<atomic>
+#include<vector>
+#include<cstdint>
+
+/// <summary>
+/// A template class representing the work-stealing deque of Chase and Lev, in the formulation for the C11 memory
+/// model of Le, Pop, Cohen and Zappa Nardelli: the owner thread pushes and pops at the bottom, any other thread steals
+/// from the top, and only the last element and steals need a compare-and-swap
+/// The ring of elements doubles when full, the replaced rings are kept until the deque is destroyed,
+/// as a thief may still be reading one
+/// Item must be trivially copyable, e.g. a pointer, and an empty pop or steal returns Item()
+/// </summary>
+template<typename Item>
+class ChaseLevDeque
+{
+	private:
+		struct Ring {
+			std::int64_t capacity;
+			std::atomic<Item>* items;
+
+			Ring(const std::int64_t& _capacity) :
+				capacity(_capacity),
+				items(new std::atomic<Item>[_capacity]) {}
+
+			~Ring() {
+				delete[] this->items;
+			}
+
+			Item get(const std::int64_t& index) const {
+				return this->items[index & (this->capacity - 1)].load(std::memory_order_relaxed);
+			}
+
+			void put(const std::int64_t& index, const Item& item) {
+				this->items[index & (this->capacity - 1)].store(item, std::memory_order_relaxed);
+			}
+		};
+
+		alignas(64) std::atomic<std::int64_t> top;
+		alignas(64) std::atomic<std::int64_t> bottom;
+		std::atomic<Ring*> ring;
+		std::vector<Ring*> retired;
+
+		/// <summary>
+		/// Copies the elements from top to bottom into a ring of twice the capacity
+		/// </summary>
+		Ring* grow(Ring* old, const std::int64_t& first, const std::int64_t& last) {
+			Ring* larger = new Ring(old->capacity * 2);
+			for (std::int64_t i = first; i < last; i++) {
+				larger->put(i, old->get(i));
+			}
+			this->retired.push_back(old);
+
+			return larger;
+		}
+
+	public:
+		/// <summary>
+		/// Creates an empty deque
+		/// </summary>
+		/// <param>const std::int64_t& the initial capacity, rounded up to a power of 2, default is 256</param>
+		ChaseLevDeque(const std::int64_t& capacity = 256) :
+			top(0),
+			bottom(0)
+		{
+			std::int64_t size = 1;
+			while (size < capacity) {
+				size *= 2;
+			}
+
+			this->ring.store(new Ring(size), std::memory_order_relaxed);
+		}
+
+		ChaseLevDeque(const ChaseLevDeque&) = delete;
+		ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+		~ChaseLevDeque() {
+			delete this->ring.load(std::memory_order_relaxed);
+			for (Ring* old : this->retired) {
+				delete old;
+			}
+		}
+
+		/// <summary>
+		/// Adds an element at the bottom, called by the owner only
+		/// </summary>
+		void push(const Item& item) {
+			std::int64_t b = this->bottom.load(std::memory_order_relaxed);
+			std::int64_t t = this->top.load(std::memory_order_acquire);
+			Ring* current = this->ring.load(std::memory_order_relaxed);
+
+			if (b - t > current->capacity - 1) {
+				current = this->grow(current, t, b);
+				this->ring.store(current, std::memory_order_release);
+			}
+
+			current->put(b, item);
+			//publishes the element, and what it points to, to the thieves
+			this->bottom.store(b + 1, std::memory_order_release);
+		}
+
+		/// <summary>
+		/// Takes the element at the bottom, called by the owner only
+		/// </summary>
+		/// <return>Item the newest element or Item() if the deque is empty</return>
+		Item pop() {
+			std::int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+			Ring* current = this->ring.load(std::memory_order_relaxed);
+			this->bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t t = this->top.load(std::memory_order_relaxed);
+
+			if (t > b) {
+				this->bottom.store(b + 1, std::memory_order_relaxed);
+				return Item();
+			}
+
+			Item item = current->get(b);
+			if (t == b) {
+				//the last element, raced with the thieves
+				if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+					item = Item();
+				}
+				this->bottom.store(b + 1, std::memory_order_relaxed);
+			}
+
+			return item;
+		}
+
+		/// <summary>
+		/// Takes the element at the top, called by any thread
+		/// </summary>
+		/// <return>Item the oldest element or Item() if the deque is empty or another thread took the element first</return>
+		Item steal() {
+			std::int64_t t = this->top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			std::int64_t b = this->bottom.load(std::memory_order_acquire);
+
+			if (t >= b) {
+				return Item();
+			}
+
+			Item item = this->ring.load(std::memory_order_acquire)->get(t);
+			if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				return Item();
+			}
+
+			return item;
+		}
+
+		/// <summary>
+		/// Checks whether the deque looks empty, the answer may be outdated when it returns
+		/// </summary>
+		bool empty() const {
+			return this->top.load(std::memory_order_relaxed) >= this->bottom.load(std::memory_order_relaxed);
+		}
+};
+
+#endif
@@ -0,0 +1,276 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include<vector>
+#include<algorithm>
+#include<memory>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+#include<random>
+#include<cstddef>
+#include "ChaseLevDeque.h"
+
+/// <summary>
+/// A fork-join pool of a fixed number of threads, every thread owning a ChaseLevDeque of tasks
+/// parallelInvoke pushes its second function as a task, runs the first one and then runs the second one itself
+/// unless an idle thread stole it, in which case it steals other tasks until the stolen one is done
+/// A call from outside the pool takes the place of one pool thread for its duration, so threadsCount threads run in
+/// total, and calls from inside a task nest without starting threads or blocking one, so nesting never oversubscribes
+/// Calls from outside the pool are run one at a time
+/// </summary>
+class WorkStealingPool
+{
+	private:
+		/// <summary>
+		/// A forked function living on the stack of the thread waiting for it
+		/// </summary>
+		struct Task {
+			void (*execute)(Task*);
+			std::atomic<bool> done;
+
+			Task(void (*_execute)(Task*)) :
+				execute(_execute),
+				done(false) {}
+		};
+
+		template<typename Function>
+		struct FunctionTask : Task {
+			Function& function;
+
+			FunctionTask(Function& _function) :
+				Task(&FunctionTask::run),
+				function(_function) {}
+
+			static void run(Task* task) {
+				static_cast<FunctionTask*>(task)->function();
+			}
+		};
+
+		struct Worker {
+			ChaseLevDeque<Task*> deque;
+			std::minstd_rand random;
+		};
+
+		//the worker the current thread runs as, if it runs in a pool
+		inline static thread_local WorkStealingPool* currentPool = nullptr;
+		inline static thread_local size_t currentIndex = 0;
+
+		//worker 0 is taken by the thread calling from outside
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::vector<std::thread> threads;
+		std::mutex outsideMutex;
+
+		std::mutex sleepMutex;
+		std::condition_variable wake;
+		std::atomic<bool> active;
+		bool stopping;
+
+		static void runTask(Task* task) {
+			task->execute(task);
+			task->done.store(true, std::memory_order_release);
+		}
+
+		/// <summary>
+		/// Steals a task from a random other worker
+		/// </summary>
+		/// <return>Task* the task or nullptr if no task was found</return>
+		Task* stealFor(const size_t& thief) {
+			Worker& self = *this->workers[thief];
+			size_t count = this->workers.size();
+			size_t start = self.random() % count;
+			for (size_t i = 0; i < count; i++) {
+				size_t victim = (start + i) % count;
+				if (victim == thief) {
+					continue;
+				}
+
+				Task* task = this->workers[victim]->deque.steal();
+				if (task) {
+					return task;
+				}
+			}
+
+			return nullptr;
+		}
+
+		/// <summary>
+		/// The loop of a pool thread: steals tasks while a call runs and sleeps otherwise
+		/// </summary>
+		void work(const size_t& index) {
+			currentPool = this;
+			currentIndex = index;
+
+			while (true) {
+				Task* task = this->stealFor(index);
+				if (task) {
+					runTask(task);
+					continue;
+				}
+
+				if (this->active.load(std::memory_order_acquire)) {
+					std::this_thread::yield();
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(this->sleepMutex);
+				this->wake.wait(lock, [this]() { return this->stopping || this->active.load(); });
+				if (this->stopping) {
+					return;
+				}
+			}
+		}
+
+		/// <summary>
+		/// Runs a function as a worker of the pool, taking worker 0 if the current thread is not one
+		/// </summary>
+		template<typename Function>
+		void runInPool(Function& function) {
+			if (currentPool == this) {
+				function();
+				return;
+			}
+
+			std::lock_guard<std::mutex> outsideLock(this->outsideMutex);
+			WorkStealingPool* previousPool = currentPool;
+			size_t previousIndex = currentIndex;
+			currentPool = this;
+			currentIndex = 0;
+			{
+				std::lock_guard<std::mutex> lock(this->sleepMutex);
+				this->active.store(true);
+			}
+			this->wake.notify_all();
+
+			function();
+
+			this->active.store(false);
+			currentPool = previousPool;
+			currentIndex = previousIndex;
+		}
+
+		template<typename First, typename Second>
+		void invokeAsWorker(First& first, Second& second) {
+			Worker& self = *this->workers[currentIndex];
+			FunctionTask<Second> task(second);
+			self.deque.push(&task);
+
+			first();
+
+			//the tasks pushed by first were all taken back, so the bottom task is the forked one unless it was stolen
+			if (self.deque.pop() == &task) {
+				second();
+				return;
+			}
+
+			size_t index = currentIndex;
+			while (!task.done.load(std::memory_order_acquire)) {
+				Task* other = this->stealFor(index);
+				if (other) {
+					runTask(other);
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		template<typename Function>
+		void forAsWorker(const size_t& first, const size_t& last, Function& function, const size_t& grain) {
+			if (last - first <= grain) {
+				for (size_t i = first; i < last; i++) {
+					function(i);
+				}
+				return;
+			}
+
+			size_t middle = first + (last - first) / 2;
+			auto left = [&]() { this->forAsWorker(first, middle, function, grain); };
+			auto right = [&]() { this->forAsWorker(middle, last, function, grain); };
+			this->invokeAsWorker(left, right);
+		}
+
+	public:
+		/// <summary>
+		/// Creates a pool and starts its threads
+		/// </summary>
+		/// <param>const unsigned int& the number of threads running tasks, including the calling thread, default is the number of hardware threads</param>
+		WorkStealingPool(const unsigned int& threadsCount = std::thread::hardware_concurrency()) :
+			active(false),
+			stopping(false)
+		{
+			size_t count = threadsCount > 0 ? threadsCount : 1;
+			for (size_t i = 0; i < count; i++) {
+				this->workers.emplace_back(new Worker());
+				this->workers.back()->random.seed((unsigned int)i + 1);
+			}
+
+			for (size_t i = 1; i < count; i++) {
+				this->threads.emplace_back(&WorkStealingPool::work, this, i);
+			}
+		}
+
+		WorkStealingPool(const WorkStealingPool&) = delete;
+		WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+		/// <summary>
+		/// Stops the threads, no call may be running
+		/// </summary>
+		~WorkStealingPool() {
+			{
+				std::lock_guard<std::mutex> lock(this->sleepMutex);
+				this->stopping = true;
+			}
+			this->wake.notify_all();
+
+			for (std::thread& thread : this->threads) {
+				thread.join();
+			}
+		}
+
+		/// <summary>
+		/// Runs two functions, possibly in parallel, and returns when both are done
+		/// </summary>
+		/// <param>First the first function, run by the calling thread</param>
+		/// <param>Second the second function, run by the calling thread or by an idle pool thread</param>
+		template<typename First, typename Second>
+		void parallelInvoke(First first, Second second) {
+			auto invoke = [&]() { this->invokeAsWorker(first, second); };
+			this->runInPool(invoke);
+		}
+
+		/// <summary>
+		/// Calls a function for every index of a range, splitting the range in halves until the parts are at most a grain
+		/// </summary>
+		/// <param>const size_t& the first index</param>
+		/// <param>const size_t& the index after the last one</param>
+		/// <param>Function the function called with (size_t)</param>
+		/// <param>const size_t& the largest part run without splitting, 0 splits into about 8 parts per thread</param>
+		template<typename Function>
+		void parallelFor(const size_t& first, const size_t& last, Function function, const size_t& grain = 0) {
+			if (last <= first) {
+				return;
+			}
+
+			size_t part = grain > 0 ? grain : std::max<size_t>(1, (last - first) / (8 * this->workers.size()));
+			auto run = [&]() { this->forAsWorker(first, last, function, part); };
+			this->runInPool(run);
+		}
+
+		/// <summary>
+		/// Getter for the number of threads running tasks, including the calling thread
+		/// </summary>
+		unsigned int threadsCount() const {
+			return (unsigned int)this->workers.size();
+		}
+
+		/// <summary>
+		/// Getter for the worker the calling thread runs as, used to pick a per-thread accumulator inside a parallel call
+		/// </summary>
+		/// <return>size_t the index below threadsCount() of the pool running the caller, 0 outside of a pool</return>
+		static size_t workerIndex() {
+			return currentIndex;
+		}
+};
+
+#endif
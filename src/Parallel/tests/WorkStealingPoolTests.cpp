@@ -0,0 +1,133 @@
+#include "src/Doctest/doctest.h"
+#include "src/Parallel/WorkStealingPool.h"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <set>
+
+TEST_CASE("ChaseLevDeque Owner and thieves take every element once") {
+	ChaseLevDeque<int*> deque{ 4 };
+	const int count = 100000;
+	std::vector<int> values(count);
+	std::vector<std::atomic<int>> taken(count);
+	for (std::atomic<int>& t : taken) {
+		t = 0;
+	}
+
+	std::atomic<bool> pushing{ true };
+	std::vector<std::thread> thieves;
+	for (int t = 0; t < 3; t++) {
+		thieves.emplace_back([&]() {
+			while (pushing || !deque.empty()) {
+				int* value = deque.steal();
+				if (value) {
+					taken[value - values.data()]++;
+				}
+			}
+		});
+	}
+
+	//the ring starts with 4 elements, so the owner grows it while the thieves steal
+	for (int i = 0; i < count; i++) {
+		deque.push(&values[i]);
+		if (i % 3 == 0) {
+			int* value = deque.pop();
+			if (value) {
+				taken[value - values.data()]++;
+			}
+		}
+	}
+	while (int* value = deque.pop()) {
+		taken[value - values.data()]++;
+	}
+	pushing = false;
+	for (std::thread& thief : thieves) {
+		thief.join();
+	}
+
+	int wrong = 0;
+	for (std::atomic<int>& t : taken) {
+		wrong += t != 1;
+	}
+	CHECK(wrong == 0);
+	CHECK(deque.pop() == nullptr);
+	CHECK(deque.steal() == nullptr);
+}
+
+long long fibonacci(WorkStealingPool& pool, const int& n) {
+	if (n < 12) {
+		return n < 2 ? n : fibonacci(pool, n - 1) + fibonacci(pool, n - 2);
+	}
+
+	long long left, right;
+	pool.parallelInvoke([&]() { left = fibonacci(pool, n - 1); }, [&]() { right = fibonacci(pool, n - 2); });
+	return left + right;
+}
+
+TEST_CASE("WorkStealingPool Nested parallelInvoke") {
+	WorkStealingPool pool{ 4 };
+	CHECK(pool.threadsCount() == 4);
+	CHECK(fibonacci(pool, 25) == 75025);
+
+	WorkStealingPool single{ 1 };
+	CHECK(fibonacci(single, 20) == 6765);
+}
+
+TEST_CASE("WorkStealingPool parallelFor visits every index once on at most threadsCount threads") {
+	WorkStealingPool pool{ 3 };
+	const size_t count = 200000;
+	std::vector<std::atomic<int>> visits(count);
+	for (std::atomic<int>& v : visits) {
+		v = 0;
+	}
+
+	std::mutex idsMutex;
+	std::set<std::thread::id> ids;
+	pool.parallelFor(0, count, [&](const size_t& i) {
+		visits[i]++;
+		if (i % 1000 == 0) {
+			std::lock_guard<std::mutex> lock(idsMutex);
+			ids.insert(std::this_thread::get_id());
+		}
+	});
+
+	int wrong = 0;
+	for (std::atomic<int>& v : visits) {
+		wrong += v != 1;
+	}
+	CHECK(wrong == 0);
+	CHECK(ids.size() <= 3);
+
+	//a parallelFor inside a parallelFor runs on the same threads
+	std::atomic<long long> sum{ 0 };
+	pool.parallelFor(0, 100, [&](const size_t& i) {
+		pool.parallelFor(0, 1000, [&](const size_t& j) {
+			sum += (long long)(i * 1000 + j);
+			std::lock_guard<std::mutex> lock(idsMutex);
+			ids.insert(std::this_thread::get_id());
+		}, 16);
+	}, 1);
+	CHECK(sum == 99999LL * 100000 / 2);
+	CHECK(ids.size() <= 3);
+
+	pool.parallelFor(5, 5, [&](const size_t&) { sum = -1; });
+	CHECK(sum != -1);
+}
+
+TEST_CASE("WorkStealingPool Calls from several outside threads") {
+	WorkStealingPool pool{ 2 };
+	std::atomic<long long> total{ 0 };
+	std::vector<std::thread> callers;
+	for (int t = 0; t < 3; t++) {
+		callers.emplace_back([&]() {
+			for (int round = 0; round < 20; round++) {
+				total += fibonacci(pool, 18);
+			}
+		});
+	}
+	for (std::thread& caller : callers) {
+		caller.join();
+	}
+
+	CHECK(total == 60LL * 2584);
+}
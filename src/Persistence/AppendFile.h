@@ -0,0 +1,195 @@
+#ifndef APPENDFILE_H
+#define APPENDFILE_H
+
+#include<string>
+#include<cstddef>
+#include<cstdint>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+/// <summary>
+/// A file written only at its end, whose writes are made durable by an explicit sync
+/// </summary>
+class AppendFile
+{
+	private:
+#ifdef _WIN32
+		HANDLE handle;
+#else
+		int descriptor;
+#endif
+		std::uint64_t length;
+
+	public:
+		AppendFile() :
+#ifdef _WIN32
+			handle(INVALID_HANDLE_VALUE),
+#else
+			descriptor(-1),
+#endif
+			length(0) {}
+
+		AppendFile(const AppendFile&) = delete;
+		AppendFile& operator=(const AppendFile&) = delete;
+
+		~AppendFile() {
+			this->close();
+		}
+
+		/// <summary>
+		/// Opens a file for appending, creating it if it does not exist, closing the previous file
+		/// </summary>
+		/// <param>const std::string& the path of the file</param>
+		/// <return>bool whether the file was opened</return>
+		bool open(const std::string& path) {
+			this->close();
+
+#ifdef _WIN32
+			this->handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+			LARGE_INTEGER size;
+			if (this->handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(this->handle, &size)) {
+				this->close();
+				return false;
+			}
+			this->length = (std::uint64_t)size.QuadPart;
+#else
+			this->descriptor = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+			struct stat status;
+			if (this->descriptor < 0 || fstat(this->descriptor, &status) != 0) {
+				this->close();
+				return false;
+			}
+			this->length = (std::uint64_t)status.st_size;
+#endif
+
+			return true;
+		}
+
+		void close() {
+#ifdef _WIN32
+			if (this->handle != INVALID_HANDLE_VALUE) {
+				CloseHandle(this->handle);
+				this->handle = INVALID_HANDLE_VALUE;
+			}
+#else
+			if (this->descriptor >= 0) {
+				::close(this->descriptor);
+				this->descriptor = -1;
+			}
+#endif
+			this->length = 0;
+		}
+
+		bool isOpen() const {
+#ifdef _WIN32
+			return this->handle != INVALID_HANDLE_VALUE;
+#else
+			return this->descriptor >= 0;
+#endif
+		}
+
+		/// <summary>
+		/// Getter for the size of the file including the appended bytes
+		/// </summary>
+		std::uint64_t size() const {
+			return this->length;
+		}
+
+		/// <summary>
+		/// Writes bytes at the end of the file, they may stay in the page cache until sync
+		/// </summary>
+		/// <return>bool whether all bytes were written</return>
+		bool append(const void* data, size_t count) {
+			const char* bytes = (const char*)data;
+			while (count) {
+#ifdef _WIN32
+				LARGE_INTEGER offset;
+				offset.QuadPart = (LONGLONG)this->length;
+				DWORD written;
+				DWORD chunk = count > (1u << 30) ? (1u << 30) : (DWORD)count;
+				if (!SetFilePointerEx(this->handle, offset, nullptr, FILE_BEGIN) || !WriteFile(this->handle, bytes, chunk, &written, nullptr)) {
+					return false;
+				}
+#else
+				ssize_t written = pwrite(this->descriptor, bytes, count, (off_t)this->length);
+				if (written < 0) {
+					return false;
+				}
+#endif
+				bytes += written;
+				count -= (size_t)written;
+				this->length += (std::uint64_t)written;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		/// Waits until the written bytes are on the disk, the metadata is synced only as far as reading the data needs it
+		/// </summary>
+		/// <return>bool whether the sync succeeded</return>
+		bool sync() {
+#ifdef _WIN32
+			return FlushFileBuffers(this->handle) != 0;
+#elif defined(__APPLE__)
+			return fsync(this->descriptor) == 0;
+#else
+			return fdatasync(this->descriptor) == 0;
+#endif
+		}
+
+		/// <summary>
+		/// Waits until the entries of a directory are on the disk, so that files created in it survive a crash
+		/// Does nothing on Windows, where the entries are synced with the files
+		/// </summary>
+		/// <param>const std::string& the path of the directory</param>
+		/// <return>bool whether the sync succeeded</return>
+		static bool syncDirectory(const std::string& path) {
+#ifdef _WIN32
+			(void)path;
+			return true;
+#else
+			int directory = ::open(path.c_str(), O_RDONLY);
+			if (directory < 0) {
+				return false;
+			}
+
+			bool synced = fsync(directory) == 0;
+			::close(directory);
+
+			return synced;
+#endif
+		}
+
+		/// <summary>
+		/// Shortens the file, the next append continues at the new end
+		/// </summary>
+		/// <return>bool whether the file was truncated</return>
+		bool truncate(const std::uint64_t& size) {
+#ifdef _WIN32
+			LARGE_INTEGER offset;
+			offset.QuadPart = (LONGLONG)size;
+			if (!SetFilePointerEx(this->handle, offset, nullptr, FILE_BEGIN) || !SetEndOfFile(this->handle)) {
+				return false;
+			}
+#else
+			if (ftruncate(this->descriptor, (off_t)size) != 0) {
+				return false;
+			}
+#endif
+			this->length = size;
+
+			return true;
+		}
+};
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include<string>
+#include<cstddef>
+#include<utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+/// <summary>
+/// A read-only memory mapping of a whole file, the pages are read from the file when first touched
+/// </summary>
+class MappedFile
+{
+	private:
+		const void* address;
+		size_t length;
+#ifdef _WIN32
+		HANDLE mapping;
+#endif
+
+	public:
+		MappedFile() :
+			address(nullptr),
+			length(0)
+#ifdef _WIN32
+			, mapping(nullptr)
+#endif
+		{}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept :
+			MappedFile()
+		{
+			*this = std::move(other);
+		}
+
+		MappedFile& operator=(MappedFile&& other) noexcept {
+			if (this != &other) {
+				this->close();
+				this->address = other.address;
+				this->length = other.length;
+				other.address = nullptr;
+				other.length = 0;
+#ifdef _WIN32
+				this->mapping = other.mapping;
+				other.mapping = nullptr;
+#endif
+			}
+
+			return *this;
+		}
+
+		~MappedFile() {
+			this->close();
+		}
+
+		/// <summary>
+		/// Maps a file, closing the previous mapping
+		/// </summary>
+		/// <param>const std::string& the path of the file</param>
+		/// <return>bool whether the file exists, is not empty and was mapped</return>
+		bool open(const std::string& path) {
+			this->close();
+
+#ifdef _WIN32
+			HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				return false;
+			}
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+				CloseHandle(file);
+				return false;
+			}
+
+			//the mapping keeps the file open
+			this->mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+			if (!this->mapping) {
+				return false;
+			}
+
+			this->address = MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0);
+			if (!this->address) {
+				CloseHandle(this->mapping);
+				this->mapping = nullptr;
+				return false;
+			}
+			this->length = (size_t)size.QuadPart;
+#else
+			int descriptor = ::open(path.c_str(), O_RDONLY);
+			if (descriptor < 0) {
+				return false;
+			}
+
+			struct stat status;
+			if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+				::close(descriptor);
+				return false;
+			}
+
+			//the mapping keeps the file open
+			void* mapped = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+			::close(descriptor);
+			if (mapped == MAP_FAILED) {
+				return false;
+			}
+
+			this->address = mapped;
+			this->length = (size_t)status.st_size;
+#endif
+
+			return true;
+		}
+
+		void close() {
+			if (!this->address) {
+				return;
+			}
+
+#ifdef _WIN32
+			UnmapViewOfFile(this->address);
+			CloseHandle(this->mapping);
+			this->mapping = nullptr;
+#else
+			munmap(const_cast<void*>(this->address), this->length);
+#endif
+			this->address = nullptr;
+			this->length = 0;
+		}
+
+		const void* data() const {
+			return this->address;
+		}
+
+		size_t size() const {
+			return this->length;
+		}
+};
+
+#endif
@@ -0,0 +1,247 @@
+#include "ShardedMap.h"
+#include "../AVL/AVL.cpp"
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+template<typename Key, typename Value, typename Structure>
+ShardedMap<Key, Value, Structure>::Shard::Shard() :
+	count(0),
+	lower(),
+	upper() {}
+
+template<typename Key, typename Value, typename Structure>
+ShardedMap<Key, Value, Structure>::ShardedMap(const std::vector<Key>& _splitKeys, const float& _skewFactor, const size_t& _minimumMove) :
+	splitKeys(_splitKeys),
+	skewFactor(_skewFactor),
+	minimumMove(_minimumMove > 0 ? _minimumMove : 1),
+	size(0),
+	rebalancing(false)
+{
+	for (size_t i = 0; i <= this->splitKeys.size(); i++) {
+		this->shards.emplace_back(new Shard());
+		if (i > 0) {
+			this->shards[i]->lower = this->splitKeys[i - 1];
+		}
+		if (i < this->splitKeys.size()) {
+			this->shards[i]->upper = this->splitKeys[i];
+		}
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+size_t ShardedMap<Key, Value, Structure>::route(const Key& key) const {
+	std::shared_lock<std::shared_mutex> lock(this->splitKeysLock);
+	return std::upper_bound(this->splitKeys.begin(), this->splitKeys.end(), key) - this->splitKeys.begin();
+}
+
+template<typename Key, typename Value, typename Structure>
+bool ShardedMap<Key, Value, Structure>::inRange(const size_t& index, const Key& key) const {
+	const Shard& shard = *this->shards[index];
+	return (index == 0 || !(key < shard.lower)) && (index + 1 == this->shards.size() || key < shard.upper);
+}
+
+template<typename Key, typename Value, typename Structure>
+template<bool exclusive, typename Operation>
+auto ShardedMap<Key, Value, Structure>::withShard(const Key& key, Operation operation) const {
+	while (true) {
+		size_t index = this->route(key);
+		Shard& shard = *this->shards[index];
+
+		if constexpr (exclusive) {
+			std::unique_lock<std::shared_mutex> lock(shard.lock);
+			if (this->inRange(index, key)) {
+				return operation(shard, index);
+			}
+		} else {
+			std::shared_lock<std::shared_mutex> lock(shard.lock);
+			if (this->inRange(index, key)) {
+				return operation(shard, index);
+			}
+		}
+		//a rebalance moved the key to a neighbour between the routing and the lock
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+size_t ShardedMap<Key, Value, Structure>::moveBetween(const size_t& left, const bool& toRight) {
+	Shard& leftShard = *this->shards[left];
+	Shard& rightShard = *this->shards[left + 1];
+	//shards are always locked in ascending order
+	std::unique_lock<std::shared_mutex> leftLock(leftShard.lock);
+	std::unique_lock<std::shared_mutex> rightLock(rightShard.lock);
+
+	Shard& donor = toRight ? leftShard : rightShard;
+	Shard& receiver = toRight ? rightShard : leftShard;
+	size_t donorCount = donor.count.load();
+	size_t receiverCount = receiver.count.load();
+	if (donorCount <= receiverCount + 1) {
+		return 0;
+	}
+
+	//the largest pairs move right, the smallest move left
+	size_t moving = (donorCount - receiverCount) / 2;
+	size_t first = toRight ? donorCount - moving : 0;
+	size_t position = 0;
+	std::vector<std::pair<Key, Value>> moved;
+	moved.reserve(moving);
+	Key split{};
+	donor.structure.forEach([&](const Key& key, const Value& value) {
+		if (position >= first && position < first + moving) {
+			moved.emplace_back(key, value);
+		} else if (!toRight && position == moving) {
+			split = key;
+		}
+		position++;
+	});
+	if (toRight) {
+		split = moved.front().first;
+	}
+
+	for (const std::pair<Key, Value>& pair : moved) {
+		receiver.structure.insert(pair.first, pair.second);
+		donor.structure.remove(pair.first);
+	}
+	donor.count -= moving;
+	receiver.count += moving;
+
+	leftShard.upper = split;
+	rightShard.lower = split;
+	std::unique_lock<std::shared_mutex> splitKeysWriteLock(this->splitKeysLock);
+	this->splitKeys[left] = split;
+
+	return moving;
+}
+
+template<typename Key, typename Value, typename Structure>
+void ShardedMap<Key, Value, Structure>::rebalanceShard(const size_t& index) {
+	//one rebalance at a time, the other writers go on instead of queueing behind it
+	if (this->rebalancing.exchange(true)) {
+		return;
+	}
+
+	size_t count = this->shards[index]->count.load();
+	double average = (double)this->size.load() / this->shards.size();
+	if (count > this->skewFactor * average) {
+		size_t leftCount = index > 0 ? this->shards[index - 1]->count.load() : (size_t)-1;
+		size_t rightCount = index + 1 < this->shards.size() ? this->shards[index + 1]->count.load() : (size_t)-1;
+		bool toRight = rightCount < leftCount;
+		size_t neighbourCount = toRight ? rightCount : leftCount;
+		if (neighbourCount < count && (count - neighbourCount) / 2 >= this->minimumMove) {
+			this->moveBetween(toRight ? index : index - 1, toRight);
+		}
+	}
+
+	this->rebalancing = false;
+}
+
+template<typename Key, typename Value, typename Structure>
+void ShardedMap<Key, Value, Structure>::insert(const Key& key, const Value& value) {
+	size_t index;
+	bool added = this->template withShard<true>(key, [&](Shard& shard, const size_t& shardIndex) {
+		index = shardIndex;
+		bool existed = shard.structure.contains(key);
+		shard.structure.insert(key, value);
+		if (!existed) {
+			shard.count++;
+		}
+		return !existed;
+	});
+
+	if (!added) {
+		return;
+	}
+	size_t total = ++this->size;
+
+	size_t count = this->shards[index]->count.load();
+	if (this->shards.size() > 1 && count >= 2 * this->minimumMove && count > this->skewFactor * total / this->shards.size()) {
+		this->rebalanceShard(index);
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+void ShardedMap<Key, Value, Structure>::remove(const Key& key) {
+	bool removed = this->template withShard<true>(key, [&key](Shard& shard, const size_t&) {
+		if (!shard.structure.contains(key)) {
+			return false;
+		}
+
+		shard.structure.remove(key);
+		shard.count--;
+		return true;
+	});
+
+	if (removed) {
+		this->size--;
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+bool ShardedMap<Key, Value, Structure>::getValue(const Key& key, Value& value) const {
+	return this->template withShard<false>(key, [&key, &value](Shard& shard, const size_t&) {
+		const Value* found = shard.structure.getValue(key);
+		if (!found) {
+			return false;
+		}
+
+		value = *found;
+		return true;
+	});
+}
+
+template<typename Key, typename Value, typename Structure>
+bool ShardedMap<Key, Value, Structure>::contains(const Key& key) const {
+	return this->template withShard<false>(key, [&key](Shard& shard, const size_t&) {
+		return shard.structure.contains(key);
+	});
+}
+
+template<typename Key, typename Value, typename Structure>
+template<typename Function>
+void ShardedMap<Key, Value, Structure>::forEach(Function function) const {
+	std::vector<std::shared_lock<std::shared_mutex>> locks;
+	locks.reserve(this->shards.size());
+	for (const std::unique_ptr<Shard>& shard : this->shards) {
+		locks.emplace_back(shard->lock);
+	}
+
+	//the ranges are disjoint and ascending, so the ordered scans of the shards concatenate into an ordered scan
+	for (const std::unique_ptr<Shard>& shard : this->shards) {
+		shard->structure.forEach(std::ref(function));
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+void ShardedMap<Key, Value, Structure>::rebalance() {
+	//every move makes the sizes of a pair closer, so the passes end
+	bool moved = true;
+	while (moved) {
+		moved = false;
+		double limit = this->skewFactor * this->size.load() / this->shards.size();
+		for (size_t i = 0; i + 1 < this->shards.size(); i++) {
+			size_t leftCount = this->shards[i]->count.load();
+			size_t rightCount = this->shards[i + 1]->count.load();
+			size_t larger = std::max(leftCount, rightCount);
+			size_t smaller = std::min(leftCount, rightCount);
+			if (larger > limit && (larger - smaller) / 2 >= this->minimumMove) {
+				moved |= this->moveBetween(i, leftCount > rightCount) > 0;
+			}
+		}
+	}
+}
+
+template<typename Key, typename Value, typename Structure>
+size_t ShardedMap<Key, Value, Structure>::pairsCount() const {
+	return this->size.load();
+}
+
+template<typename Key, typename Value, typename Structure>
+std::vector<size_t> ShardedMap<Key, Value, Structure>::shardSizes() const {
+	std::vector<size_t> sizes;
+	for (const std::unique_ptr<Shard>& shard : this->shards) {
+		sizes.push_back(shard->count.load());
+	}
+
+	return sizes;
+}
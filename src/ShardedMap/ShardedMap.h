@@ -0,0 +1,135 @@
+#ifndef SHARDEDMAP_H
+#define SHARDEDMAP_H
+
+#include<vector>
+#include<memory>
+#include<atomic>
+#include<shared_mutex>
+#include<cstddef>
+#include "../AVL/AVL.h"
+
+/// <summary>
+/// A template class representing an ordered map partitioned by key ranges across shards, every shard a Structure
+/// guarded by its own reader-writer lock, so updates of different ranges run in parallel
+/// Shard i holds the keys from the (i-1)-th to the i-th split key; when an insert leaves a shard larger than skewFactor
+/// times the average, the inserting thread moves half of the difference to the smaller neighbouring shard and moves the
+/// split key between them, while the other shards stay available
+/// Structure must be default constructible and provide insert, remove, contains, getValue and forEach like AVL
+/// </summary>
+template<typename Key, typename Value, typename Structure = AVL<Key, Value>>
+class ShardedMap
+{
+	private:
+		struct Shard {
+			mutable std::shared_mutex lock;
+			Structure structure;
+			std::atomic<size_t> count;
+			//the range of the shard, changed while holding the lock exclusively
+			Key lower;
+			Key upper;
+
+			Shard();
+		};
+
+		std::vector<std::unique_ptr<Shard>> shards;
+		/// <summary>
+		/// The split keys routing the operations, a thread holding a shard lock checks the range of the shard
+		/// and routes again if a rebalance moved the key away
+		/// </summary>
+		std::vector<Key> splitKeys;
+		mutable std::shared_mutex splitKeysLock;
+
+		float skewFactor;
+		size_t minimumMove;
+		std::atomic<size_t> size;
+		std::atomic<bool> rebalancing;
+
+		/// <summary>
+		/// Getter for the index of the shard a key is routed to
+		/// </summary>
+		size_t route(const Key&) const;
+
+		/// <summary>
+		/// Checks whether a key is inside the range of a shard, the shard lock must be held
+		/// </summary>
+		bool inRange(const size_t&, const Key&) const;
+
+		/// <summary>
+		/// Moves pairs from a shard to its neighbour and moves the split key between them
+		/// </summary>
+		/// <param>const size_t& the index of the left shard of the pair</param>
+		/// <param>const bool& whether the pairs move from the left shard to the right one</param>
+		/// <return>size_t the number of moved pairs</return>
+		size_t moveBetween(const size_t&, const bool&);
+
+		/// <summary>
+		/// Balances a shard with its smaller neighbour if the shard is larger than skewFactor times the average
+		/// </summary>
+		void rebalanceShard(const size_t&);
+
+		/// <summary>
+		/// Runs an operation on the shard of a key under its lock, taken shared or exclusively
+		/// </summary>
+		template<bool exclusive, typename Operation>
+		auto withShard(const Key&, Operation) const;
+
+	public:
+		/// <summary>
+		/// Creates a map with a shard for every range between consecutive split keys
+		/// </summary>
+		/// <param>const std::vector<Key>& the split keys in ascending order, n keys make n + 1 shards</param>
+		/// <param>const float& how many times larger than the average a shard grows before it is rebalanced, default is 2</param>
+		/// <param>const size_t& the smallest number of pairs a rebalance moves, default is 1024</param>
+		ShardedMap(const std::vector<Key>&, const float& = 2.0f, const size_t& = 1024);
+
+		ShardedMap(const ShardedMap&) = delete;
+		ShardedMap& operator=(const ShardedMap&) = delete;
+
+		/// <summary>
+		/// Inserts a key-value pair or updates the value of an existing key
+		/// </summary>
+		void insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Removes a key
+		/// </summary>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Getter for the value of a key
+		/// </summary>
+		/// <param>const Key& the key</param>
+		/// <param>Value& receives the value if the key is in the map</param>
+		/// <return>bool whether the key is in the map</return>
+		bool getValue(const Key&, Value&) const;
+
+		/// <summary>
+		/// Checks whether a key is inside the map
+		/// </summary>
+		bool contains(const Key&) const;
+
+		/// <summary>
+		/// Calls a function for all key-value pairs in ascending order of the keys
+		/// The shards are locked shared in ascending order for the whole scan, so the scan sees one state of the map
+		/// </summary>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEach(Function) const;
+
+		/// <summary>
+		/// Balances all neighbouring shards until no shard is larger than skewFactor times the average
+		/// </summary>
+		void rebalance();
+
+		/// <summary>
+		/// Getter for the number of pairs in the map
+		/// </summary>
+		size_t pairsCount() const;
+
+		/// <summary>
+		/// Getter for the number of pairs in every shard
+		/// </summary>
+		std::vector<size_t> shardSizes() const;
+};
+
+#endif
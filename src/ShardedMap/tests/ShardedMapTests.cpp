@@ -0,0 +1,130 @@
+#include "src/Doctest/doctest.h"
+#include "src/ShardedMap/ShardedMap.cpp"
+#include "src/CompactAVL/CompactAVL.cpp"
+#include <map>
+#include <vector>
+#include <random>
+#include <thread>
+#include <atomic>
+
+template<typename Map>
+std::vector<std::pair<int, int>> pairsOf(const Map& map) {
+	std::vector<std::pair<int, int>> pairs;
+	map.forEach([&pairs](const int& key, const int& value) {
+		pairs.emplace_back(key, value);
+	});
+
+	return pairs;
+}
+
+TEST_CASE("ShardedMap Operations across shards") {
+	ShardedMap<int, int> map{ { 1000, 2000, 3000, 4000 } };
+	std::map<int, int> expected;
+	std::mt19937 generator{ 5 };
+	for (int i = 0; i < 20000; i++) {
+		int key = generator() % 6000 - 500;
+		if (i % 3) {
+			map.insert(key, i);
+			expected[key] = i;
+		} else {
+			map.remove(key);
+			expected.erase(key);
+		}
+	}
+
+	CHECK(map.pairsCount() == expected.size());
+	for (int key = -500; key < 5500; key++) {
+		int value;
+		bool found = map.getValue(key, value);
+		auto it = expected.find(key);
+		REQUIRE(found == (it != expected.end()));
+		CHECK(map.contains(key) == found);
+		if (found) {
+			CHECK(value == it->second);
+		}
+	}
+
+	std::vector<std::pair<int, int>> pairs = pairsOf(map);
+	CHECK(pairs == std::vector<std::pair<int, int>>(expected.begin(), expected.end()));
+
+	std::vector<size_t> sizes = map.shardSizes();
+	REQUIRE(sizes.size() == 5);
+	size_t total = 0;
+	for (const size_t& size : sizes) {
+		total += size;
+	}
+	CHECK(total == expected.size());
+}
+
+TEST_CASE("ShardedMap Skewed inserts move the split keys") {
+	ShardedMap<int, int, CompactAVL<int, int>> map{ { 1000000, 2000000, 3000000 }, 1.5f, 64 };
+	//all keys fall in the range of the first shard
+	for (int key = 0; key < 40000; key++) {
+		map.insert(key * 7 % 40000, key);
+	}
+
+	std::vector<size_t> sizes = map.shardSizes();
+	CHECK(sizes[0] < 40000);
+	CHECK(sizes[1] > 0);
+
+	map.rebalance();
+	sizes = map.shardSizes();
+	for (const size_t& size : sizes) {
+		CHECK(size <= 1.5 * 40000 / 4);
+	}
+
+	std::vector<std::pair<int, int>> pairs = pairsOf(map);
+	REQUIRE(pairs.size() == 40000);
+	for (int key = 0; key < 40000; key++) {
+		CHECK(pairs[key].first == key);
+		int value;
+		REQUIRE(map.getValue(key, value));
+		CHECK(value * 7 % 40000 == key);
+	}
+}
+
+TEST_CASE("ShardedMap Concurrent writers and scans") {
+	ShardedMap<int, int> map{ { 250000, 500000, 750000 }, 1.5f, 256 };
+	const int threadsCount = 4;
+	const int keysPerThread = 20000;
+
+	std::atomic<bool> stopping{ false };
+	std::atomic<int> unordered{ 0 };
+	std::thread scanner([&]() {
+		while (!stopping) {
+			std::vector<std::pair<int, int>> pairs = pairsOf(map);
+			for (size_t i = 1; i < pairs.size(); i++) {
+				if (!(pairs[i - 1].first < pairs[i].first)) {
+					unordered++;
+				}
+			}
+		}
+	});
+
+	//the keys of all writers start in the first shard, so the writers rebalance while the others insert
+	std::vector<std::thread> writers;
+	for (int t = 0; t < threadsCount; t++) {
+		writers.emplace_back([&map, t]() {
+			for (int i = 0; i < keysPerThread; i++) {
+				int key = i * threadsCount + t;
+				map.insert(key, key);
+				if (i % 5 == 0) {
+					map.remove(key);
+				}
+			}
+		});
+	}
+	for (std::thread& writer : writers) {
+		writer.join();
+	}
+	stopping = true;
+	scanner.join();
+
+	CHECK(unordered == 0);
+	CHECK(map.pairsCount() == threadsCount * keysPerThread * 4 / 5);
+	std::vector<size_t> sizes = map.shardSizes();
+	CHECK(sizes[0] < threadsCount * keysPerThread);
+	for (int key = 0; key < threadsCount * keysPerThread; key++) {
+		REQUIRE(map.contains(key) == (key / threadsCount % 5 != 0));
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef BLOOMBLOCK_H
+#define BLOOMBLOCK_H
+
+#include "LowerBound.h"
+
+/// <summary>
+/// Kernels setting and testing the bits of a key in a 512-bit Bloom filter block
+/// The block is 16 lanes of 32 bits, the key sets one bit in every lane - the bit is chosen by the top 5 bits
+/// of the key hash multiplied by the salt of the lane, so all 16 bits are computed and tested at once
+/// </summary>
+namespace SimdKernels
+{
+	typedef bool (*BloomProbe)(const std::uint32_t*, const std::uint32_t&, const std::uint32_t*);
+	typedef void (*BloomInsert)(std::uint32_t*, const std::uint32_t&, const std::uint32_t*);
+
+#ifdef SIMD_LOWER_BOUND_X86
+	__attribute__((target("avx2"))) inline __m256i avx2BloomMask(const std::uint32_t& hash, const std::uint32_t* salts) {
+		__m256i bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)hash), _mm256_loadu_si256((const __m256i*)salts)), 27);
+		return _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+	}
+
+	__attribute__((target("avx2"))) inline bool avx2BloomProbe(const std::uint32_t* block, const std::uint32_t& hash, const std::uint32_t* salts) {
+		return _mm256_testc_si256(_mm256_load_si256((const __m256i*)block), avx2BloomMask(hash, salts))
+			&& _mm256_testc_si256(_mm256_load_si256((const __m256i*)(block + 8)), avx2BloomMask(hash, salts + 8));
+	}
+
+	__attribute__((target("avx2"))) inline void avx2BloomInsert(std::uint32_t* block, const std::uint32_t& hash, const std::uint32_t* salts) {
+		__m256i* low = (__m256i*)block;
+		__m256i* high = (__m256i*)(block + 8);
+		_mm256_store_si256(low, _mm256_or_si256(_mm256_load_si256(low), avx2BloomMask(hash, salts)));
+		_mm256_store_si256(high, _mm256_or_si256(_mm256_load_si256(high), avx2BloomMask(hash, salts + 8)));
+	}
+#endif
+
+	/// <summary>
+	/// Selects the AVX2 kernels if the running CPU supports them or nullptr otherwise
+	/// </summary>
+	inline BloomProbe selectBloomProbe() {
+#ifdef SIMD_LOWER_BOUND_X86
+		return hasAvx2() ? avx2BloomProbe : nullptr;
+#else
+		return nullptr;
+#endif
+	}
+
+	inline BloomInsert selectBloomInsert() {
+#ifdef SIMD_LOWER_BOUND_X86
+		return hasAvx2() ? avx2BloomInsert : nullptr;
+#else
+		return nullptr;
+#endif
+	}
+}
+
+#endif
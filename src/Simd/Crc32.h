@@ -0,0 +1,84 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include "LowerBound.h"
+
+/// <summary>
+/// CRC-32C (the Castagnoli polynomial) of a byte range, computed with the SSE4.2 crc32 instruction when the running CPU has it
+/// and with a lookup table otherwise, both give the same checksums
+/// </summary>
+namespace SimdKernels
+{
+	typedef std::uint32_t (*Crc32Kernel)(std::uint32_t, const unsigned char*, size_t);
+
+	inline std::uint32_t tableCrc32c(std::uint32_t crc, const unsigned char* bytes, size_t length) {
+		struct Table {
+			std::uint32_t entries[256];
+
+			Table() {
+				for (std::uint32_t i = 0; i < 256; i++) {
+					std::uint32_t entry = i;
+					for (int bit = 0; bit < 8; bit++) {
+						entry = (entry >> 1) ^ (entry & 1 ? 0x82f63b78u : 0);
+					}
+					this->entries[i] = entry;
+				}
+			}
+		};
+		static const Table table;
+
+		for (size_t i = 0; i < length; i++) {
+			crc = (crc >> 8) ^ table.entries[(crc ^ bytes[i]) & 0xff];
+		}
+
+		return crc;
+	}
+
+#ifdef SIMD_LOWER_BOUND_X86
+	__attribute__((target("sse4.2"))) inline std::uint32_t sseCrc32c(std::uint32_t crc, const unsigned char* bytes, size_t length) {
+		size_t i = 0;
+#ifdef __x86_64__
+		std::uint64_t wide = crc;
+		for (; i + 8 <= length; i += 8) {
+			std::uint64_t word;
+			std::memcpy(&word, bytes + i, 8);
+			wide = _mm_crc32_u64(wide, word);
+		}
+		crc = (std::uint32_t)wide;
+#endif
+		for (; i < length; i++) {
+			crc = _mm_crc32_u8(crc, bytes[i]);
+		}
+
+		return crc;
+	}
+#endif
+
+	/// <summary>
+	/// Selects the SSE4.2 kernel if the running CPU supports it or the table kernel otherwise
+	/// </summary>
+	inline Crc32Kernel selectCrc32c() {
+#ifdef SIMD_LOWER_BOUND_X86
+		return hasSse42() ? sseCrc32c : tableCrc32c;
+#else
+		return tableCrc32c;
+#endif
+	}
+
+	/// <summary>
+	/// Computes the CRC-32C of a byte range
+	/// </summary>
+	/// <param>const void* the first byte</param>
+	/// <param>size_t the number of bytes</param>
+	/// <return>std::uint32_t the checksum</return>
+	inline std::uint32_t crc32c(const void* data, size_t length) {
+		static const Crc32Kernel kernel = selectCrc32c();
+
+		return ~kernel(0xffffffffu, (const unsigned char*)data, length);
+	}
+}
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef LOWERBOUND_H
+#define LOWERBOUND_H
+
+#include<algorithm>
+#include<cstdint>
+#include<type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_LOWER_BOUND_X86
+#include<immintrin.h>
+#endif
+
+/// <summary>
+/// Kernels comparing a whole vector of keys against the searched key at once
+/// Each kernel consumes only full vectors and returns the position at which it stopped -
+/// either a key not less than the searched one was met or fewer keys than a vector remain,
+/// the caller finishes the search with scalar comparisons
+/// </summary>
+namespace SimdKernels
+{
+	typedef unsigned int (*Kernel32)(const void*, const unsigned int&, const std::uint32_t&);
+	typedef unsigned int (*Kernel64)(const void*, const unsigned int&, const std::uint64_t&);
+
+#ifdef SIMD_LOWER_BOUND_X86
+	//Unsigned keys are compared as signed after flipping their sign bits
+	//the mask of a sorted vector has its set bits contiguous from the lowest one, so their count is the position
+
+	template<bool isSigned>
+	__attribute__((target("avx2"))) unsigned int avx2Integer32(const void* keys, const unsigned int& count, const std::uint32_t& key) {
+		const __m256i bias = _mm256_set1_epi32(isSigned ? 0 : (int)0x80000000u);
+		const __m256i needle = _mm256_xor_si256(_mm256_set1_epi32((int)key), bias);
+		unsigned int i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256i values = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)((const std::uint32_t*)keys + i)), bias);
+			unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, values)));
+			if (mask != 0xff) {
+				return i + __builtin_popcount(mask);
+			}
+		}
+
+		return i;
+	}
+
+	template<bool isSigned>
+	__attribute__((target("avx2"))) unsigned int avx2Integer64(const void* keys, const unsigned int& count, const std::uint64_t& key) {
+		const __m256i bias = _mm256_set1_epi64x(isSigned ? 0 : (long long)0x8000000000000000ull);
+		const __m256i needle = _mm256_xor_si256(_mm256_set1_epi64x((long long)key), bias);
+		unsigned int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m256i values = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)((const std::uint64_t*)keys + i)), bias);
+			unsigned int mask = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(needle, values)));
+			if (mask != 0xf) {
+				return i + __builtin_popcount(mask);
+			}
+		}
+
+		return i;
+	}
+
+	__attribute__((target("avx2"))) inline unsigned int avx2Float(const void* keys, const unsigned int& count, const std::uint32_t& key) {
+		float value;
+		__builtin_memcpy(&value, &key, sizeof(float));
+		const __m256 needle = _mm256_set1_ps(value);
+		unsigned int i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 values = _mm256_loadu_ps((const float*)keys + i);
+			unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(values, needle, _CMP_LT_OQ));
+			if (mask != 0xff) {
+				return i + __builtin_popcount(mask);
+			}
+		}
+
+		return i;
+	}
+
+	template<bool isSigned>
+	__attribute__((target("sse4.2"))) unsigned int sseInteger32(const void* keys, const unsigned int& count, const std::uint32_t& key) {
+		const __m128i bias = _mm_set1_epi32(isSigned ? 0 : (int)0x80000000u);
+		const __m128i needle = _mm_xor_si128(_mm_set1_epi32((int)key), bias);
+		unsigned int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i values = _mm_xor_si128(_mm_loadu_si128((const __m128i*)((const std::uint32_t*)keys + i)), bias);
+			unsigned int mask = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(needle, values)));
+			if (mask != 0xf) {
+				return i + __builtin_popcount(mask);
+			}
+		}
+
+		return i;
+	}
+
+	template<bool isSigned>
+	__attribute__((target("sse4.2"))) unsigned int sseInteger64(const void* keys, const unsigned int& count, const std::uint64_t& key) {
+		const __m128i bias = _mm_set1_epi64x(isSigned ? 0 : (long long)0x8000000000000000ull);
+		const __m128i needle = _mm_xor_si128(_mm_set1_epi64x((long long)key), bias);
+		unsigned int i = 0;
+		for (; i + 2 <= count; i += 2) {
+			__m128i values = _mm_xor_si128(_mm_loadu_si128((const __m128i*)((const std::uint64_t*)keys + i)), bias);
+			unsigned int mask = (unsigned int)_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(needle, values)));
+			if (mask != 0x3) {
+				return i + __builtin_popcount(mask);
+			}
+		}
+
+		return i;
+	}
+
+	__attribute__((target("sse4.2"))) inline unsigned int sseFloat(const void* keys, const unsigned int& count, const std::uint32_t& key) {
+		float value;
+		__builtin_memcpy(&value, &key, sizeof(float));
+		const __m128 needle = _mm_set1_ps(value);
+		unsigned int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 values = _mm_loadu_ps((const float*)keys + i);
+			unsigned int mask = (unsigned int)_mm_movemask_ps(_mm_cmplt_ps(values, needle));
+			if (mask != 0xf) {
+				return i + __builtin_popcount(mask);
+			}
+		}
+
+		return i;
+	}
+
+	inline bool hasAvx2() {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+	}
+
+	inline bool hasSse42() {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("sse4.2");
+	}
+#endif
+
+	/// <summary>
+	/// Selects the widest kernel the running CPU supports for a key type or nullptr if it supports none
+	/// </summary>
+	template<typename Key>
+	Kernel32 select32() {
+#ifdef SIMD_LOWER_BOUND_X86
+		if (std::is_floating_point<Key>::value) {
+			return hasAvx2() ? avx2Float : hasSse42() ? sseFloat : nullptr;
+		}
+		if (std::is_signed<Key>::value) {
+			return hasAvx2() ? avx2Integer32<true> : hasSse42() ? sseInteger32<true> : nullptr;
+		}
+		return hasAvx2() ? avx2Integer32<false> : hasSse42() ? sseInteger32<false> : nullptr;
+#else
+		return nullptr;
+#endif
+	}
+
+	template<typename Key>
+	Kernel64 select64() {
+#ifdef SIMD_LOWER_BOUND_X86
+		if (std::is_signed<Key>::value) {
+			return hasAvx2() ? avx2Integer64<true> : hasSse42() ? sseInteger64<true> : nullptr;
+		}
+		return hasAvx2() ? avx2Integer64<false> : hasSse42() ? sseInteger64<false> : nullptr;
+#else
+		return nullptr;
+#endif
+	}
+}
+
+/// <summary>
+/// Finds the position of the first key which is not less than a searched key in a small sorted array, e.g. the keys of a node
+/// The general version is a binary search (also used as the scalar fallback through LowerBound<Key, bool>), 32 and 64-bit integer keys and float keys are compared a vector at a time
+/// with the AVX2 or SSE4.2 kernel chosen on first use for the running CPU and a scalar fallback otherwise
+/// </summary>
+template<typename Key, typename Enable = void>
+struct LowerBound {
+	static unsigned int find(const Key* keys, const unsigned int& count, const Key& key) {
+		return (unsigned int)(std::lower_bound(keys, keys + count, key) - keys);
+	}
+};
+
+template<typename Key>
+struct LowerBound<Key, typename std::enable_if<(std::is_integral<Key>::value && !std::is_same<Key, bool>::value && sizeof(Key) == 4) || std::is_same<Key, float>::value>::type> {
+	static unsigned int find(const Key* keys, const unsigned int& count, const Key& key) {
+		static const SimdKernels::Kernel32 kernel = SimdKernels::select32<Key>();
+		if (!kernel) {
+			return LowerBound<Key, bool>::find(keys, count, key);
+		}
+
+		std::uint32_t bits;
+		std::copy((const char*)&key, (const char*)&key + sizeof(Key), (char*)&bits);
+
+		unsigned int i = kernel(keys, count, bits);
+		while (i < count && keys[i] < key) {
+			i++;
+		}
+
+		return i;
+	}
+};
+
+template<typename Key>
+struct LowerBound<Key, typename std::enable_if<std::is_integral<Key>::value && sizeof(Key) == 8>::type> {
+	static unsigned int find(const Key* keys, const unsigned int& count, const Key& key) {
+		static const SimdKernels::Kernel64 kernel = SimdKernels::select64<Key>();
+		if (!kernel) {
+			return LowerBound<Key, bool>::find(keys, count, key);
+		}
+
+		unsigned int i = kernel(keys, count, (std::uint64_t)key);
+		while (i < count && keys[i] < key) {
+			i++;
+		}
+
+		return i;
+	}
+};
+
+#endif
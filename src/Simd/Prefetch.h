@@ -0,0 +1,17 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+/// <summary>
+/// Hints the CPU to load the cache line of an address for reading, so that a later access does not stall
+/// Expands to nothing on compilers without a prefetch intrinsic
+/// </summary>
+#if defined(__GNUC__)
+#define SIMD_PREFETCH(address) __builtin_prefetch((const void*)(address), 0, 3)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include<xmmintrin.h>
+#define SIMD_PREFETCH(address) _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#else
+#define SIMD_PREFETCH(address) ((void)(address))
+#endif
+
+#endif
@@ -0,0 +1,34 @@
+#include "src/Doctest/doctest.h"
+#include "src/Simd/Crc32.h"
+#include <string>
+#include <vector>
+
+TEST_CASE("Crc32c check value") {
+	CHECK(SimdKernels::crc32c("123456789", 9) == 0xe3069283u);
+	CHECK(SimdKernels::crc32c("", 0) == 0);
+}
+
+TEST_CASE("Crc32c kernels agree") {
+	std::vector<unsigned char> bytes;
+	for (int i = 0; i < 1000; i++) {
+		bytes.push_back((unsigned char)(i * 37 + i / 7));
+	}
+
+	bool same = true;
+	SimdKernels::Crc32Kernel selected = SimdKernels::selectCrc32c();
+	for (size_t length = 0; length <= bytes.size() && same; length += 13) {
+		for (size_t offset = 0; offset < 8 && same; offset++) {
+			size_t count = std::min(length, bytes.size() - offset);
+			same = selected(0xffffffffu, bytes.data() + offset, count) == SimdKernels::tableCrc32c(0xffffffffu, bytes.data() + offset, count);
+		}
+	}
+	CHECK(same);
+}
+
+TEST_CASE("Crc32c detects a flipped bit") {
+	std::string data = "write-ahead log record";
+	std::uint32_t checksum = SimdKernels::crc32c(data.data(), data.size());
+	data[5] ^= 0x10;
+
+	CHECK(SimdKernels::crc32c(data.data(), data.size()) != checksum);
+}
@@ -0,0 +1,74 @@
+#include "src/Doctest/doctest.h"
+#include "src/Simd/LowerBound.h"
+#include <vector>
+#include <limits>
+
+template<typename Key>
+bool matchesBinarySearch(const std::vector<Key>& keys, const std::vector<Key>& searched) {
+	for (unsigned int count = 0; count <= keys.size(); count++) {
+		for (const Key& key : searched) {
+			unsigned int expected = (unsigned int)(std::lower_bound(keys.begin(), keys.begin() + count, key) - keys.begin());
+			if (LowerBound<Key>::find(keys.data(), count, key) != expected) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+template<typename Key>
+void checkKeyType() {
+	std::vector<Key> keys;
+	std::vector<Key> searched{ std::numeric_limits<Key>::lowest(), std::numeric_limits<Key>::max() };
+	for (int i = 0; i < 37; i++) {
+		keys.push_back((Key)(i * 3));
+		searched.push_back((Key)(i * 3));
+		searched.push_back((Key)(i * 3 + 1));
+	}
+
+	CHECK(matchesBinarySearch(keys, searched));
+}
+
+TEST_CASE("LowerBound int32_t") {
+	checkKeyType<std::int32_t>();
+
+	std::vector<std::int32_t> negative{ -100, -50, -1, 0, 1, 50, 100, 200, 300 };
+	CHECK(matchesBinarySearch(negative, { -101, -100, -2, 0, 2, 301 }));
+}
+
+TEST_CASE("LowerBound int64_t") {
+	checkKeyType<std::int64_t>();
+
+	std::vector<std::int64_t> negative{ -100, -50, -1, 0, 1, 50, 100, 200, 300 };
+	CHECK(matchesBinarySearch(negative, { -101, -100, -2, 0, 2, 301 }));
+}
+
+TEST_CASE("LowerBound uint32_t") {
+	checkKeyType<std::uint32_t>();
+
+	std::vector<std::uint32_t> large{ 1, 2, 0x7fffffffu, 0x80000000u, 0x80000001u, 0xfffffff0u, 0xffffffffu };
+	CHECK(matchesBinarySearch(large, { 0, 2, 0x7fffffffu, 0x80000000u, 0xfffffff1u, 0xffffffffu }));
+}
+
+TEST_CASE("LowerBound uint64_t") {
+	checkKeyType<std::uint64_t>();
+
+	std::vector<std::uint64_t> large{ 1, 2, 0x7fffffffffffffffull, 0x8000000000000000ull, 0xffffffffffffffffull };
+	CHECK(matchesBinarySearch(large, { 0, 2, 0x8000000000000000ull, 0xfffffffffffffff0ull, 0xffffffffffffffffull }));
+}
+
+TEST_CASE("LowerBound float") {
+	checkKeyType<float>();
+
+	std::vector<float> fractions{ -2.5f, -0.5f, 0.0f, 0.25f, 0.5f, 1.5f, 100.0f, 1e9f };
+	CHECK(matchesBinarySearch(fractions, { -3.0f, -0.5f, 0.1f, 1.5f, 2e9f }));
+}
+
+TEST_CASE("LowerBound other key types") {
+	std::vector<double> keys{ 1.0, 2.0, 3.0 };
+	CHECK(LowerBound<double>::find(keys.data(), 3, 2.5) == 2);
+
+	std::vector<short> shortKeys{ 1, 2, 3 };
+	CHECK(LowerBound<short>::find(shortKeys.data(), 3, 3) == 2);
+}
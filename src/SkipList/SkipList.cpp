@@ -1,12 +1,16 @@
 #include "SkipList.h"
+#include "../Parallel/WorkStealingPool.h"
 #include <math.h>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 template<typename Key, typename Value>
-std::default_random_engine SkipList<Key, Value>::generator;
+thread_local std::default_random_engine SkipList<Key, Value>::generator;
 
 template<typename Key, typename Value>
-std::uniform_real_distribution<double> SkipList<Key, Value>::distribution{ 0.0, 1.0 };
+thread_local std::uniform_real_distribution<double> SkipList<Key, Value>::distribution{ 0.0, 1.0 };
 
 template<typename Key, typename Value>
 SkipList<Key,Value>::SkipListNode::SkipListNode(const Key& _key, const Value& _value, const unsigned int& _level) : 
@@ -40,6 +44,7 @@ unsigned int SkipList<Key, Value>::generateLevel() const {
 		levels++;
 	}
 
+	SKIPLIST_STATS_RECORD(this->stats.levelHistogram[levels]++);
 	return levels;
 }
 
@@ -50,10 +55,13 @@ SkipList<Key, Value>::~SkipList() {
 
 template<typename Key, typename Value>
 SkipList<Key, Value>::SkipList(const unsigned int& maximumElements, const float& _probability) :
-	probability(_probability),
-    heighestLevel(0)
+	maxLevel(maximumElements > 0 ? std::log2(maximumElements) : 0),
+	heighestLevel(0),
+	probability(_probability)
+#ifdef SKIPLIST_STATS
+	, stats(maxLevel)
+#endif
 {
-    this->maxLevel = maximumElements > 0 ? std::log2(maximumElements) : 0;
     this->head = new SkipListNode{ this->maxLevel };
 }
 
@@ -85,37 +93,201 @@ void SkipList<Key, Value>::insert(const Key& key, const Value& value) {
     }
 }
 
+template<typename Key, typename Value>
+template<typename Iterator>
+void SkipList<Key, Value>::insertSorted(Iterator first, Iterator last) {
+    //update[i] is the last node before the previous key at level i, all of them start at the head
+    std::vector<SkipListNode*> update(this->maxLevel + 1, this->head);
+
+    for (; first != last; ++first) {
+        const Key& key = first->first;
+        SKIPLIST_STATS_RECORD(this->stats.searches++);
+
+        if (update[0] != this->head && !(update[0]->key < key)) {
+            if (update[0]->key == key) {//a repeated key in the input
+                update[0]->value = first->second;
+                continue;
+            }
+
+            //the key is before the finger, start over from the head
+            std::fill(update.begin(), update.end(), this->head);
+        }
+
+        //climb while the next node of the level above is still before the key, every level above a level
+        //which already ends before the key does the same, so the climb stops at the first such level
+        unsigned int level = 0;
+        while (level < this->heighestLevel && update[level + 1]->forward[level + 1] && update[level + 1]->forward[level + 1]->key < key) {
+            level++;
+            SKIPLIST_STATS_RECORD(this->stats.comparisons++);
+        }
+
+        SkipListNode* current = update[level];
+        for (unsigned int i = level; i >= 0 && i <= level; i--) {
+            while (current->forward[i] && current->forward[i]->key < key) {
+                current = current->forward[i];
+                SKIPLIST_STATS_RECORD(this->stats.nodesVisitedPerLevel[i]++; this->stats.comparisons++);
+            }
+            SKIPLIST_STATS_RECORD(this->stats.comparisons += current->forward[i] != nullptr);
+            update[i] = current;
+        }
+
+        SkipListNode* next = current->forward[0];
+        if (next && next->key == key) {
+            next->value = first->second;
+            continue;
+        }
+
+        unsigned int generatedLevel = this->generateLevel();
+        if (generatedLevel > this->heighestLevel) {//the levels above the heighest one still point to the head
+            this->heighestLevel = generatedLevel;
+        }
+
+        SkipListNode* n = new SkipListNode{ key, first->second, generatedLevel };
+        for (unsigned int i = 0; i <= generatedLevel; i++) {
+            n->forward[i] = update[i]->forward[i];
+            update[i]->forward[i] = n;
+            //the new node precedes every following key at its levels
+            update[i] = n;
+        }
+    }
+}
+
 template<typename Key, typename Value>
 typename SkipList<Key, Value>::SkipListNode* SkipList<Key, Value>::findInsertOrDeleteNode(std::vector<SkipListNode*>& update, const Key& key) {
     SkipListNode* current = this->head;
+    SKIPLIST_STATS_RECORD(this->stats.searches++);
 
     for (unsigned int i = this->heighestLevel; i >= 0 && i <= this->heighestLevel; i--)
     {
         //moving through the current level while there is an available node with node.key < key
         while (current->forward[i] && current->forward[i]->key < key) {
             current = current->forward[i];
+            SKIPLIST_STATS_RECORD(this->stats.nodesVisitedPerLevel[i]++; this->stats.comparisons++);
         }
+        SKIPLIST_STATS_RECORD(this->stats.comparisons += current->forward[i] != nullptr);
         //after the node for update at the current level is found, store it
         update[i] = current;
     }
 
+    SKIPLIST_STATS_RECORD(this->stats.comparisons += current->forward[0] != nullptr);
     return current->forward[0];
 }
 
 template<typename Key, typename Value>
 bool SkipList<Key, Value>::contains(const Key& key) const {
     SkipListNode* current = this->head;
+    SKIPLIST_STATS_RECORD(this->stats.searches++);
 
     for (unsigned int i = this->heighestLevel; i >= 0 && i <= this->heighestLevel; i--) {
         while (current->forward[i] && current->forward[i]->key < key) {
             current = current->forward[i];
+            SKIPLIST_STATS_RECORD(this->stats.nodesVisitedPerLevel[i]++; this->stats.comparisons++);
         }
+        SKIPLIST_STATS_RECORD(this->stats.comparisons += current->forward[i] != nullptr);
     }
 
     current = current->forward[0];
+    SKIPLIST_STATS_RECORD(this->stats.comparisons += current != nullptr);
     return current && current->key == key;
 }
 
+template<typename Key, typename Value>
+const Value* SkipList<Key, Value>::getValue(const Key& key) const {
+    SkipListNode* current = this->head;
+    SKIPLIST_STATS_RECORD(this->stats.searches++);
+
+    for (unsigned int i = this->heighestLevel; i >= 0 && i <= this->heighestLevel; i--) {
+        while (current->forward[i] && current->forward[i]->key < key) {
+            current = current->forward[i];
+            SKIPLIST_STATS_RECORD(this->stats.nodesVisitedPerLevel[i]++; this->stats.comparisons++);
+        }
+        SKIPLIST_STATS_RECORD(this->stats.comparisons += current->forward[i] != nullptr);
+    }
+
+    current = current->forward[0];
+    SKIPLIST_STATS_RECORD(this->stats.comparisons += current != nullptr);
+    if (!current || current->key != key) {
+        return nullptr;
+    }
+
+    return &current->value;
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void SkipList<Key, Value>::findBatch(const std::vector<Key>& keys, Function function) const {
+    //a search alternates between comparing the key of the next node and loading the forward pointer of the current node,
+    //the memory each step needs was prefetched by the previous step
+    struct Search {
+        const SkipListNode* current;
+        const SkipListNode* next;
+        unsigned int level;
+        bool loadNext;
+    };
+
+    SKIPLIST_STATS_RECORD(this->stats.searches += keys.size());
+
+    for (size_t start = 0; start < keys.size(); start += batchGroupSize) {
+        size_t groupSize = std::min<size_t>(batchGroupSize, keys.size() - start);
+        Search searches[batchGroupSize];
+        for (size_t i = 0; i < groupSize; i++) {
+            searches[i] = Search{ this->head, nullptr, this->heighestLevel, true };
+        }
+
+        size_t active = groupSize;
+        while (active) {
+            active = 0;
+            for (size_t i = 0; i < groupSize; i++) {
+                Search& search = searches[i];
+                if (!search.current) {
+                    continue;
+                }
+                active++;
+
+                if (search.loadNext) {
+                    search.next = search.current->forward[search.level];
+                    SIMD_PREFETCH(search.next);
+                    search.loadNext = false;
+                    continue;
+                }
+
+                const Key& key = keys[start + i];
+                SKIPLIST_STATS_RECORD(this->stats.comparisons += search.next != nullptr);
+                if (search.next && search.next->key < key) {
+                    search.current = search.next;
+                    SIMD_PREFETCH(search.current->forward.data() + search.level);
+                    search.loadNext = true;
+                    SKIPLIST_STATS_RECORD(this->stats.nodesVisitedPerLevel[search.level]++);
+                } else if (search.level == 0) {
+                    function(start + i, search.next && search.next->key == key ? search.next : nullptr);
+                    search.current = nullptr;
+                } else {
+                    //the forward pointers of the current node are already in the cache
+                    search.level--;
+                    search.next = search.current->forward[search.level];
+                    SIMD_PREFETCH(search.next);
+                }
+            }
+        }
+    }
+}
+
+template<typename Key, typename Value>
+void SkipList<Key, Value>::containsBatch(const std::vector<Key>& keys, std::vector<bool>& out) const {
+    out.resize(keys.size());
+    this->findBatch(keys, [&out](const size_t& index, const SkipListNode* node) {
+        out[index] = node != nullptr;
+    });
+}
+
+template<typename Key, typename Value>
+void SkipList<Key, Value>::getValueBatch(const std::vector<Key>& keys, std::vector<const Value*>& out) const {
+    out.resize(keys.size());
+    this->findBatch(keys, [&out](const size_t& index, const SkipListNode* node) {
+        out[index] = node ? &node->value : nullptr;
+    });
+}
+
 template<typename Key, typename Value>
 void SkipList<Key, Value>::remove(const Key& key) {
     std::vector<SkipListNode*> update{ this->maxLevel + 1 };
@@ -155,4 +327,213 @@ unsigned int SkipList<Key, Value>::numberOfElements() const {
     }
 
     return res;
-}
\ No newline at end of file
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void SkipList<Key, Value>::forEach(Function function) const {
+    for (SkipListNode* current = this->head->forward[0]; current; current = current->forward[0]) {
+        function(current->key, current->value);
+    }
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void SkipList<Key, Value>::parallelForEach(const Key& low, const Key& high, Function function, WorkStealingPool& pool) const {
+    if (high < low) {
+        return;
+    }
+
+    //descends towards low and collects the nodes of the range on every level until a level holds enough of them
+    size_t wanted = 8 * (size_t)pool.threadsCount();
+    std::vector<SkipListNode*> starts;
+    SkipListNode* current = this->head;
+    unsigned int level = this->heighestLevel;
+    while (true) {
+        while (current->forward[level] && current->forward[level]->key < low) {
+            current = current->forward[level];
+        }
+
+        starts.clear();
+        for (SkipListNode* node = current->forward[level]; node && !(high < node->key); node = node->forward[level]) {
+            starts.push_back(node);
+        }
+        if (starts.size() >= wanted || level == 0) {
+            break;
+        }
+        level--;
+    }
+
+    //the first chunk starts at the first key of the range, below the first node of the chosen level
+    for (unsigned int i = level - 1; i < level; i--) {
+        while (current->forward[i] && current->forward[i]->key < low) {
+            current = current->forward[i];
+        }
+    }
+    SkipListNode* first = current->forward[0];
+    if (!first || high < first->key) {
+        return;
+    }
+    if (starts.empty() || starts.front() != first) {
+        starts.insert(starts.begin(), first);
+    }
+
+    pool.parallelFor(0, starts.size(), [&](const size_t& chunk) {
+        SkipListNode* end = chunk + 1 < starts.size() ? starts[chunk + 1] : nullptr;
+        for (SkipListNode* node = starts[chunk]; node != end && !(high < node->key); node = node->forward[0]) {
+            function(node->key, node->value);
+        }
+    }, 1);
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void SkipList<Key, Value>::parallelForEach(const Key& low, const Key& high, Function function, const unsigned int& threads) const {
+    WorkStealingPool pool{ threads };
+    this->parallelForEach(low, high, function, pool);
+}
+
+//a snapshot is a header followed by blocks of packed records (key, value and an optional level byte), each block
+//starts with its number of records and an empty block ends the snapshot
+template<typename Key, typename Value>
+bool SkipList<Key, Value>::dump(std::ostream& out, const bool& withLevels) const {
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "dump needs trivially copyable keys and values");
+
+    std::uint32_t header[4] = { sizeof(Key), sizeof(Value), withLevels, 0 };
+    out.write("DSPSKIP1", 8);
+    out.write((const char*)header, sizeof(header));
+
+    const size_t recordSize = sizeof(Key) + sizeof(Value) + (withLevels ? 1 : 0);
+    const std::uint32_t blockRecords = (std::uint32_t)std::max<size_t>(1, (snapshotBufferSize - sizeof(std::uint32_t)) / recordSize);
+    std::vector<char> buffer(sizeof(std::uint32_t) + blockRecords * recordSize);
+
+    SkipListNode* current = this->head->forward[0];
+    while (out) {
+        std::uint32_t records = 0;
+        char* position = buffer.data() + sizeof(std::uint32_t);
+        for (; current && records < blockRecords; current = current->forward[0], records++) {
+            std::memcpy(position, &current->key, sizeof(Key));
+            std::memcpy(position + sizeof(Key), &current->value, sizeof(Value));
+            if (withLevels) {
+                position[sizeof(Key) + sizeof(Value)] = (char)(current->forward.size() - 1);
+            }
+            position += recordSize;
+        }
+
+        std::memcpy(buffer.data(), &records, sizeof(records));
+        out.write(buffer.data(), position - buffer.data());
+        if (!records) {
+            break;
+        }
+    }
+
+    return (bool)out;
+}
+
+template<typename Key, typename Value>
+bool SkipList<Key, Value>::restore(std::istream& in) {
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "restore needs trivially copyable keys and values");
+
+    this->deleteInternals();
+    this->head = new SkipListNode{ this->maxLevel };
+    this->heighestLevel = 0;
+
+    char magic[8];
+    std::uint32_t header[4];
+    in.read(magic, sizeof(magic));
+    in.read((char*)header, sizeof(header));
+    if (!in || std::memcmp(magic, "DSPSKIP1", 8) != 0 || header[0] != sizeof(Key) || header[1] != sizeof(Value) || header[2] > 1) {
+        return false;
+    }
+
+    const bool withLevels = header[2] == 1;
+    const size_t recordSize = sizeof(Key) + sizeof(Value) + (withLevels ? 1 : 0);
+    const size_t blockRecords = std::max<size_t>(1, (snapshotBufferSize - sizeof(std::uint32_t)) / recordSize);
+    std::vector<char> buffer;
+
+    //tail[i] is the last node of level i, every restored node is linked behind the tails of its levels
+    std::vector<SkipListNode*> tail(this->maxLevel + 1, this->head);
+    bool valid = true;
+    while (valid) {
+        std::uint32_t records;
+        in.read((char*)&records, sizeof(records));
+        if (!in || records > blockRecords) {
+            valid = false;
+            break;
+        }
+        if (!records) {
+            break;
+        }
+
+        buffer.resize(records * recordSize);
+        in.read(buffer.data(), buffer.size());
+        valid = (bool)in;
+
+        const char* position = buffer.data();
+        for (std::uint32_t i = 0; i < records && valid; i++, position += recordSize) {
+            Key key;
+            Value value;
+            std::memcpy(&key, position, sizeof(Key));
+            std::memcpy(&value, position + sizeof(Key), sizeof(Value));
+            if (tail[0] != this->head && !(tail[0]->key < key)) {//the keys must be strictly ascending
+                valid = false;
+                break;
+            }
+
+            unsigned int level;
+            if (withLevels) {
+                level = std::min<unsigned int>((unsigned char)position[sizeof(Key) + sizeof(Value)], this->maxLevel);
+                SKIPLIST_STATS_RECORD(this->stats.levelHistogram[level]++);
+            } else {
+                level = this->generateLevel();
+            }
+            this->heighestLevel = std::max(this->heighestLevel, level);
+
+            SkipListNode* n = new SkipListNode{ key, value, level };
+            for (unsigned int j = 0; j <= level; j++) {
+                tail[j]->forward[j] = n;
+                tail[j] = n;
+            }
+        }
+    }
+
+    if (!valid) {
+        this->deleteInternals();
+        this->head = new SkipListNode{ this->maxLevel };
+        this->heighestLevel = 0;
+    }
+
+    return valid;
+}
+
+#ifdef SKIPLIST_STATS
+template<typename Key, typename Value>
+SkipList<Key, Value>::Stats::Stats(const unsigned int& _maxLevel) :
+    searches(0),
+    comparisons(0),
+    nodesVisitedPerLevel(_maxLevel + 1),
+    levelHistogram(_maxLevel + 1),
+    heighestLevel(0) {}
+
+template<typename Key, typename Value>
+double SkipList<Key, Value>::Stats::averageComparisonsPerSearch() const {
+    if (!this->searches) {
+        return 0;
+    }
+
+    return (double)this->comparisons / this->searches;
+}
+
+template<typename Key, typename Value>
+typename SkipList<Key, Value>::Stats SkipList<Key, Value>::getStats() const {
+    Stats result = this->stats;
+    result.heighestLevel = this->heighestLevel;
+
+    return result;
+}
+
+template<typename Key, typename Value>
+void SkipList<Key, Value>::resetStats() {
+    this->stats = Stats{ this->maxLevel };
+}
+#endif
\ No newline at end of file
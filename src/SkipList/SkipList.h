@@ -3,7 +3,17 @@
 
 #include<vector>
 #include<random>
+#include<cstdint>
+#include<iosfwd>
+#include "../Simd/Prefetch.h"
 
+class WorkStealingPool;
+
+#ifdef SKIPLIST_STATS
+#define SKIPLIST_STATS_RECORD(statement) statement
+#else
+#define SKIPLIST_STATS_RECORD(statement)
+#endif
 
 /// <summary>
 /// A template class representing a Skip list data structure
@@ -23,8 +33,9 @@ class SkipList
 			SkipListNode(const unsigned int&);
 		};
 
-		static std::default_random_engine generator;
-		static std::uniform_real_distribution<double> distribution;
+		//one per thread, so lists owned by different threads never share the generator state
+		static thread_local std::default_random_engine generator;
+		static thread_local std::uniform_real_distribution<double> distribution;
 
 		unsigned int maxLevel;
 		unsigned int heighestLevel;
@@ -38,6 +49,20 @@ class SkipList
 		/// <return>SkipListNode* the first node for which key >= node.key</return>
 		SkipListNode* findInsertOrDeleteNode(std::vector<SkipListNode*>&, const Key&);
 
+		/// <summary>
+		/// The number of searches advanced in lockstep by the batched lookups
+		/// </summary>
+		static constexpr unsigned int batchGroupSize = 16;
+
+		/// <summary>
+		/// Finds the nodes of many keys, advancing a group of searches by one step at a time and prefetching
+		/// what the next step of every search reads, so that the cache misses of the group overlap
+		/// </summary>
+		/// <param>const std::vector<Key>& the keys to look for</param>
+		/// <param>Function the function called with (size_t index of the key, const SkipListNode* node or nullptr) when a search ends</param>
+		template<typename Function>
+		void findBatch(const std::vector<Key>&, Function) const;
+
 		/// <summary>
 		/// Uses the built-in random generation via uniform real distribution between 0 and 1
 		/// to calculate the levels of a node to be inserted
@@ -50,7 +75,46 @@ class SkipList
 		/// </summary>
 		void deleteInternals();
 
+		/// <summary>
+		/// The size of the buffers through which dump and restore stream the pairs
+		/// </summary>
+		static constexpr size_t snapshotBufferSize = 1 << 20;
+
 		SkipListNode* head;
+#ifdef SKIPLIST_STATS
+	public:
+		/// <summary>
+		/// Counters collected on the hot paths of the list, compiled in only when SKIPLIST_STATS is defined
+		/// </summary>
+		struct Stats {
+			unsigned long long searches;
+			unsigned long long comparisons;
+			std::vector<unsigned long long> nodesVisitedPerLevel;
+			std::vector<unsigned long long> levelHistogram;
+			unsigned int heighestLevel;
+
+			Stats(const unsigned int&);
+
+			/// <summary>
+			/// Average number of key comparisons made by contains/insert/remove searches
+			/// </summary>
+			/// <return>double the mean comparisons per search or 0 if no search was made</return>
+			double averageComparisonsPerSearch() const;
+		};
+
+		/// <summary>
+		/// Getter for the collected counters together with the current heighest level
+		/// </summary>
+		/// <return>Stats a snapshot of the counters</return>
+		Stats getStats() const;
+
+		/// <summary>
+		/// Clears all collected counters
+		/// </summary>
+		void resetStats();
+	private:
+		mutable Stats stats;
+#endif
 	public:
 		~SkipList();
 		/// <summary>
@@ -67,6 +131,17 @@ class SkipList
 		/// <param>const Key& the value to insert/update</param>
 		void insert(const Key&, const Value&);
 
+		/// <summary>
+		/// Inserts key-value pairs given in ascending order of the keys, or updates the existing keys
+		/// The predecessors found for a key are kept as a finger for the next one, so a search only climbs
+		/// as many levels as the distance to the previous key needs instead of starting from the head
+		/// Keys out of order are still inserted, their search starts from the head
+		/// </summary>
+		/// <param>Iterator the first std::pair<Key, Value> to insert</param>
+		/// <param>Iterator the end of the pairs</param>
+		template<typename Iterator>
+		void insertSorted(Iterator, Iterator);
+
 		/// <summary>
 		/// Searches for a node with key
 		/// </summary>
@@ -74,6 +149,27 @@ class SkipList
 		/// <return>bool whether the key was found</return>
 		bool contains(const Key&) const;
 
+		/// <summary>
+		/// Getter for the value of a node, found by key
+		/// </summary>
+		/// <param>const Key& the key to look for</param>
+		/// <return>const Value* the value or nullptr if the key is not in the list</return>
+		const Value* getValue(const Key&) const;
+
+		/// <summary>
+		/// Checks whether many keys are inside the list, interleaving the searches to overlap their cache misses
+		/// </summary>
+		/// <param>const std::vector<Key>& the keys to look for</param>
+		/// <param>std::vector<bool>& receives whether every key was found, in the order of the keys</param>
+		void containsBatch(const std::vector<Key>&, std::vector<bool>&) const;
+
+		/// <summary>
+		/// Getter for the values of many keys, interleaving the searches to overlap their cache misses
+		/// </summary>
+		/// <param>const std::vector<Key>& the keys to look for</param>
+		/// <param>std::vector<const Value*>& receives the value of every key or nullptr, in the order of the keys</param>
+		void getValueBatch(const std::vector<Key>&, std::vector<const Value*>&) const;
+
 		/// <summary>
 		/// Removes a node with key
 		/// </summary>
@@ -85,6 +181,57 @@ class SkipList
 		/// </summary>
 		/// <return>unsigned int the number of elements at level 0</return>
 		unsigned int numberOfElements() const;
+
+		/// <summary>
+		/// Calls a function for all pairs in ascending order of the keys by walking level 0
+		/// </summary>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEach(Function) const;
+
+		/// <summary>
+		/// Calls a function for the pairs with keys in [low, high], scanning chunks of the range in parallel on a pool
+		/// The chunks start at the nodes of the highest level holding about 8 nodes of the range per pool thread,
+		/// so their expected lengths are equal and the pool steals the chunks of a thread falling behind
+		/// The function is called concurrently, in ascending order of the keys only within a chunk,
+		/// and may use WorkStealingPool::workerIndex() to pick a per-thread accumulator
+		/// The list must not be modified during the scan
+		/// </summary>
+		/// <param>const Key& the smallest key of the range</param>
+		/// <param>const Key& the largest key of the range</param>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		/// <param>WorkStealingPool& the pool</param>
+		template<typename Function>
+		void parallelForEach(const Key&, const Key&, Function, WorkStealingPool&) const;
+
+		/// <summary>
+		/// Calls a function for the pairs with keys in [low, high] like the pool overload, on a pool started for the call
+		/// </summary>
+		/// <param>const Key& the smallest key of the range</param>
+		/// <param>const Key& the largest key of the range</param>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		/// <param>const unsigned int& the number of threads, including the calling thread</param>
+		template<typename Function>
+		void parallelForEach(const Key&, const Key&, Function, const unsigned int&) const;
+
+		/// <summary>
+		/// Writes the pairs in ascending order of the keys to a binary stream, in blocks of at most snapshotBufferSize bytes,
+		/// so the memory used does not depend on the size of the list
+		/// Key and Value must be trivially copyable, the snapshot is read back only by a build with the same types and byte order
+		/// </summary>
+		/// <param>std::ostream& the stream, opened in binary mode</param>
+		/// <param>bool whether to store the level of every node, so that restore rebuilds the same towers, default is false</param>
+		/// <return>bool whether the stream accepted all writes</return>
+		bool dump(std::ostream&, const bool& = false) const;
+
+		/// <summary>
+		/// Replaces the contents of the list with a snapshot written by dump
+		/// The pairs are appended behind the last node of every level without searching, so the rebuild is linear
+		/// Stored levels above the maximum level of this list are lowered to it, without stored levels new ones are generated
+		/// </summary>
+		/// <param>std::istream& the stream, opened in binary mode</param>
+		/// <return>bool whether a whole snapshot for the key and value types was read, if not the list is left empty</return>
+		bool restore(std::istream&);
 };
 
 #endif
@@ -4,6 +4,10 @@
 #include <time.h>
 #include <chrono>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <random>
 
 using namespace std::chrono;
 
@@ -141,6 +145,312 @@ TEST_CASE("SkipList Containts, node that does not exist") {
 	CHECK(skipList.contains(893223) == false);
 }
 
+TEST_CASE("SkipList GetValue") {
+	SkipList<int, int> skipList{ 10 };
+	skipList.insert(8, 80);
+	skipList.insert(9, 90);
+
+	CHECK(*skipList.getValue(9) == 90);
+	CHECK(skipList.getValue(10) == nullptr);
+}
+
+TEST_CASE("SkipList ContainsBatch") {
+	SkipList<int, int> skipList{ 1000 };
+	std::vector<int> keys;
+	for (int i = 0; i < 1000; i++) {
+		skipList.insert(i * 3, i);
+		keys.push_back(i * 3 + i % 2);
+	}
+	keys.resize(999);
+
+	std::vector<bool> found;
+	skipList.containsBatch(keys, found);
+
+	bool same = found.size() == keys.size();
+	for (size_t i = 0; i < keys.size() && same; i++) {
+		same = found[i] == skipList.contains(keys[i]);
+	}
+	CHECK(same);
+
+	skipList.containsBatch(std::vector<int>{}, found);
+	CHECK(found.empty());
+}
+
+TEST_CASE("SkipList GetValueBatch") {
+	SkipList<int, int> skipList{ 1000 };
+	for (int i = 0; i < 100; i++) {
+		skipList.insert(i, i * 10);
+	}
+
+	std::vector<const int*> values;
+	skipList.getValueBatch(std::vector<int>{ 5, 500, 99, -1 }, values);
+
+	CHECK(values.size() == 4);
+	CHECK(*values[0] == 50);
+	CHECK(values[1] == nullptr);
+	CHECK(*values[2] == 990);
+	CHECK(values[3] == nullptr);
+}
+
+TEST_CASE("SkipList InsertSorted") {
+	SkipList<int, int> skipList{ 1000 };
+	std::vector<std::pair<int, int>> pairs;
+	for (int i = 0; i < 1000; i++) {
+		pairs.push_back({ i * 2, i });
+	}
+	skipList.insertSorted(pairs.begin(), pairs.end());
+
+	CHECK(skipList.numberOfElements() == 1000);
+	CHECK(*skipList.getValue(998) == 499);
+	CHECK(skipList.contains(999) == false);
+
+	std::vector<int> keys;
+	skipList.forEach([&keys](const int& key, const int&) {
+		keys.push_back(key);
+	});
+	CHECK(std::is_sorted(keys.begin(), keys.end()));
+}
+
+TEST_CASE("SkipList InsertSorted, existing and unsorted keys") {
+	SkipList<int, int> skipList{ 100 };
+	for (int i = 0; i < 100; i += 10) {
+		skipList.insert(i, -1);
+	}
+
+	//repeated keys, keys already in the list and a key before the previous one
+	std::vector<std::pair<int, int>> pairs{ { 5, 5 }, { 10, 10 }, { 10, 11 }, { 15, 15 }, { 3, 3 }, { 95, 95 }, { 40, 40 } };
+	skipList.insertSorted(pairs.begin(), pairs.end());
+
+	CHECK(skipList.numberOfElements() == 14);
+	CHECK(*skipList.getValue(10) == 11);
+	CHECK(*skipList.getValue(40) == 40);
+	CHECK(*skipList.getValue(20) == -1);
+	CHECK(*skipList.getValue(3) == 3);
+
+	std::vector<int> keys;
+	skipList.forEach([&keys](const int& key, const int&) {
+		keys.push_back(key);
+	});
+	CHECK(std::is_sorted(keys.begin(), keys.end()));
+
+	skipList.insertSorted(pairs.end(), pairs.end());
+	CHECK(skipList.numberOfElements() == 14);
+}
+
+TEST_CASE("SkipList ForEach") {
+	SkipList<int, int> skipList{ 100 };
+	for (int i = 99; i >= 0; i--) {
+		skipList.insert(i, i * 2);
+	}
+
+	std::vector<int> keys;
+	bool valuesMatch = true;
+	skipList.forEach([&keys, &valuesMatch](const int& key, const int& value) {
+		keys.push_back(key);
+		valuesMatch = valuesMatch && value == key * 2;
+	});
+
+	CHECK(keys.size() == 100);
+	CHECK(std::is_sorted(keys.begin(), keys.end()));
+	CHECK(valuesMatch);
+}
+
+TEST_CASE("SkipList ParallelForEach") {
+	SkipList<int, int> skipList{ 100000 };
+	std::vector<int> keys;
+	for (int i = 0; i < 100000; i++) {
+		keys.push_back(i * 3);
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937{ 29 });
+	for (const int& key : keys) {
+		skipList.insert(key, key + 1);
+	}
+
+	WorkStealingPool pool{ 4 };
+	std::vector<std::pair<int, int>> ranges{ { 0, 299997 }, { -50, 400000 }, { 1000, 1000 }, { 1001, 1002 }, { 7, 200000 }, { 150000, 150090 }, { 500, 100 } };
+	for (const std::pair<int, int>& range : ranges) {
+		//one list per worker, no synchronization is needed inside the function
+		std::vector<std::vector<int>> visited(pool.threadsCount());
+		bool valuesMatch = true;
+		skipList.parallelForEach(range.first, range.second, [&](const int& key, const int& value) {
+			visited[WorkStealingPool::workerIndex()].push_back(key);
+			if (value != key + 1) {
+				valuesMatch = false;
+			}
+		}, pool);
+
+		std::vector<int> merged;
+		for (const std::vector<int>& part : visited) {
+			merged.insert(merged.end(), part.begin(), part.end());
+		}
+		std::sort(merged.begin(), merged.end());
+
+		std::vector<int> expected;
+		skipList.forEach([&](const int& key, const int&) {
+			if (range.first <= key && key <= range.second) {
+				expected.push_back(key);
+			}
+		});
+		CHECK(merged == expected);
+		CHECK(valuesMatch);
+	}
+
+	long long sum = 0;
+	skipList.parallelForEach(0, 30, [&sum](const int& key, const int&) { sum += key; }, 1u);
+	CHECK(sum == 0 + 3 + 6 + 9 + 12 + 15 + 18 + 21 + 24 + 27 + 30);
+
+	SkipList<int, int> empty{ 100 };
+	empty.parallelForEach(0, 100, [&sum](const int&, const int&) { sum = -1; }, pool);
+	CHECK(sum != -1);
+}
+
+TEST_CASE("SkipList Dump and restore") {
+	SkipList<int, double> skipList{ 100000 };
+	for (int i = 0; i < 100000; i++) {
+		skipList.insert(i * 7 % 100003, i * 0.5);
+	}
+
+	std::stringstream snapshot;
+	REQUIRE(skipList.dump(snapshot));
+
+	SkipList<int, double> restored{ 100000 };
+	restored.insert(-5, 1);
+	REQUIRE(restored.restore(snapshot));
+	CHECK(restored.numberOfElements() == 100000);
+	CHECK(restored.contains(-5) == false);
+
+	std::vector<std::pair<int, double>> expected, pairs;
+	skipList.forEach([&expected](const int& key, const double& value) {
+		expected.emplace_back(key, value);
+	});
+	restored.forEach([&pairs](const int& key, const double& value) {
+		pairs.emplace_back(key, value);
+	});
+	CHECK(pairs == expected);
+
+	//the restored list takes inserts and removes
+	restored.insert(-5, 1);
+	restored.remove(7);
+	CHECK(restored.contains(-5));
+	CHECK(restored.contains(7) == false);
+}
+
+TEST_CASE("SkipList Dump and restore, stored levels") {
+	SkipList<int, int> skipList{ 5000 };
+	for (int i = 0; i < 5000; i++) {
+		skipList.insert(rand(), i);
+	}
+
+	std::stringstream snapshot;
+	REQUIRE(skipList.dump(snapshot, true));
+
+	SkipList<int, int> restored{ 5000 };
+	REQUIRE(restored.restore(snapshot));
+
+	//the same towers give the same snapshot
+	std::stringstream again;
+	REQUIRE(restored.dump(again, true));
+	CHECK(again.str() == snapshot.str());
+}
+
+TEST_CASE("SkipList Dump and restore, empty list") {
+	SkipList<int, int> skipList{ 10 };
+	std::stringstream snapshot;
+	REQUIRE(skipList.dump(snapshot));
+
+	SkipList<int, int> restored{ 10 };
+	restored.insert(1, 1);
+	CHECK(restored.restore(snapshot));
+	CHECK(restored.numberOfElements() == 0);
+}
+
+TEST_CASE("SkipList Restore, invalid snapshots") {
+	SkipList<int, int> skipList{ 100 };
+	for (int i = 0; i < 100; i++) {
+		skipList.insert(i, i);
+	}
+	std::stringstream snapshot;
+	REQUIRE(skipList.dump(snapshot));
+	std::string bytes = snapshot.str();
+
+	SkipList<int, long long> otherValue{ 100 };
+	std::stringstream other{ bytes };
+	CHECK(otherValue.restore(other) == false);
+
+	SkipList<int, int> restored{ 100 };
+	std::stringstream truncated{ bytes.substr(0, bytes.size() - 10) };
+	CHECK(restored.restore(truncated) == false);
+	CHECK(restored.numberOfElements() == 0);
+
+	//the second record repeats the first key, the records start after the 24 bytes of the header and the size of the block
+	std::string unsorted = bytes;
+	std::memcpy(&unsorted[28 + 8], &unsorted[28], sizeof(int));
+	std::stringstream unsortedStream{ unsorted };
+	CHECK(restored.restore(unsortedStream) == false);
+	CHECK(restored.numberOfElements() == 0);
+
+	std::stringstream valid{ bytes };
+	CHECK(restored.restore(valid));
+	CHECK(restored.numberOfElements() == 100);
+}
+
+#ifdef SKIPLIST_STATS
+TEST_CASE("SkipList Stats") {
+	SkipList<int, int> skipList{ 1024 };
+	for (int i = 0; i < 1000; i++) {
+		skipList.insert(i, i);
+	}
+	skipList.resetStats();
+
+	CHECK(skipList.contains(500));
+	CHECK(skipList.contains(2000) == false);
+
+	SkipList<int, int>::Stats stats = skipList.getStats();
+	unsigned long long visited = 0;
+	for (unsigned long long nodes : stats.nodesVisitedPerLevel) {
+		visited += nodes;
+	}
+
+	CHECK(stats.searches == 2);
+	CHECK(stats.comparisons >= visited);
+	CHECK(stats.averageComparisonsPerSearch() > 1);
+	CHECK(stats.heighestLevel > 0);
+}
+
+TEST_CASE("SkipList Stats, level histogram") {
+	SkipList<int, int> skipList{ 1024, 0.25 };
+	for (int i = 0; i < 1000; i++) {
+		skipList.insert(i, i);
+	}
+
+	SkipList<int, int>::Stats stats = skipList.getStats();
+	unsigned long long generated = 0;
+	for (unsigned long long nodes : stats.levelHistogram) {
+		generated += nodes;
+	}
+
+	CHECK(generated == 1000);
+	CHECK(stats.levelHistogram[0] > stats.levelHistogram[1]);
+}
+TEST_CASE("SkipList Stats, sorted insert") {
+	std::vector<std::pair<int, int>> pairs;
+	for (int i = 0; i < 1000; i++) {
+		pairs.push_back({ i, i });
+	}
+
+	SkipList<int, int> oneByOne{ 1024 };
+	for (const std::pair<int, int>& pair : pairs) {
+		oneByOne.insert(pair.first, pair.second);
+	}
+
+	SkipList<int, int> sorted{ 1024 };
+	sorted.insertSorted(pairs.begin(), pairs.end());
+
+	CHECK(sorted.getStats().searches == 1000);
+	CHECK(sorted.getStats().averageComparisonsPerSearch() < oneByOne.getStats().averageComparisonsPerSearch() / 2);
+}
+#endif
+
 TEST_CASE("SkipList Tree with 50 elements") {
 	CHECK(testSkipListWithElements(50, 1, 'i') < 10);
 	CHECK(testSkipListWithElements(50, 1, 'c') < 10);
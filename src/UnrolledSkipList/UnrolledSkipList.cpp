@@ -0,0 +1,255 @@
+#include "UnrolledSkipList.h"
+#include "../Simd/LowerBound.h"
+#include <math.h>
+
+template<typename Key, typename Value>
+thread_local std::default_random_engine UnrolledSkipList<Key, Value>::generator;
+
+template<typename Key, typename Value>
+thread_local std::uniform_real_distribution<double> UnrolledSkipList<Key, Value>::distribution{ 0.0, 1.0 };
+
+template<typename Key, typename Value>
+UnrolledSkipList<Key, Value>::UnrolledNode::UnrolledNode(const unsigned int& _level) :
+	count(0),
+	forward(_level + 1) {}
+
+template<typename Key, typename Value>
+void UnrolledSkipList<Key, Value>::deleteInternals() {
+	while (this->head) {
+		UnrolledNode* current = this->head;
+		this->head = this->head->forward[0];
+
+		delete current;
+	}
+}
+
+template<typename Key, typename Value>
+unsigned int UnrolledSkipList<Key, Value>::generateLevel() const {
+	unsigned int levels = 0;
+
+	while (UnrolledSkipList::distribution(generator) < this->probability && levels < this->maxLevel) {
+		levels++;
+	}
+
+	return levels;
+}
+
+template<typename Key, typename Value>
+UnrolledSkipList<Key, Value>::~UnrolledSkipList() {
+	this->deleteInternals();
+}
+
+//the towers index nodes instead of keys, so the levels are sized by the expected number of nodes
+template<typename Key, typename Value>
+UnrolledSkipList<Key, Value>::UnrolledSkipList(const unsigned int& maximumElements, const float& _probability) :
+	maxLevel((unsigned int)std::log2(maximumElements / nodeCapacity + 1)),
+	heighestLevel(0),
+	probability(_probability)
+{
+	this->head = new UnrolledNode{ this->maxLevel };
+}
+
+template<typename Key, typename Value>
+typename UnrolledSkipList<Key, Value>::UnrolledNode* UnrolledSkipList<Key, Value>::findNode(const Key& key) const {
+	UnrolledNode* current = this->head;
+
+	for (unsigned int i = this->heighestLevel; i >= 0 && i <= this->heighestLevel; i--) {
+		//moving through the current level while the next node starts with a key <= key
+		while (current->forward[i] && !(key < current->forward[i]->keys[0])) {
+			current = current->forward[i];
+		}
+	}
+
+	return current == this->head ? nullptr : current;
+}
+
+template<typename Key, typename Value>
+typename UnrolledSkipList<Key, Value>::UnrolledNode* UnrolledSkipList<Key, Value>::findInsertOrDeleteNode(std::vector<UnrolledNode*>& update, const Key& key) {
+	UnrolledNode* current = this->head;
+
+	for (unsigned int i = this->heighestLevel; i >= 0 && i <= this->heighestLevel; i--) {
+		while (current->forward[i] && current->forward[i]->keys[0] < key) {
+			current = current->forward[i];
+		}
+		update[i] = current;
+	}
+
+	UnrolledNode* next = current->forward[0];
+	if (next && !(key < next->keys[0])) {//the key is the first one of the next node
+		return next;
+	}
+
+	//a key less than all keys goes into the first node
+	return current == this->head ? next : current;
+}
+
+template<typename Key, typename Value>
+void UnrolledSkipList<Key, Value>::insertIntoNode(UnrolledNode* node, const unsigned int& position, const Key& key, const Value& value) {
+	std::move_backward(node->keys + position, node->keys + node->count, node->keys + node->count + 1);
+	std::move_backward(node->values + position, node->values + node->count, node->values + node->count + 1);
+	node->keys[position] = key;
+	node->values[position] = value;
+	node->count++;
+}
+
+template<typename Key, typename Value>
+void UnrolledSkipList<Key, Value>::linkAfter(UnrolledNode* node, UnrolledNode* previous, std::vector<UnrolledNode*>& update) {
+	for (unsigned int i = 0; i < node->forward.size(); i++) {
+		UnrolledNode* predecessor = i < previous->forward.size() ? previous : update[i];
+		node->forward[i] = predecessor->forward[i];
+		predecessor->forward[i] = node;
+	}
+}
+
+template<typename Key, typename Value>
+void UnrolledSkipList<Key, Value>::unlink(UnrolledNode* node, UnrolledNode* previous, std::vector<UnrolledNode*>& update) {
+	for (unsigned int i = 0; i < node->forward.size(); i++) {
+		UnrolledNode* predecessor = i < previous->forward.size() ? previous : update[i];
+		predecessor->forward[i] = node->forward[i];
+	}
+
+	//if the heighest node was removed, recalculate the heighest level
+	while (this->heighestLevel > 0 && !this->head->forward[this->heighestLevel]) {
+		this->heighestLevel--;
+	}
+}
+
+template<typename Key, typename Value>
+void UnrolledSkipList<Key, Value>::insert(const Key& key, const Value& value) {
+	std::vector<UnrolledNode*> update{ this->maxLevel + 1 };
+	UnrolledNode* target = this->findInsertOrDeleteNode(update, key);
+
+	unsigned int position = 0;
+	if (target) {
+		position = LowerBound<Key>::find(target->keys, target->count, key);
+		if (position < target->count && !(key < target->keys[position])) {
+			target->values[position] = value;
+			return;
+		}
+
+		if (target->count < nodeCapacity) {
+			insertIntoNode(target, position, key, value);
+			return;
+		}
+	}
+
+	unsigned int generatedLevel = this->generateLevel();
+	if (generatedLevel > this->heighestLevel) {//levels from the head node must be updated
+		for (unsigned int i = this->heighestLevel + 1; i < generatedLevel + 1; i++) {
+			update[i] = this->head;
+		}
+
+		this->heighestLevel = generatedLevel;
+	}
+
+	UnrolledNode* n = new UnrolledNode{ generatedLevel };
+	if (!target) {//the list is empty
+		insertIntoNode(n, 0, key, value);
+		this->linkAfter(n, this->head, update);
+		return;
+	}
+
+	//the node is full - move its upper half to the new node and insert into the half the key belongs to
+	unsigned int middle = nodeCapacity / 2;
+	std::move(target->keys + middle, target->keys + nodeCapacity, n->keys);
+	std::move(target->values + middle, target->values + nodeCapacity, n->values);
+	n->count = nodeCapacity - middle;
+	target->count = middle;
+	this->linkAfter(n, target, update);
+
+	if (position > middle) {
+		insertIntoNode(n, position - middle, key, value);
+	}
+	else {
+		insertIntoNode(target, position, key, value);
+	}
+}
+
+template<typename Key, typename Value>
+bool UnrolledSkipList<Key, Value>::contains(const Key& key) const {
+	return this->getValue(key) != nullptr;
+}
+
+template<typename Key, typename Value>
+const Value* UnrolledSkipList<Key, Value>::getValue(const Key& key) const {
+	UnrolledNode* node = this->findNode(key);
+	if (!node) {
+		return nullptr;
+	}
+
+	unsigned int position = LowerBound<Key>::find(node->keys, node->count, key);
+	if (position < node->count && !(key < node->keys[position])) {
+		return &node->values[position];
+	}
+
+	return nullptr;
+}
+
+template<typename Key, typename Value>
+void UnrolledSkipList<Key, Value>::remove(const Key& key) {
+	std::vector<UnrolledNode*> update{ this->maxLevel + 1 };
+	UnrolledNode* target = this->findInsertOrDeleteNode(update, key);
+	if (!target) {
+		return;
+	}
+
+	unsigned int position = LowerBound<Key>::find(target->keys, target->count, key);
+	if (position == target->count || key < target->keys[position]) {
+		return;
+	}
+
+	std::move(target->keys + position + 1, target->keys + target->count, target->keys + position);
+	std::move(target->values + position + 1, target->values + target->count, target->values + position);
+	target->count--;
+
+	if (!target->count) {//only the first key of a node can empty it, so the node follows update[0]
+		this->unlink(target, update[0], update);
+		delete target;
+		return;
+	}
+
+	UnrolledNode* next = target->forward[0];
+	if (target->count >= nodeCapacity / 4 || !next) {
+		return;
+	}
+
+	if (target->count + next->count <= nodeCapacity * 3 / 4) {//merge the next node into the current one
+		std::move(next->keys, next->keys + next->count, target->keys + target->count);
+		std::move(next->values, next->values + next->count, target->values + target->count);
+		target->count += next->count;
+
+		this->unlink(next, target, update);
+		delete next;
+		return;
+	}
+
+	//take pairs from the front of the next node until both hold about the same number
+	unsigned int moved = (next->count - target->count) / 2;
+	std::move(next->keys, next->keys + moved, target->keys + target->count);
+	std::move(next->values, next->values + moved, target->values + target->count);
+	target->count += moved;
+
+	std::move(next->keys + moved, next->keys + next->count, next->keys);
+	std::move(next->values + moved, next->values + next->count, next->values);
+	next->count -= moved;
+}
+
+template<typename Key, typename Value>
+unsigned int UnrolledSkipList<Key, Value>::numberOfElements() const {
+	unsigned int res = 0;
+	for (UnrolledNode* current = this->head->forward[0]; current; current = current->forward[0]) {
+		res += current->count;
+	}
+
+	return res;
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void UnrolledSkipList<Key, Value>::forEach(Function function) const {
+	for (UnrolledNode* current = this->head->forward[0]; current; current = current->forward[0]) {
+		for (unsigned int i = 0; i < current->count; i++) {
+			function(current->keys[i], current->values[i]);
+		}
+	}
+}
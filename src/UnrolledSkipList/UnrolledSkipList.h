@@ -0,0 +1,146 @@
+#ifndef UNROLLEDSKIPLIST_H
+#define UNROLLEDSKIPLIST_H
+
+#include<vector>
+#include<random>
+#include<algorithm>
+
+/// <summary>
+/// A template class representing an unrolled Skip list data structure with the interface of the Skip list
+/// Every node holds a small sorted array of key-value pairs and the towers are ordered by the first key of a node,
+/// so descents and scans follow a pointer per node instead of a pointer per key
+/// Duplicate keys are not supported - the lastly added value for a key is taken
+/// </summary>
+template<typename Key, typename Value>
+class UnrolledSkipList
+{
+	private:
+		/// <summary>
+		/// The number of pairs of a node - the keys fill four cache lines, between 16 and 64 pairs
+		/// </summary>
+		static constexpr unsigned int nodeCapacity = std::min<unsigned int>(64, std::max<unsigned int>(16, 4 * 64 / sizeof(Key)));
+
+		struct UnrolledNode {
+			unsigned int count;
+			Key keys[nodeCapacity];
+			Value values[nodeCapacity];
+
+			std::vector<UnrolledNode*> forward;
+
+			UnrolledNode(const unsigned int&);
+		};
+
+		static thread_local std::default_random_engine generator;
+		static thread_local std::uniform_real_distribution<double> distribution;
+
+		unsigned int maxLevel;
+		unsigned int heighestLevel;
+		float probability;
+
+		/// <summary>
+		/// Used to populate the update list with the last node at every level whose first key is less than the key
+		/// </summary>
+		/// <param>std::vector<UnrolledNode*>& the update list to be populated</param>
+		/// <param>const Key& the key to insert/delete</param>
+		/// <return>UnrolledNode* the node which holds the key or into which it should be inserted, nullptr for an empty list</return>
+		UnrolledNode* findInsertOrDeleteNode(std::vector<UnrolledNode*>&, const Key&);
+
+		/// <summary>
+		/// Finds the last node whose first key is less than or equal to the key - the only node which may hold it
+		/// </summary>
+		/// <param>const Key& the key to look for</param>
+		/// <return>UnrolledNode* the node or nullptr if the key is less than all keys</return>
+		UnrolledNode* findNode(const Key&) const;
+
+		/// <summary>
+		/// Inserts a pair at a position of a node which is not full, shifting the following pairs
+		/// </summary>
+		/// <param>UnrolledNode* the node</param>
+		/// <param>const unsigned int& the position</param>
+		/// <param>const Key& the key to insert</param>
+		/// <param>const Value& the value to insert</param>
+		static void insertIntoNode(UnrolledNode*, const unsigned int&, const Key&, const Value&);
+
+		/// <summary>
+		/// Links a node after the predecessors of another node at all of its levels
+		/// </summary>
+		/// <param>UnrolledNode* the node to link</param>
+		/// <param>UnrolledNode* the node after which it is linked at the levels both have</param>
+		/// <param>std::vector<UnrolledNode*>& the predecessors at the higher levels</param>
+		void linkAfter(UnrolledNode*, UnrolledNode*, std::vector<UnrolledNode*>&);
+
+		/// <summary>
+		/// Unlinks a node from all of its levels
+		/// </summary>
+		/// <param>UnrolledNode* the node to unlink</param>
+		/// <param>UnrolledNode* the node right before it at level 0, the predecessor at the levels both have</param>
+		/// <param>std::vector<UnrolledNode*>& the predecessors at the higher levels</param>
+		void unlink(UnrolledNode*, UnrolledNode*, std::vector<UnrolledNode*>&);
+
+		/// <summary>
+		/// Uses the built-in random generation via uniform real distribution between 0 and 1
+		/// to calculate the levels of a node to be inserted
+		/// </summary>
+		/// <return>unsigned int the randomly generated level for the new node</return>
+		unsigned int generateLevel() const;
+
+		/// <summary>
+		/// Used by the destructor to delete the list elements
+		/// </summary>
+		void deleteInternals();
+
+		UnrolledNode* head;
+	public:
+		~UnrolledSkipList();
+		UnrolledSkipList(const UnrolledSkipList&) = delete;
+		UnrolledSkipList& operator=(const UnrolledSkipList&) = delete;
+
+		/// <summary>
+		/// Creates an unrolled skip list with maximum elements expected and probability for new node levels generation
+		/// </summary>
+		/// <param>const unsigned int& the number of maximum elements</param>
+		/// <param>const float& the probability for generating levels, default is 0.5</param>
+		UnrolledSkipList(const unsigned int&, const float& = 0.50);
+
+		/// <summary>
+		/// Inserts a new pair for a given key or updates an existing one, a full node is split in halves
+		/// </summary>
+		/// <param>const Key& the key to look for</param>
+		/// <param>const Key& the value to insert/update</param>
+		void insert(const Key&, const Value&);
+
+		/// <summary>
+		/// Searches for a key
+		/// </summary>
+		/// <param>const Key& the key to look for</param>
+		/// <return>bool whether the key was found</return>
+		bool contains(const Key&) const;
+
+		/// <summary>
+		/// Getter for the value of a key
+		/// </summary>
+		/// <param>const Key& the key to look for</param>
+		/// <return>const Value* the value or nullptr if the key is not in the list</return>
+		const Value* getValue(const Key&) const;
+
+		/// <summary>
+		/// Removes a key, a node which becomes a quarter full takes pairs from the next node or is merged with it
+		/// </summary>
+		/// <param>const Key& the key to look for</param>
+		void remove(const Key&);
+
+		/// <summary>
+		/// Counts the number of elements
+		/// </summary>
+		/// <return>unsigned int the number of elements</return>
+		unsigned int numberOfElements() const;
+
+		/// <summary>
+		/// Calls a function for all pairs in ascending order of the keys
+		/// </summary>
+		/// <param>Function the function called with (const Key&, const Value&)</param>
+		template<typename Function>
+		void forEach(Function) const;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include "src/Doctest/doctest.h"
+#include "src/UnrolledSkipList/UnrolledSkipList.cpp"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+
+TEST_CASE("UnrolledSkipList Insert") {
+	UnrolledSkipList<int, int> skipList{ 1000 };
+	for (int i = 0; i < 1000; i++) {
+		skipList.insert(i, i);
+	}
+
+	CHECK(skipList.numberOfElements() == 1000);
+	CHECK(skipList.contains(0));
+	CHECK(skipList.contains(999));
+	CHECK(*skipList.getValue(500) == 500);
+}
+
+TEST_CASE("UnrolledSkipList Insert, duplicate key") {
+	UnrolledSkipList<int, int> skipList{ 10 };
+	skipList.insert(1, 1);
+	skipList.insert(1, 2);
+
+	CHECK(skipList.numberOfElements() == 1);
+	CHECK(*skipList.getValue(1) == 2);
+}
+
+TEST_CASE("UnrolledSkipList Insert, descending keys") {
+	UnrolledSkipList<int, int> skipList{ 1000 };
+	for (int i = 999; i >= 0; i--) {
+		skipList.insert(i, i);
+	}
+
+	std::vector<int> keys;
+	skipList.forEach([&keys](const int& key, const int&) {
+		keys.push_back(key);
+	});
+
+	CHECK(keys.size() == 1000);
+	CHECK(std::is_sorted(keys.begin(), keys.end()));
+}
+
+TEST_CASE("UnrolledSkipList Remove, all keys") {
+	UnrolledSkipList<int, int> skipList{ 1000 };
+	for (int i = 0; i < 1000; i++) {
+		skipList.insert(i, i);
+	}
+	for (int i = 0; i < 1000; i++) {
+		skipList.remove(i);
+	}
+
+	CHECK(skipList.numberOfElements() == 0);
+	CHECK(skipList.contains(0) == false);
+
+	skipList.insert(5, 5);
+	CHECK(skipList.numberOfElements() == 1);
+}
+
+TEST_CASE("UnrolledSkipList Remove, key that does not exist") {
+	UnrolledSkipList<int, int> skipList{ 10 };
+	skipList.remove(1);
+	skipList.insert(2, 2);
+	skipList.remove(1);
+	skipList.remove(3);
+
+	CHECK(skipList.numberOfElements() == 1);
+}
+
+TEST_CASE("UnrolledSkipList Contains, empty list") {
+	UnrolledSkipList<int, int> skipList{ 10 };
+
+	CHECK(skipList.contains(1) == false);
+	CHECK(skipList.getValue(1) == nullptr);
+}
+
+TEST_CASE("UnrolledSkipList Random operations") {
+	UnrolledSkipList<int, int> skipList{ 20000 };
+	std::map<int, int> expected;
+	std::mt19937 generator{ 7 };
+	std::uniform_int_distribution<int> keys{ 0, 20000 };
+
+	for (int i = 0; i < 200000; i++) {
+		int key = keys(generator);
+		if (generator() % 2 == 0) {
+			skipList.remove(key);
+			expected.erase(key);
+		} else {
+			skipList.insert(key, i);
+			expected[key] = i;
+		}
+	}
+
+	CHECK(skipList.numberOfElements() == expected.size());
+
+	std::vector<std::pair<int, int>> elements;
+	skipList.forEach([&elements](const int& key, const int& value) {
+		elements.push_back({ key, value });
+	});
+	CHECK(elements == std::vector<std::pair<int, int>>(expected.begin(), expected.end()));
+
+	bool same = true;
+	for (int key = 0; key <= 20000; key++) {
+		same = same && skipList.contains(key) == (expected.count(key) == 1);
+	}
+	CHECK(same);
+}
+
+TEST_CASE("UnrolledSkipList String keys") {
+	UnrolledSkipList<std::string, int> skipList{ 500 };
+	for (int i = 0; i < 500; i++) {
+		skipList.insert(std::to_string(i), i);
+	}
+	skipList.remove("250");
+
+	CHECK(skipList.numberOfElements() == 499);
+	CHECK(*skipList.getValue("42") == 42);
+	CHECK(skipList.contains("250") == false);
+}
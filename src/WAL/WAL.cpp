@@ -0,0 +1,186 @@
+#include "WAL.h"
+#include "../Simd/Crc32.h"
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <type_traits>
+
+template<typename Key, typename Value>
+WAL<Key, Value>::WAL(const unsigned int& _groupSize) :
+	groupSize(_groupSize > 0 ? _groupSize : 1),
+	pendingRecords(0),
+	replayedRecords(0)
+{
+	this->buffer.reserve(this->groupSize * insertRecordSize);
+}
+
+template<typename Key, typename Value>
+WAL<Key, Value>::~WAL() {
+	if (this->file.isOpen()) {
+		this->commit();
+	}
+}
+
+template<typename Key, typename Value>
+void WAL<Key, Value>::append(const RecordType& type, const Key& key, const Value* value) {
+	size_t start = this->buffer.size();
+	this->buffer.resize(start + (value ? insertRecordSize : removeRecordSize));
+
+	char* record = this->buffer.data() + start;
+	record[checksumSize] = (char)type;
+	std::memcpy(record + checksumSize + 1, &key, sizeof(Key));
+	if (value) {
+		std::memcpy(record + checksumSize + 1 + sizeof(Key), value, sizeof(Value));
+	}
+	std::uint32_t checksum = SimdKernels::crc32c(record + checksumSize, this->buffer.size() - start - checksumSize);
+	std::memcpy(record, &checksum, checksumSize);
+
+	if (++this->pendingRecords >= this->groupSize) {
+		this->commit();
+	}
+}
+
+template<typename Key, typename Value>
+template<typename Structure>
+bool WAL<Key, Value>::replay(const std::string& path, Structure& structure, std::uint64_t& validSize) {
+	validSize = 0;
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		return true;
+	}
+
+	char header[headerSize];
+	in.read(header, headerSize);
+	if (in.gcount() < (std::streamsize)headerSize) {//a crash while the log was created, it is created again
+		return true;
+	}
+
+	std::uint32_t sizes[2];
+	std::memcpy(sizes, header + 8, sizeof(sizes));
+	if (std::memcmp(header, "DSPWAL1", 8) != 0 || sizes[0] != sizeof(Key) || sizes[1] != sizeof(Value)) {
+		return false;
+	}
+	validSize = headerSize;
+
+	char record[insertRecordSize];
+	while (in.read(record, checksumSize + 1)) {
+		size_t size;
+		if (record[checksumSize] == (char)insertRecord) {
+			size = insertRecordSize;
+		} else if (record[checksumSize] == (char)removeRecord) {
+			size = removeRecordSize;
+		} else {
+			break;
+		}
+
+		in.read(record + checksumSize + 1, size - checksumSize - 1);
+		std::uint32_t checksum;
+		std::memcpy(&checksum, record, checksumSize);
+		if (!in || checksum != SimdKernels::crc32c(record + checksumSize, size - checksumSize)) {
+			break;
+		}
+
+		Key key;
+		std::memcpy(&key, record + checksumSize + 1, sizeof(Key));
+		if (record[checksumSize] == (char)insertRecord) {
+			Value value;
+			std::memcpy(&value, record + checksumSize + 1 + sizeof(Key), sizeof(Value));
+			structure.insert(key, value);
+		} else {
+			structure.remove(key);
+		}
+
+		validSize += size;
+		this->replayedRecords++;
+	}
+
+	return true;
+}
+
+template<typename Key, typename Value>
+template<typename Structure>
+bool WAL<Key, Value>::open(const std::string& path, Structure& structure) {
+	static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "WAL needs trivially copyable keys and values");
+
+	this->file.close();
+	this->buffer.clear();
+	this->pendingRecords = 0;
+	this->replayedRecords = 0;
+
+	std::uint64_t validSize;
+	if (!this->replay(path, structure, validSize) || !this->file.open(path)) {
+		return false;
+	}
+
+	if (validSize == 0) {
+		char header[headerSize] = "DSPWAL1";
+		std::uint32_t sizes[2] = { sizeof(Key), sizeof(Value) };
+		std::memcpy(header + 8, sizes, sizeof(sizes));
+		//the entry of a created log must reach the disk too, else a commit to it could vanish with the file
+		std::string directory = std::filesystem::path(path).parent_path().string();
+		if (!this->file.truncate(0) || !this->file.append(header, headerSize) || !this->file.sync()
+			|| !AppendFile::syncDirectory(directory.empty() ? "." : directory)) {
+			this->file.close();
+			return false;
+		}
+	} else if (validSize < this->file.size()) {//cut off the torn tail so that new records follow the valid ones
+		if (!this->file.truncate(validSize) || !this->file.sync()) {
+			this->file.close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename Key, typename Value>
+void WAL<Key, Value>::logInsert(const Key& key, const Value& value) {
+	this->append(insertRecord, key, &value);
+}
+
+template<typename Key, typename Value>
+void WAL<Key, Value>::logRemove(const Key& key) {
+	this->append(removeRecord, key, nullptr);
+}
+
+template<typename Key, typename Value>
+bool WAL<Key, Value>::commit() {
+	if (!this->pendingRecords) {
+		return true;
+	}
+
+	//a failed write may have left a part of the group in the file, it is overwritten by the next commit
+	std::uint64_t committedSize = this->file.size();
+	if (!this->file.append(this->buffer.data(), this->buffer.size()) || !this->file.sync()) {
+		this->file.truncate(committedSize);
+		return false;
+	}
+
+	this->buffer.clear();
+	this->pendingRecords = 0;
+
+	return true;
+}
+
+template<typename Key, typename Value>
+bool WAL<Key, Value>::reset() {
+	this->buffer.clear();
+	this->pendingRecords = 0;
+
+	return this->file.truncate(headerSize) && this->file.sync();
+}
+
+template<typename Key, typename Value>
+unsigned int WAL<Key, Value>::pending() const {
+	return this->pendingRecords;
+}
+
+template<typename Key, typename Value>
+unsigned long long WAL<Key, Value>::replayed() const {
+	return this->replayedRecords;
+}
+
+template<typename Key, typename Value>
+std::uint64_t WAL<Key, Value>::sizeInBytes() const {
+	return this->file.size();
+}
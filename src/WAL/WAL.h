@@ -0,0 +1,124 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include<vector>
+#include<string>
+#include<cstdint>
+#include "../Persistence/AppendFile.h"
+
+/// <summary>
+/// A template class representing a write-ahead log of the inserts and removes made on a structure with the
+/// insert(const Key&, const Value&) and remove(const Key&) interface, such as AVL and SkipList
+/// An update is logged before it is applied, and it is durable once a commit covering it has returned:
+/// the records wait in memory and a commit writes the whole group with one write and one fdatasync,
+/// a commit is also made when groupSize records are waiting
+/// Every record carries a CRC-32C, so a record torn by a crash ends the replay and is cut off the log
+/// Key and Value must be trivially copyable, the log is read back only by a build with the same types and byte order
+/// </summary>
+template<typename Key, typename Value>
+class WAL
+{
+	private:
+		enum RecordType : unsigned char {
+			insertRecord = 1,
+			removeRecord = 2
+		};
+
+		/// <summary>
+		/// A record is the checksum, the type, the key and for an insert the value, the checksum covers the rest of the record
+		/// </summary>
+		static constexpr size_t checksumSize = sizeof(std::uint32_t);
+		static constexpr size_t insertRecordSize = checksumSize + 1 + sizeof(Key) + sizeof(Value);
+		static constexpr size_t removeRecordSize = checksumSize + 1 + sizeof(Key);
+		static constexpr size_t headerSize = 16;
+
+		AppendFile file;
+		std::vector<char> buffer;
+		unsigned int groupSize;
+		unsigned int pendingRecords;
+		unsigned long long replayedRecords;
+
+		/// <summary>
+		/// Appends a record to the group waiting for the next commit
+		/// </summary>
+		/// <param>const RecordType& the type of the record</param>
+		/// <param>const Key& the key</param>
+		/// <param>const Value* the value or nullptr for a remove</param>
+		void append(const RecordType&, const Key&, const Value*);
+
+		/// <summary>
+		/// Applies the valid records of a log to a structure
+		/// </summary>
+		/// <param>const std::string& the path of the log</param>
+		/// <param>Structure& the structure</param>
+		/// <param>std::uint64_t& receives the size of the valid part of the log</param>
+		/// <return>bool whether the log has a valid header for the key and value types</return>
+		template<typename Structure>
+		bool replay(const std::string&, Structure&, std::uint64_t&);
+
+	public:
+		/// <summary>
+		/// Creates a closed log
+		/// </summary>
+		/// <param>const unsigned int& the number of waiting records which starts a commit, default is 1024</param>
+		WAL(const unsigned int& = 1024);
+
+		WAL(const WAL&) = delete;
+		WAL& operator=(const WAL&) = delete;
+
+		/// <summary>
+		/// Commits the waiting records
+		/// </summary>
+		~WAL();
+
+		/// <summary>
+		/// Opens a log, creating it if it does not exist, and replays its records into a structure
+		/// The replay stops at the first torn or corrupted record, which is cut off together with everything after it
+		/// A created log is synced together with its directory, so it survives a crash once open has returned
+		/// </summary>
+		/// <param>const std::string& the path of the log</param>
+		/// <param>Structure& the structure, usually empty or restored from the checkpoint the log was reset after</param>
+		/// <return>bool whether the log was opened, false if it belongs to other key or value types or cannot be written</return>
+		template<typename Structure>
+		bool open(const std::string&, Structure&);
+
+		/// <summary>
+		/// Logs an insert or an update of a value
+		/// </summary>
+		void logInsert(const Key&, const Value&);
+
+		/// <summary>
+		/// Logs a remove
+		/// </summary>
+		void logRemove(const Key&);
+
+		/// <summary>
+		/// Writes the waiting records and waits until they are on the disk
+		/// </summary>
+		/// <return>bool whether the records are durable, if not they keep waiting for the next commit</return>
+		bool commit();
+
+		/// <summary>
+		/// Empties the log after the structure was checkpointed, for example by SkipList::dump or AVL::saveTo
+		/// The waiting records are dropped, the checkpoint covers them
+		/// </summary>
+		/// <return>bool whether the log was emptied</return>
+		bool reset();
+
+		/// <summary>
+		/// Getter for the number of records waiting for a commit
+		/// </summary>
+		unsigned int pending() const;
+
+		/// <summary>
+		/// Getter for the number of records applied by the last open
+		/// </summary>
+		unsigned long long replayed() const;
+
+		/// <summary>
+		/// Getter for the size of the log file, without the waiting records
+		/// </summary>
+		std::uint64_t sizeInBytes() const;
+};
+
+#endif
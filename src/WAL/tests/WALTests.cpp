@@ -0,0 +1,190 @@
+#include "src/Doctest/doctest.h"
+#include "src/WAL/WAL.cpp"
+#include "src/AVL/AVL.cpp"
+#include "src/SkipList/SkipList.cpp"
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <filesystem>
+
+static const char* walPath = "WALTest.log";
+
+template<typename Structure>
+std::vector<std::pair<int, int>> pairsOf(const Structure& structure) {
+	std::vector<std::pair<int, int>> pairs;
+	structure.forEach([&pairs](const int& key, const int& value) {
+		pairs.emplace_back(key, value);
+	});
+
+	return pairs;
+}
+
+TEST_CASE("WAL Replay into AVL and SkipList") {
+	std::remove(walPath);
+	std::map<int, int> expected;
+	{
+		AVL<int, int> tree;
+		WAL<int, int> log{ 64 };
+		REQUIRE(log.open(walPath, tree));
+		CHECK(log.replayed() == 0);
+
+		std::mt19937 generator{ 5 };
+		for (int i = 0; i < 10000; i++) {
+			int key = generator() % 1000;
+			if (i % 3) {
+				log.logInsert(key, i);
+				expected[key] = i;
+			} else {
+				log.logRemove(key);
+				expected.erase(key);
+			}
+		}
+		CHECK(log.commit());
+	}
+
+	AVL<int, int> tree;
+	WAL<int, int> log;
+	REQUIRE(log.open(walPath, tree));
+	CHECK(log.replayed() == 10000);
+	CHECK(pairsOf(tree) == std::vector<std::pair<int, int>>(expected.begin(), expected.end()));
+
+	SkipList<int, int> list{ 1000 };
+	WAL<int, int> listLog;
+	REQUIRE(listLog.open(walPath, list));
+	CHECK(pairsOf(list) == std::vector<std::pair<int, int>>(expected.begin(), expected.end()));
+	std::remove(walPath);
+}
+
+TEST_CASE("WAL Group commit") {
+	std::remove(walPath);
+	AVL<int, int> tree;
+	WAL<int, int> log{ 4 };
+	REQUIRE(log.open(walPath, tree));
+	std::uint64_t empty = log.sizeInBytes();
+
+	log.logInsert(1, 1);
+	log.logInsert(2, 2);
+	log.logRemove(1);
+	CHECK(log.pending() == 3);
+	CHECK(log.sizeInBytes() == empty);
+
+	log.logInsert(3, 3);
+	CHECK(log.pending() == 0);
+	CHECK(log.sizeInBytes() > empty);
+
+	CHECK(log.commit());
+	std::remove(walPath);
+}
+
+TEST_CASE("WAL Destructor commits waiting records") {
+	std::remove(walPath);
+	{
+		AVL<int, int> tree;
+		WAL<int, int> log;
+		REQUIRE(log.open(walPath, tree));
+		log.logInsert(7, 70);
+	}
+
+	AVL<int, int> tree;
+	WAL<int, int> log;
+	REQUIRE(log.open(walPath, tree));
+	CHECK(*tree.getValue(7) == 70);
+	std::remove(walPath);
+}
+
+TEST_CASE("WAL Torn and corrupted records") {
+	std::remove(walPath);
+	std::uint64_t committed;
+	{
+		AVL<int, int> tree;
+		WAL<int, int> log;
+		REQUIRE(log.open(walPath, tree));
+		for (int i = 0; i < 10; i++) {
+			log.logInsert(i, i);
+		}
+		REQUIRE(log.commit());
+		committed = log.sizeInBytes();
+	}
+
+	//a crash in the middle of the next record
+	{
+		std::ofstream out(walPath, std::ios::binary | std::ios::app);
+		out.write("\x12\x34\x56\x78\x01\x0b", 6);
+	}
+
+	{
+		AVL<int, int> tree;
+		WAL<int, int> log;
+		REQUIRE(log.open(walPath, tree));
+		CHECK(log.replayed() == 10);
+		CHECK(log.sizeInBytes() == committed);
+
+		//new records follow the valid ones
+		log.logInsert(10, 10);
+		REQUIRE(log.commit());
+	}
+
+	//a flipped bit in the fourth record ends the replay before it
+	{
+		std::fstream file(walPath, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(16 + 3 * 13 + 6);
+		file.put((char)0x40);
+	}
+
+	AVL<int, int> tree;
+	WAL<int, int> log;
+	REQUIRE(log.open(walPath, tree));
+	CHECK(log.replayed() == 3);
+	CHECK(tree.nodesCount() == 3);
+	CHECK(tree.contains(10) == false);
+	std::remove(walPath);
+}
+
+TEST_CASE("WAL Reset and other types") {
+	std::remove(walPath);
+	{
+		AVL<int, int> tree;
+		WAL<int, int> log;
+		REQUIRE(log.open(walPath, tree));
+		log.logInsert(1, 1);
+		REQUIRE(log.commit());
+		log.logInsert(2, 2);
+		CHECK(log.reset());
+		CHECK(log.pending() == 0);
+	}
+
+	AVL<int, int> tree;
+	WAL<int, int> log;
+	REQUIRE(log.open(walPath, tree));
+	CHECK(log.replayed() == 0);
+
+	AVL<int, long long> other;
+	WAL<int, long long> otherLog;
+	CHECK(otherLog.open(walPath, other) == false);
+	std::remove(walPath);
+}
+
+TEST_CASE("WAL Log created inside a directory") {
+	//the directory of a created log is synced, a missing one fails the open
+	std::error_code error;
+	std::filesystem::remove_all("WALTestDirectory", error);
+	AVL<int, int> tree;
+	WAL<int, int> missing;
+	CHECK(missing.open("WALTestDirectory/missing/wal.log", tree) == false);
+
+	std::filesystem::create_directories("WALTestDirectory", error);
+	{
+		WAL<int, int> log;
+		REQUIRE(log.open("WALTestDirectory/wal.log", tree));
+		log.logInsert(7, 70);
+		CHECK(log.commit());
+	}
+
+	AVL<int, int> replayed;
+	WAL<int, int> log;
+	REQUIRE(log.open("WALTestDirectory/wal.log", replayed));
+	CHECK(replayed.getValue(7) != nullptr);
+	std::filesystem::remove_all("WALTestDirectory", error);
+}